@@ -988,13 +988,13 @@ namespace GRAPE {
                                     IO::CSV::exportDoc29PerformanceProfilesDepartureSteps(path);
                                     }, std::format("Exporting Doc29 departure procedural profiles to '{}'", path)); break;
                                 case CsvDataset::Doc29Noise: queueAsyncTask([&, path] {
-                                    IO::CSV::exportDoc29Noise(path);
+                                    IO::CSV::exportDoc29Noise(study(), path);
                                     }, std::format("Exporting Doc29 noise entries to '{}'", path)); break;
                                 case CsvDataset::Doc29NoiseNpd: queueAsyncTask([&, path] {
                                     IO::CSV::exportDoc29NoiseNpd(path);
                                     }, std::format("Exporting Doc29 NPD data to '{}'", path)); break;
                                 case CsvDataset::Doc29NoiseSpectrum: queueAsyncTask([&, path] {
-                                    IO::CSV::exportDoc29NoiseSpectrum(path);
+                                    IO::CSV::exportDoc29NoiseSpectrum(study(), path);
                                     }, std::format("Exporting Doc29 noise spectrum to '{}'", path)); break;
                                 case CsvDataset::LTO: queueAsyncTask([&, path] {
                                     IO::CSV::exportLTO(path);
@@ -1003,7 +1003,7 @@ namespace GRAPE {
                                     IO::CSV::exportSFI(path);
                                     }, std::format("Exporting SFI database from '{}'", path)); break;
                                 case CsvDataset::Fleet: queueAsyncTask([&, path] {
-                                    IO::CSV::exportFleet(path);
+                                    IO::CSV::exportFleet(study(), path);
                                     }, std::format("Exporting Fleet from '{}'", path)); break;
                                 default:  GRAPE_ASSERT(false); break;
                                 }
@@ -1035,28 +1035,28 @@ namespace GRAPE {
                                     IO::CSV::exportRunways(path);
                                     }, std::format("Exporting runways to '{}'", path)); break;
                                 case CsvInputData::RoutesSimple: queueAsyncTask([&, path] {
-                                    IO::CSV::exportRoutesSimple(path);
+                                    IO::CSV::exportRoutesSimple(study(), path);
                                     }, std::format("Exporting simple route points to '{}'", path)); break;
                                 case CsvInputData::RoutesVectors: queueAsyncTask([&, path] {
                                     IO::CSV::exportRoutesVectors(path);
                                     }, std::format("Exporting vector route vectors to '{}'", path)); break;
                                 case CsvInputData::RoutesRnp: queueAsyncTask([&, path] {
-                                    IO::CSV::exportRoutesRnp(path);
+                                    IO::CSV::exportRoutesRnp(study(), path);
                                     }, std::format("Exporting RNP route steps to '{}'", path)); break;
                                 case CsvInputData::Flights: queueAsyncTask([&, path] {
                                     IO::CSV::exportFlights(path);
                                     }, std::format("Exporting flights to '{}'", path)); break;
                                 case CsvInputData::Tracks4d: queueAsyncTask([&, path] {
-                                    IO::CSV::exportTracks4d(path);
+                                    IO::CSV::exportTracks4d(study(), path);
                                     }, std::format("Exporting tracks 4D to '{}'", path)); break;
                                 case CsvInputData::Tracks4dPoints: queueAsyncTask([&, path] {
                                     IO::CSV::exportTracks4dPoints(path);
                                     }, std::format("Exporting tracks 4D points to '{}'", path)); break;
                                 case CsvInputData::Scenarios: queueAsyncTask([&, path] {
-                                    IO::CSV::exportScenarios(path);
+                                    IO::CSV::exportScenarios(study(), path);
                                     }, std::format("Exporting scenarios to '{}'", path)); break;
                                 case CsvInputData::ScenariosOperations: queueAsyncTask([&, path] {
-                                    IO::CSV::exportScenariosOperations(path);
+                                    IO::CSV::exportScenariosOperations(study(), path);
                                     }, std::format("Exporting scenarios operations to '{}'", path)); break;
                                 case CsvInputData::PerformanceRuns: queueAsyncTask([&, path] {
                                     IO::CSV::exportPerformanceRuns(path);
@@ -1065,7 +1065,7 @@ namespace GRAPE {
                                     IO::CSV::exportPerformanceRunsAtmospheres(path);
                                     }, std::format("Exporting performance runs atmospheres to '{}'", path)); break;
                                 case CsvInputData::NoiseRuns: queueAsyncTask([&, path] {
-                                    IO::CSV::exportNoiseRuns(path);
+                                    IO::CSV::exportNoiseRuns(study(), path);
                                     }, std::format("Exporting noise runs to '{}'", path)); break;
                                 case CsvInputData::ReceptorsGrid: queueAsyncTask([&, path] {
                                     IO::CSV::exportNoiseRunsReceptorsGrids(path);
@@ -1074,10 +1074,10 @@ namespace GRAPE {
                                     IO::CSV::exportNoiseRunsReceptorsPoints(path);
                                     }, std::format("Exporting point receptors to '{}'", path)); break;
                                 case CsvInputData::NoiseRunsCumulativeMetrics: queueAsyncTask([&, path] {
-                                    IO::CSV::exportNoiseRunsCumulativeMetrics(path);
+                                    IO::CSV::exportNoiseRunsCumulativeMetrics(study(), path);
                                     }, std::format("Exporting cumulative metrics to '{}'", path)); break;
                                 case CsvInputData::NoiseRunsCumulativeMetricsWeights: queueAsyncTask([&, path] {
-                                    IO::CSV::exportNoiseRunsCumulativeMetricsWeights(path);
+                                    IO::CSV::exportNoiseRunsCumulativeMetricsWeights(study(), path);
                                     }, std::format("Exporting cumulative metrics weights to '{}'", path)); break;
                                 case CsvInputData::EmissionsRuns: queueAsyncTask([&, path] {
                                     IO::CSV::exportEmissionsRuns(path);
@@ -1519,7 +1519,7 @@ namespace GRAPE {
                 if (!nsRunJob->ready())
                     throw GrapeException(std::format("Noise run '{}' of performance run '{}' of scenario '{}' has already been run.", nsRunName, perfRunName, scenName));
 
-                m_Study->Jobs.queueJob(nsRunJob);
+                m_Study->Jobs.queueJob(nsRunJob, { perfRun.job() });
             }
             catch (const std::exception& err)
             {
@@ -1569,7 +1569,7 @@ namespace GRAPE {
                 if (!emiRunJob->ready())
                     throw GrapeException(std::format("Emissions run '{}' of performance run '{}' of scenario '{}' has already been run.", emiRunName, perfRunName, scenName));
 
-                m_Study->Jobs.queueJob(emiRunJob);
+                m_Study->Jobs.queueJob(emiRunJob, { perfRun.job() });
             }
             catch (const std::exception& err)
             {
@@ -9,7 +9,7 @@
 #include "Aircraft/Doc29/Doc29Aircraft.h"
 #include "Aircraft/Doc29/Doc29Noise.h"
 
-#include "Csv.h"
+#include "IO/Csv.h"
 
 namespace GRAPE::IO {
     AnpImport::AnpImport(const std::string& Folder, bool StopOnError) : m_FolderPath(Folder), m_StopOnError(StopOnError) {
@@ -662,6 +662,7 @@ namespace GRAPE::IO {
                 if (!study.Doc29Aircrafts().contains(doc29AcftName))
                     throw GrapeException(std::format("Doc29 Aircraft '{}' not found in the study.", doc29AcftName));
                 auto& doc29Acft = study.Doc29Aircrafts(doc29AcftName);
+                study.Doc29Aircrafts.loadProfiles(doc29Acft); // Rows may add to existing profiles
 
                 if (std::ranges::find(m_PistonAircraft, doc29AcftName) != m_PistonAircraft.end())
                     throw GrapeException(std::format("ANP aircraft '{}' is of piston type. Fixed point profiles not suported", doc29AcftName));
@@ -783,6 +784,7 @@ namespace GRAPE::IO {
                 if (!study.Doc29Aircrafts().contains(doc29AcftName))
                     throw GrapeException(std::format("Doc29 Aircraft '{}' not found in the study.", doc29AcftName));
                 auto& doc29Acft = study.Doc29Aircrafts(doc29AcftName);
+                study.Doc29Aircrafts.loadProfiles(doc29Acft);
 
                 // Profile
                 auto profileId = csv.getCell<std::string>(row, 1);
@@ -1010,6 +1012,7 @@ namespace GRAPE::IO {
                 if (!study.Doc29Aircrafts().contains(doc29AcftName))
                     throw GrapeException(std::format("Doc29 Aircraft '{}' not found in the study.", doc29AcftName));
                 auto& doc29Acft = study.Doc29Aircrafts(doc29AcftName);
+                study.Doc29Aircrafts.loadProfiles(doc29Acft);
 
                 // Profile
                 const auto profileId = csv.getCell<std::string>(row, 1);
@@ -1234,7 +1237,8 @@ namespace GRAPE::IO {
 
     namespace {
         void addNpdData(Doc29Noise& Doc29Ns, OperationType OpType, NoiseSingleMetric NoiseMetric, double Thrust, const NpdData::PowerNoiseLevelsArray& NoiseLevels) {
-            const auto& study = Application::study();
+            auto& study = Application::study();
+            study.Doc29Noises.loadNpd(Doc29Ns);
 
             switch (OpType)
             {
@@ -5,7 +5,7 @@
 #include "CsvExport.h"
 
 #include "Application.h"
-#include "Csv.h"
+#include "IO/Csv.h"
 #include "Performance/PerformanceOutput.h"
 
 namespace GRAPE::IO::CSV {
@@ -226,7 +226,7 @@ namespace GRAPE::IO::CSV {
     }
 
     void exportDoc29PerformanceProfilesPoints(const std::string& CsvPath) {
-        const auto& study = Application::study();
+        auto& study = Application::study();
         const auto& set = Application::settings();
 
         Csv csv;
@@ -251,6 +251,7 @@ namespace GRAPE::IO::CSV {
 
         for (const auto& doc29Acft : study.Doc29Aircrafts)
         {
+            study.Doc29Aircrafts.loadProfiles(doc29Acft);
             for (const auto& [profName, arrProfPtr] : doc29Acft.ArrivalProfiles)
             {
                 const auto& arrProf = *arrProfPtr;
@@ -311,7 +312,7 @@ namespace GRAPE::IO::CSV {
     }
 
     void exportDoc29PerformanceProfilesArrivalSteps(const std::string& CsvPath) {
-        const auto& study = Application::study();
+        auto& study = Application::study();
         const auto& set = Application::settings();
 
         Csv csv;
@@ -342,6 +343,7 @@ namespace GRAPE::IO::CSV {
         std::size_t row = 0;
         for (const auto& doc29Acft : study.Doc29Aircrafts)
         {
+            study.Doc29Aircrafts.loadProfiles(doc29Acft);
             for (const auto& [profName, arrProfPtr] : doc29Acft.ArrivalProfiles)
             {
                 const auto& arrProf = *arrProfPtr;
@@ -413,7 +415,7 @@ namespace GRAPE::IO::CSV {
     }
 
     void exportDoc29PerformanceProfilesDepartureSteps(const std::string& CsvPath) {
-        const auto& study = Application::study();
+        auto& study = Application::study();
         const auto& set = Application::settings();
 
         Csv csv;
@@ -440,6 +442,7 @@ namespace GRAPE::IO::CSV {
         std::size_t row = 0;
         for (const auto& doc29Acft : study.Doc29Aircrafts)
         {
+            study.Doc29Aircrafts.loadProfiles(doc29Acft);
             for (const auto& [profName, depProfPtr] : doc29Acft.DepartureProfiles)
             {
                 const auto& depProf = *depProfPtr;
@@ -495,41 +498,8 @@ namespace GRAPE::IO::CSV {
         }
     }
 
-    void exportDoc29Noise(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting Doc29 Noise to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "ID",
-            "Lateral Directivity",
-            "Start of Roll Correction"
-        );
-
-        std::size_t row = 0;
-        for (const auto& doc29Ns : study.Doc29Noises)
-        {
-            csv.setCell(row, 0, doc29Ns.Name);
-            csv.setCell(row, 1, Doc29Noise::LateralDirectivities.toString(doc29Ns.LateralDir));
-            csv.setCell(row, 2, Doc29Noise::SORCorrections.toString(doc29Ns.SOR));
-            ++row;
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported Doc29 Noise to '{}'.", CsvPath);
-        }
-    }
-
     void exportDoc29NoiseNpd(const std::string& CsvPath) {
-        const auto& study = Application::study();
+        auto& study = Application::study();
         const auto& set = Application::settings();
 
         Csv csv;
@@ -572,6 +542,7 @@ namespace GRAPE::IO::CSV {
             };
         for (const auto& doc29Ns : study.Doc29Noises)
         {
+            study.Doc29Noises.loadNpd(doc29Ns);
             addNpdData(doc29Ns.Name, OperationType::Arrival, NoiseSingleMetric::Lamax, doc29Ns.ArrivalLamax);
             addNpdData(doc29Ns.Name, OperationType::Arrival, NoiseSingleMetric::Sel, doc29Ns.ArrivalSel);
             addNpdData(doc29Ns.Name, OperationType::Departure, NoiseSingleMetric::Lamax, doc29Ns.DepartureLamax);
@@ -585,52 +556,6 @@ namespace GRAPE::IO::CSV {
         }
     }
 
-    void exportDoc29NoiseSpectrum(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting Doc29 Noise spectrum to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "Doc29 Noise ID",
-            "Operation"
-        );
-        {
-            std::size_t col = 1;
-            for (const auto& freq : OneThirdOctaveCenterFrequencies)
-                csv.setColumnName(++col, std::format("Level {:.0} ft", freq));
-        }
-
-        std::size_t row = 0;
-        const auto addSpectrum = [&](OperationType OpType, const Doc29Spectrum& Doc29Spec) {
-            csv.setCell(row, 0, Doc29Spec.parentDoc29Noise().Name);
-            csv.setCell(row, 1, OperationTypes.toString(OpType));
-
-            std::size_t col = 1;
-            for (const auto& lvl : Doc29Spec)
-                csv.setCell(row, ++col, lvl);
-            ++row;
-
-            };
-
-        for (const auto& doc29Ns : study.Doc29Noises)
-        {
-            addSpectrum(OperationType::Arrival, doc29Ns.ArrivalSpectrum);
-            addSpectrum(OperationType::Departure, doc29Ns.DepartureSpectrum);
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported Doc29 Noise spectrum to '{}'.", CsvPath);
-        }
-    }
-
     void exportLTO(const std::string& CsvPath) {
         const auto& study = Application::study();
         const auto& set = Application::settings();
@@ -798,54 +723,6 @@ namespace GRAPE::IO::CSV {
         }
     }
 
-    void exportFleet(const std::string& CsvPath) {
-        const auto& study = Application::study();
-        const auto& set = Application::settings();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting fleet to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "ID",
-            "Number of Engines",
-            "Doc29 Aircraft ID",
-            "SFI ID",
-            "LTO ID",
-            "Doc29 Noise ID",
-            "Doc29 Noise Delta Arrival",
-            "Doc29 Noise Delta Departure"
-        );
-
-        std::size_t row = 0;
-        for (const auto& acft : study.Aircrafts)
-        {
-            csv.setCell(row, 0, acft.Name);
-            csv.setCell(row, 1, acft.EngineCount);
-            if (acft.validDoc29Performance())
-                csv.setCell(row, 2, acft.Doc29Acft->Name);
-            if (acft.validSFI())
-                csv.setCell(row, 3, acft.SFIFuel->Name);
-            if (acft.validLTOEngine())
-                csv.setCell(row, 4, acft.LTOEng->Name);
-            if (acft.validDoc29Noise())
-                csv.setCell(row, 5, acft.Doc29Ns->Name);
-            csv.setCell(row, 6, acft.Doc29NoiseDeltaArrivals);
-            csv.setCell(row, 7, acft.Doc29NoiseDeltaDepartures);
-            ++row;
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported fleet to '{}'.", CsvPath);
-        }
-    }
-
     void exportAirports(const std::string& CsvPath) {
         const auto& study = Application::study();
         const auto& set = Application::settings();
@@ -946,52 +823,6 @@ namespace GRAPE::IO::CSV {
         };
     }
 
-    void exportRoutesSimple(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting simple routes to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "Airport ID",
-            "Runway ID",
-            "Operation",
-            "Route ID",
-            "Longitude",
-            "Latitude"
-        );
-
-        std::size_t row = 0;
-        for (const auto& apt : study.Airports)
-        {
-            for (const auto& rwy : apt.Runways | std::views::values)
-            {
-                for (const auto& rte : rwy.ArrivalRoutes | std::views::values)
-                {
-                    if (rte->type() == Route::Type::Simple)
-                        RouteExporter(csv, row, *rte);
-                }
-
-                for (const auto& rte : rwy.DepartureRoutes | std::views::values)
-                {
-                    if (rte->type() == Route::Type::Simple)
-                        RouteExporter(csv, row, *rte);
-                }
-            }
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported simple routes to '{}'.", CsvPath);
-        }
-    }
-
     void RouteExporter::visitSimple(const RouteTypeSimple& Rte) {
         Csv& csv = m_Csv;
         std::size_t& row = m_Row;
@@ -1084,55 +915,6 @@ namespace GRAPE::IO::CSV {
         }
     }
 
-    void exportRoutesRnp(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting RNP routes to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "Airport ID",
-            "Runway ID",
-            "Operation",
-            "Route ID",
-            "RNP Step Type",
-            "Longitude",
-            "Latitude",
-            "Center Longitude",
-            "Center Latitude"
-        );
-
-        std::size_t row = 0;
-        for (const auto& apt : study.Airports)
-        {
-            for (const auto& rwy : apt.Runways | std::views::values)
-            {
-                for (const auto& rte : rwy.ArrivalRoutes | std::views::values)
-                {
-                    if (rte->type() == Route::Type::Rnp)
-                        RouteExporter(csv, row, *rte);
-                }
-
-                for (const auto& rte : rwy.DepartureRoutes | std::views::values)
-                {
-                    if (rte->type() == Route::Type::Rnp)
-                        RouteExporter(csv, row, *rte);
-                }
-            }
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported RNP routes to '{}'.", CsvPath);
-        }
-    }
-
     void RouteExporter::visitRnp(const RouteTypeRnp& Rte) {
         Csv& csv = m_Csv;
         std::size_t& row = m_Row;
@@ -1237,54 +1019,6 @@ namespace GRAPE::IO::CSV {
         }
     }
 
-    void exportTracks4d(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting tracks 4D to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "ID",
-            "Operation",
-            "Time",
-            "Count",
-            "Fleet ID"
-        );
-
-        std::size_t row = 0;
-
-        for (const auto& arrTrack4d : study.Operations.track4dArrivals() | std::views::values)
-        {
-            csv.setCell(row, 0, arrTrack4d.Name);
-            csv.setCell(row, 1, OperationTypes.toString(arrTrack4d.operationType()));
-            csv.setCell(row, 2, timeToUtcString(arrTrack4d.Time));
-            csv.setCell(row, 3, arrTrack4d.Count);
-            csv.setCell(row, 4, arrTrack4d.aircraft().Name);
-            ++row;
-        }
-
-        for (const auto& depTrack4d : study.Operations.track4dDepartures() | std::views::values)
-        {
-            csv.setCell(row, 0, depTrack4d.Name);
-            csv.setCell(row, 1, OperationTypes.toString(depTrack4d.operationType()));
-            csv.setCell(row, 2, timeToUtcString(depTrack4d.Time));
-            csv.setCell(row, 3, depTrack4d.Count);
-            csv.setCell(row, 4, depTrack4d.aircraft().Name);
-            ++row;
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported 4D tracks to '{}'.", CsvPath);
-        }
-    }
-
     void exportTracks4dPoints(const std::string& CsvPath) {
         auto& study = Application::study();
         const auto& set = Application::settings();
@@ -1362,131 +1096,6 @@ namespace GRAPE::IO::CSV {
         }
     }
 
-    void exportScenarios(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting scenarios to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "ID",
-            "# Operations",
-            "# Arrivals",
-            "# Departures",
-            "# Flights",
-            "# Tracks 4D",
-            "# Arrival Flights",
-            "# Departure Flights",
-            "# Arrival Tracks 4D",
-            "# Departure Tracks 4D",
-            "Start Time",
-            "End Time"
-        );
-
-        std::size_t row = 0;
-        for (const auto& scen : study.Scenarios)
-        {
-            csv.setCell(row, 0, scen.Name);
-            csv.setCell(row, 1, static_cast<int>(scen.size()));
-            csv.setCell(row, 2, static_cast<int>(scen.arrivalsSize()));
-            csv.setCell(row, 3, static_cast<int>(scen.departuresSize()));
-            csv.setCell(row, 4, static_cast<int>(scen.flightsSize()));
-            csv.setCell(row, 5, static_cast<int>(scen.tracks4dSize()));
-            csv.setCell(row, 6, static_cast<int>(scen.FlightArrivals.size()));
-            csv.setCell(row, 7, static_cast<int>(scen.FlightDepartures.size()));
-            csv.setCell(row, 8, static_cast<int>(scen.Track4dArrivals.size()));
-            csv.setCell(row, 9, static_cast<int>(scen.Track4dDepartures.size()));
-            const auto [startTime, endTime] = scen.timeSpan();
-            if (startTime != std::chrono::tai_seconds::max())
-                csv.setCell(row, 10, timeToUtcString(startTime));
-            if (endTime != std::chrono::tai_seconds::min())
-                csv.setCell(row, 11, timeToUtcString(endTime));
-
-            ++row;
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported scenarios to '{}'.", CsvPath);
-        }
-    }
-
-    void exportScenariosOperations(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting scenarios operations to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "Scenario ID",
-            "ID",
-            "Operation",
-            "Type"
-        );
-
-        std::size_t row = 0;
-
-        for (const auto& scen : study.Scenarios)
-        {
-            for (const auto& opRef : scen.FlightArrivals)
-            {
-                const auto& op = opRef.get();
-                csv.setCell(row, 0, scen.Name);
-                csv.setCell(row, 1, op.Name);
-                csv.setCell(row, 2, OperationTypes.toString(op.operationType()));
-                csv.setCell(row, 3, Operation::Types.toString(op.type()));
-                ++row;
-            }
-
-            for (const auto& opRef : scen.FlightDepartures)
-            {
-                const auto& op = opRef.get();
-                csv.setCell(row, 0, scen.Name);
-                csv.setCell(row, 1, op.Name);
-                csv.setCell(row, 2, OperationTypes.toString(op.operationType()));
-                csv.setCell(row, 3, Operation::Types.toString(op.type()));
-                ++row;
-            }
-
-            for (const auto& opRef : scen.Track4dArrivals)
-            {
-                const auto& op = opRef.get();
-                csv.setCell(row, 0, scen.Name);
-                csv.setCell(row, 1, op.Name);
-                csv.setCell(row, 2, OperationTypes.toString(op.operationType()));
-                csv.setCell(row, 3, Operation::Types.toString(op.type()));
-                ++row;
-            }
-
-            for (const auto& opRef : scen.Track4dDepartures)
-            {
-                const auto& op = opRef.get();
-                csv.setCell(row, 0, scen.Name);
-                csv.setCell(row, 1, op.Name);
-                csv.setCell(row, 2, OperationTypes.toString(op.operationType()));
-                csv.setCell(row, 3, Operation::Types.toString(op.type()));
-                ++row;
-            }
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported scenarios operations to '{}'.", CsvPath);
-        }
-    }
-
     void exportPerformanceRuns(const std::string& CsvPath) {
         const auto& study = Application::study();
         const auto& set = Application::settings();
@@ -1634,55 +1243,6 @@ namespace GRAPE::IO::CSV {
         }
     }
 
-    void exportNoiseRuns(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting noise runs to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "Scenario ID",
-            "Performance Run ID",
-            "ID",
-            "Noise Model",
-            "Atmospheric Absorption",
-            "Receptor Set Type",
-            "Save Single Event Metrics"
-        );
-
-        std::size_t row = 0;
-        for (const auto& scen : study.Scenarios)
-        {
-            for (const auto& perfRun : scen.PerformanceRuns | std::views::values)
-            {
-                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
-                {
-                    const auto& spec = nsRun.NsRunSpec;
-                    csv.setCell(row, 0, scen.Name);
-                    csv.setCell(row, 1, perfRun.Name);
-                    csv.setCell(row, 2, nsRun.Name);
-                    csv.setCell(row, 3, NoiseModelTypes.toString(spec.NoiseMdl));
-                    csv.setCell(row, 4, AtmosphericAbsorption::Types.toString(spec.AtmAbsorptionType));
-                    csv.setCell(row, 5, ReceptorSet::Types.toString(spec.ReceptSet->type()));
-                    csv.setCell(row, 6, static_cast<int>(spec.SaveSingleMetrics));
-
-                    ++row;
-                }
-            }
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported noise runs to '{}'.", CsvPath);
-        }
-    }
-
     void exportNoiseRunsReceptorsPoints(const std::string& CsvPath) {
         const auto& study = Application::study();
         const auto& set = Application::settings();
@@ -1802,120 +1362,6 @@ namespace GRAPE::IO::CSV {
         }
     }
 
-    void exportNoiseRunsCumulativeMetrics(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting noise runs cumulative metrics to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "Scenario ID",
-            "Performance Run ID",
-            "Noise Run ID",
-            "ID",
-            "Threshold (dB)",
-            "Averaging Time Constant (dB)",
-            "Start Time",
-            "End Time",
-            "Number Above Thresholds (dB)"
-        );
-
-        std::size_t row = 0;
-        for (const auto& scen : study.Scenarios)
-        {
-            for (const auto& perfRun : scen.PerformanceRuns | std::views::values)
-            {
-                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
-                {
-                    for (const auto& cumMetric : nsRun.CumulativeMetrics | std::views::values)
-                    {
-                        csv.setCell(row, 0, scen.Name);
-                        csv.setCell(row, 1, perfRun.Name);
-                        csv.setCell(row, 2, nsRun.Name);
-                        csv.setCell(row, 3, cumMetric.Name);
-                        csv.setCell(row, 4, cumMetric.Threshold);
-                        csv.setCell(row, 5, cumMetric.AveragingTimeConstant);
-                        csv.setCell(row, 6, timeToUtcString(cumMetric.StartTimePoint));
-                        csv.setCell(row, 7, timeToUtcString(cumMetric.EndTimePoint));
-
-                        if (!cumMetric.numberAboveThresholds().empty())
-                        {
-                            std::stringstream naThrSs;
-                            for (const auto& naThr : cumMetric.numberAboveThresholds())
-                                naThrSs << naThr << " ";
-                            std::string naThrStr = naThrSs.str();
-                            naThrStr.pop_back();
-                            csv.setCell(row, 8, naThrStr);
-                        }
-                        ++row;
-                    }
-                }
-            }
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported noise runs cumulative metrics to '{}'.", CsvPath);
-        }
-    }
-
-    void exportNoiseRunsCumulativeMetricsWeights(const std::string& CsvPath) {
-        const auto& study = Application::study();
-
-        Csv csv;
-        try { csv.setExport(CsvPath); }
-        catch (const std::exception& err)
-        {
-            Log::io()->error("Exporting noise runs cumulative metrics weights to '{}'. {}", CsvPath, err.what());
-            return;
-        }
-
-        csv.setColumnNames(
-            "Scenario ID",
-            "Performance Run ID",
-            "Noise Run ID",
-            "Noise Run Cumulative Metric ID",
-            "Time of Day",
-            "Weight"
-        );
-
-        std::size_t row = 0;
-        for (const auto& scen : study.Scenarios)
-        {
-            for (const auto& perfRun : scen.PerformanceRuns | std::views::values)
-            {
-                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
-                {
-                    for (const auto& cumMetric : nsRun.CumulativeMetrics | std::views::values)
-                    {
-                        for (const auto& [time, weight] : cumMetric.weights())
-                        {
-                            csv.setCell(row, 0, scen.Name);
-                            csv.setCell(row, 1, perfRun.Name);
-                            csv.setCell(row, 2, nsRun.Name);
-                            csv.setCell(row, 3, cumMetric.Name);
-                            csv.setCell(row, 4, durationToString(time));
-                            csv.setCell(row, 5, weight);
-                            ++row;
-                        }
-                    }
-                }
-            }
-        }
-
-        if (row)
-        {
-            csv.write();
-            Log::io()->info("Exported noise runs cumulative metrics weights to '{}'.", CsvPath);
-        }
-    }
-
     void exportEmissionsRuns(const std::string& CsvPath) {
         const auto& study = Application::study();
         const auto& set = Application::settings();
@@ -2013,11 +1459,11 @@ namespace GRAPE::IO::CSV {
 
         Application::get().queueAsyncTask([=] { exportDoc29PerformanceProfilesDepartureSteps(std::format("{}/Doc29 Profiles Procedural Departure.csv", FolderPath)); }, "Exporting Doc29 departure procedural profiles");
 
-        Application::get().queueAsyncTask([=] { exportDoc29Noise(std::format("{}/Doc29 Noise.csv", FolderPath)); }, "Exporting Doc29 Noise");
+        Application::get().queueAsyncTask([=] { exportDoc29Noise(Application::study(), std::format("{}/Doc29 Noise.csv", FolderPath)); }, "Exporting Doc29 Noise");
 
         Application::get().queueAsyncTask([=] { exportDoc29NoiseNpd(std::format("{}/Doc29 Noise NPD.csv", FolderPath)); }, "Exporting Doc29 NPD data");
 
-        Application::get().queueAsyncTask([=] { exportDoc29NoiseSpectrum(std::format("{}/Doc29 Noise Spectrum.csv", FolderPath)); }, "Exporting Doc29 Noise spectrum");
+        Application::get().queueAsyncTask([=] { exportDoc29NoiseSpectrum(Application::study(), std::format("{}/Doc29 Noise Spectrum.csv", FolderPath)); }, "Exporting Doc29 Noise spectrum");
     }
 
     void exportDatasetFiles(const std::string& FolderPath) {
@@ -2027,7 +1473,7 @@ namespace GRAPE::IO::CSV {
 
         Application::get().queueAsyncTask([=] { exportSFI(std::format("{}/SFI.csv", FolderPath)); }, "Exporting SFI coefficients");
 
-        Application::get().queueAsyncTask([=] { exportFleet(std::format("{}/Fleet.csv", FolderPath)); }, "Exporting fleet");
+        Application::get().queueAsyncTask([=] { exportFleet(Application::study(), std::format("{}/Fleet.csv", FolderPath)); }, "Exporting fleet");
     }
 
     void exportInputDataFiles(const std::string& FolderPath) {
@@ -2035,35 +1481,35 @@ namespace GRAPE::IO::CSV {
 
         Application::get().queueAsyncTask([=] { exportRunways(std::format("{}/Runways.csv", FolderPath)); }, "Exporting runways");
 
-        Application::get().queueAsyncTask([=] { exportRoutesSimple(std::format("{}/Routes Simple.csv", FolderPath)); }, "Exporting simple routes");
+        Application::get().queueAsyncTask([=] { exportRoutesSimple(Application::study(), std::format("{}/Routes Simple.csv", FolderPath)); }, "Exporting simple routes");
 
         Application::get().queueAsyncTask([=] { exportRoutesVectors(std::format("{}/Routes Vector.csv", FolderPath)); }, "Exporting vector routes");
 
-        Application::get().queueAsyncTask([=] { exportRoutesRnp(std::format("{}/Routes RNP.csv", FolderPath)); }, "Exporting RNP routes");
+        Application::get().queueAsyncTask([=] { exportRoutesRnp(Application::study(), std::format("{}/Routes RNP.csv", FolderPath)); }, "Exporting RNP routes");
 
         Application::get().queueAsyncTask([=] { exportFlights(std::format("{}/Flights.csv", FolderPath)); }, "Exporting flights");
 
-        Application::get().queueAsyncTask([=] { exportTracks4d(std::format("{}/Tracks 4D.csv", FolderPath)); }, "Exporting 4D tracks");
+        Application::get().queueAsyncTask([=] { exportTracks4d(Application::study(), std::format("{}/Tracks 4D.csv", FolderPath)); }, "Exporting 4D tracks");
 
         Application::get().queueAsyncTask([=] { exportTracks4dPoints(std::format("{}/Tracks 4D Points.csv", FolderPath)); }, "Exporting tracks 4D points");
 
-        Application::get().queueAsyncTask([=] { exportScenarios(std::format("{}/Scenarios.csv", FolderPath)); }, "Exporting scenarios");
+        Application::get().queueAsyncTask([=] { exportScenarios(Application::study(), std::format("{}/Scenarios.csv", FolderPath)); }, "Exporting scenarios");
 
-        Application::get().queueAsyncTask([=] { exportScenariosOperations(std::format("{}/Scenarios Operations.csv", FolderPath)); }, "Exporting scenarios operations");
+        Application::get().queueAsyncTask([=] { exportScenariosOperations(Application::study(), std::format("{}/Scenarios Operations.csv", FolderPath)); }, "Exporting scenarios operations");
 
         Application::get().queueAsyncTask([=] { exportPerformanceRuns(std::format("{}/Performance Runs.csv", FolderPath)); }, "Exporting performance runs");
 
         Application::get().queueAsyncTask([=] { exportPerformanceRunsAtmospheres(std::format("{}/Performance Runs Atmospheres.csv", FolderPath)); }, "Exporting performance runs");
 
-        Application::get().queueAsyncTask([=] { exportNoiseRuns(std::format("{}/Noise Runs.csv", FolderPath)); }, "Exporting noise runs");
+        Application::get().queueAsyncTask([=] { exportNoiseRuns(Application::study(), std::format("{}/Noise Runs.csv", FolderPath)); }, "Exporting noise runs");
 
         Application::get().queueAsyncTask([=] { exportNoiseRunsReceptorsGrids(std::format("{}/Noise Runs Grid Receptors.csv", FolderPath)); }, "Exporting noise runs grid receptors");
 
         Application::get().queueAsyncTask([=] { exportNoiseRunsReceptorsPoints(std::format("{}/Noise Runs Point Receptors.csv", FolderPath)); }, "Exporting noise runs point receptors");
 
-        Application::get().queueAsyncTask([=] { exportNoiseRunsCumulativeMetrics(std::format("{}/Noise Runs Cumulative Metrics.csv", FolderPath)); }, "Exporting noise runs cumulative metrics");
+        Application::get().queueAsyncTask([=] { exportNoiseRunsCumulativeMetrics(Application::study(), std::format("{}/Noise Runs Cumulative Metrics.csv", FolderPath)); }, "Exporting noise runs cumulative metrics");
 
-        Application::get().queueAsyncTask([=] { exportNoiseRunsCumulativeMetricsWeights(std::format("{}/Noise Runs Cumulative Metrics Weights.csv", FolderPath)); }, "Exporting noise runs cumulative metrics weights");
+        Application::get().queueAsyncTask([=] { exportNoiseRunsCumulativeMetricsWeights(Application::study(), std::format("{}/Noise Runs Cumulative Metrics Weights.csv", FolderPath)); }, "Exporting noise runs cumulative metrics weights");
 
         Application::get().queueAsyncTask([=] { exportEmissionsRuns(std::format("{}/Emissions Runs.csv", FolderPath)); }, "Exporting emissions runs");
     }
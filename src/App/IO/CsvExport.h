@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "IO/StudyCsvExport.h"
+
 namespace GRAPE {
     class PerformanceOutput;
     class PerformanceRunOutput;
@@ -23,37 +25,24 @@ namespace GRAPE {
         void exportDoc29PerformanceProfilesArrivalSteps(const std::string& CsvPath);
         void exportDoc29PerformanceProfilesDepartureSteps(const std::string& CsvPath);
 
-        void exportDoc29Noise(const std::string& CsvPath);
         void exportDoc29NoiseNpd(const std::string& CsvPath);
-        void exportDoc29NoiseSpectrum(const std::string& CsvPath);
 
         void exportLTO(const std::string& CsvPath);
 
         void exportSFI(const std::string& CsvPath);
 
-        void exportFleet(const std::string& CsvPath);
-
         void exportAirports(const std::string& CsvPath);
         void exportRunways(const std::string& CsvPath);
-        void exportRoutesSimple(const std::string& CsvPath);
         void exportRoutesVectors(const std::string& CsvPath);
-        void exportRoutesRnp(const std::string& CsvPath);
 
         void exportFlights(const std::string& CsvPath);
-        void exportTracks4d(const std::string& CsvPath);
         void exportTracks4dPoints(const std::string& CsvPath);
 
-        void exportScenarios(const std::string& CsvPath);
-        void exportScenariosOperations(const std::string& CsvPath);
-
         void exportPerformanceRuns(const std::string& CsvPath);
         void exportPerformanceRunsAtmospheres(const std::string& CsvPath);
 
-        void exportNoiseRuns(const std::string& CsvPath);
         void exportNoiseRunsReceptorsPoints(const std::string& CsvPath);
         void exportNoiseRunsReceptorsGrids(const std::string& CsvPath);
-        void exportNoiseRunsCumulativeMetrics(const std::string& CsvPath);
-        void exportNoiseRunsCumulativeMetricsWeights(const std::string& CsvPath);
 
         void exportEmissionsRuns(const std::string& CsvPath);
 
@@ -5,7 +5,7 @@
 #include "CsvImport.h"
 
 #include "Application.h"
-#include "Csv.h"
+#include "IO/Csv.h"
 
 namespace GRAPE::IO::CSV {
     namespace {
@@ -817,6 +817,7 @@ namespace GRAPE::IO::CSV {
                 if (!study.Doc29Noises().contains(doc29NsName))
                     throw GrapeException(std::format("Doc29 Noise '{}' does not exist in this study.", doc29NsName));
                 auto& doc29Ns = study.Doc29Noises()(doc29NsName);
+                study.Doc29Noises.loadNpd(doc29Ns);
 
                 const auto opTypeStr = csv.getCell<std::string>(row, 1);
                 if (!OperationTypes.contains(opTypeStr))
@@ -6,8 +6,11 @@
 
 #include "Application.h"
 #include "Aircraft/Doc29/Doc29NoiseGenerator.h"
+#include "Aircraft/Doc29/Doc29ProfileCache.h"
 #include "Airport/RouteCalculator.h"
 #include "IO/AnpImport.h"
+#include "Scenario/NoiseRunOutput.h"
+#include "Scenario/PerformanceRunOutput.h"
 
 #pragma warning ( push )
 #pragma warning ( disable : GRAPE_VENDOR_WARNINGS )
@@ -43,6 +46,75 @@ namespace GRAPE {
 
             ImGui::Separator();
 
+            UI::textInfo("Database");
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Write-ahead log (applied when opening a study):");
+            ImGui::SameLine();
+            ImGui::Checkbox("##Write Ahead Log", &Database::s_WriteAheadLog);
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Memory mapped size per connection:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(UI::g_StandardItemWidth);
+            UI::inputInt("Memory mapped size", Database::s_MmapSize, 0, std::numeric_limits<int>::max(), "MiB");
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Maximum reader connections:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(UI::g_StandardItemWidth);
+            UI::inputInt("Reader connections", Database::s_ReaderConnections, 1, std::numeric_limits<int>::max());
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Busy timeout (applied when opening a connection):");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(UI::g_StandardItemWidth);
+            UI::inputInt("Busy timeout", Database::s_BusyTimeout, 0, std::numeric_limits<int>::max(), "ms");
+
+            ImGui::Separator();
+
+            UI::textInfo("Performance Run Output");
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Memory budget per performance run:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(UI::g_StandardItemWidth);
+            UI::inputInt("Memory budget", PerformanceRunOutput::s_MemoryBudget, 0, std::numeric_limits<int>::max(), "MiB");
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Save points:");
+            ImGui::SameLine();
+            ImGui::Checkbox("##Save Points", &PerformanceRunOutput::s_SavePoints);
+
+            ImGui::Separator();
+
+            UI::textInfo("Noise Run Output");
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Memory budget per noise run:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(UI::g_StandardItemWidth);
+            UI::inputInt("Noise memory budget", NoiseRunOutput::s_MemoryBudget, 0, std::numeric_limits<int>::max(), "MiB");
+
+            ImGui::Separator();
+
+            UI::textInfo("Doc29 Performance Calculator");
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Interpolate profiles between weights:");
+            ImGui::SameLine();
+            ImGui::Checkbox("##Weight Table", &Doc29ProfileCache::s_WeightTable);
+
+            ImGui::BeginDisabled(!Doc29ProfileCache::s_WeightTable);
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextDisabled("Weight interval:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(UI::g_StandardItemWidth);
+            UI::inputDouble("Weight interval", Doc29ProfileCache::s_WeightTableInterval, 0.0, Constants::Inf, set.WeightUnits);
+            ImGui::EndDisabled();
+
+            ImGui::Separator();
+
             UI::textInfo("Doc29 Noise Calculator");
 
             ImGui::AlignTextToFramePadding();
@@ -34,6 +34,8 @@ namespace GRAPE {
         if (isSelected(Doc29Acft))
             return;
 
+        Application::study().Doc29Aircrafts.loadProfiles(Doc29Acft); // Profiles and aerodynamic coefficients are edited in the aircraft view
+
         clearNoiseSelection();
         m_SelectedDoc29ProfileArrivals.clear();
         m_SelectedDoc29ProfileDepartures.clear();
@@ -68,6 +70,8 @@ namespace GRAPE {
         if (isSelected(Doc29Ns))
             return;
 
+        Application::study().Doc29Noises.loadNpd(Doc29Ns);
+
         clearAircraftSelection();
         m_SelectedNpdData = nullptr;
 
@@ -67,7 +67,7 @@ namespace GRAPE {
         clearOutputSelection();
 
         m_SelectedOutputOperation = &Op;
-        m_SelectedPerformanceOutput = std::make_unique<const PerformanceOutput>(m_SelectedPerformanceRun->output().output(Op));
+        m_SelectedPerformanceOutput = m_SelectedPerformanceRun->output().output(Op);
     }
 
     void ScenariosPanel::selectNoiseSingleEventOutput(const Operation& Op) {
@@ -298,6 +298,22 @@ namespace GRAPE {
             if (UI::selectableNew("Emissions Run"))
                 study.Scenarios.addEmissionsRun(PerfRun);
 
+            // Noise and emissions runs consume the performance outputs while the performance run is running
+            if (perfRunJob->ready() && UI::selectableWithIcon("Start Pipeline", ICON_FA_PLAY))
+            {
+                Application::get().panelStackOnPerformanceRunStart();
+                study.Jobs.queueJob(perfRunJob);
+                if (perfRunJob->waiting())
+                {
+                    for (const auto& nsRun : PerfRun.NoiseRuns | std::views::values)
+                        if (nsRun.job()->ready())
+                            study.Jobs.queueJob(nsRun.job(), { perfRunJob });
+                    for (const auto& emiRun : PerfRun.EmissionsRuns | std::views::values)
+                        if (emiRun.job()->ready())
+                            study.Jobs.queueJob(emiRun.job(), { perfRunJob });
+                }
+            }
+
             if (!perfRunJob->ready() && UI::selectableWithIcon("Reset Run", ICON_FA_BACKWARD_STEP))
             {
                 clearOutputSelection();
@@ -414,11 +430,11 @@ namespace GRAPE {
 
         // Run
         UI::tableNextColumn();
-        if (NsRun.parentPerformanceRun().job()->finished())
+        if (const auto& perfRunJob = NsRun.parentPerformanceRun().job(); perfRunJob->finished() || perfRunJob->waiting() || perfRunJob->running())
             if (UI::progressBar(*nsRunJob))
             {
                 Application::get().panelStackOnNoiseRunStart();
-                study.Jobs.queueJob(nsRunJob);
+                study.Jobs.queueJob(nsRunJob, { perfRunJob });
             }
 
         if (open)
@@ -478,9 +494,9 @@ namespace GRAPE {
 
         // Run
         UI::tableNextColumn();
-        if (EmiRun.parentPerformanceRun().job()->finished())
+        if (const auto& perfRunJob = EmiRun.parentPerformanceRun().job(); perfRunJob->finished() || perfRunJob->waiting() || perfRunJob->running())
             if (UI::progressBar(*emiRunJob))
-                study.Jobs.queueJob(emiRunJob);
+                study.Jobs.queueJob(emiRunJob, { perfRunJob });
 
         if (open)
             ImGui::TreePop();
@@ -544,7 +560,7 @@ namespace GRAPE {
 
         if (ImGui::CollapsingHeader("Flights"))
         {
-            ImGui::BeginDisabled(study.Blocks.notEditable(scen));
+            ImGui::BeginDisabled(!study.Scenarios.operationsEditable(scen));
 
             if (UI::beginTable("Flights", 8, ImGuiTableFlags_None, ImVec2(0.0f, UI::getTableHeight(study.Operations.flightsSize()))))
             {
@@ -644,7 +660,7 @@ namespace GRAPE {
 
         if (ImGui::CollapsingHeader("Tracks 4D"))
         {
-            ImGui::BeginDisabled(study.Blocks.notEditable(scen));
+            ImGui::BeginDisabled(!study.Scenarios.operationsEditable(scen));
 
             if (UI::beginTable("Tracks4D", 3))
             {
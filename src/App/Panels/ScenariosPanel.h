@@ -46,7 +46,7 @@ namespace GRAPE {
         EmissionsRun* m_SelectedEmissionsRun = nullptr;
 
         const Operation* m_SelectedOutputOperation = nullptr;
-        std::unique_ptr<const PerformanceOutput> m_SelectedPerformanceOutput;
+        std::shared_ptr<const PerformanceOutput> m_SelectedPerformanceOutput;
         std::unique_ptr<const NoiseSingleEventOutput> m_SelectedNoiseSingleEventOutput;
         std::unique_ptr<const EmissionsOperationOutput> m_SelectedEmissionsSegmentOutput;
 
@@ -5,8 +5,11 @@
 #include "Settings.h"
 
 #include "Aircraft/Doc29/Doc29NoiseGenerator.h"
+#include "Aircraft/Doc29/Doc29ProfileCache.h"
 #include "Airport/RouteCalculator.h"
 #include "IO/AnpImport.h"
+#include "Scenario/NoiseRunOutput.h"
+#include "Scenario/PerformanceRunOutput.h"
 
 #pragma warning ( push )
 #pragma warning ( disable : GRAPE_VENDOR_WARNINGS )
@@ -24,6 +27,15 @@ namespace GRAPE {
             Buf->appendf("%s", std::format("RouteArcInterval={}\n", RouteCalculator::s_ArcInterval).c_str());
             Buf->appendf("%s", std::format("RouteHeadingChangeWarning={}\n", RouteCalculator::s_WarnHeadingChange).c_str());
             Buf->appendf("%s", std::format("RouteRNPRadiusDeltaWarning={}\n", RouteCalculator::s_WarnRnpRadiusDifference).c_str());
+            Buf->appendf("%s", std::format("DatabaseWriteAheadLog={}\n", static_cast<int>(Database::s_WriteAheadLog)).c_str());
+            Buf->appendf("%s", std::format("DatabaseMmapSize={}\n", Database::s_MmapSize).c_str());
+            Buf->appendf("%s", std::format("DatabaseReaderConnections={}\n", Database::s_ReaderConnections).c_str());
+            Buf->appendf("%s", std::format("DatabaseBusyTimeout={}\n", Database::s_BusyTimeout).c_str());
+            Buf->appendf("%s", std::format("PerformanceOutputMemoryBudget={}\n", PerformanceRunOutput::s_MemoryBudget).c_str());
+            Buf->appendf("%s", std::format("PerformanceOutputSavePoints={}\n", static_cast<int>(PerformanceRunOutput::s_SavePoints)).c_str());
+            Buf->appendf("%s", std::format("NoiseOutputMemoryBudget={}\n", NoiseRunOutput::s_MemoryBudget).c_str());
+            Buf->appendf("%s", std::format("Doc29ProfileWeightTable={}\n", static_cast<int>(Doc29ProfileCache::s_WeightTable)).c_str());
+            Buf->appendf("%s", std::format("Doc29ProfileWeightTableInterval={}\n", Doc29ProfileCache::s_WeightTableInterval).c_str());
             Buf->appendf("%s", std::format("Doc29NoiseMaximumDistance={}\n", Doc29NoiseGenerator::s_MaximumDistance).c_str());
             Buf->appendf("%s", std::format("AnpImportFleet={}\n", static_cast<int>(IO::AnpImport::s_ImportFleet)).c_str());
             Buf->appendf("%s", std::format("AnpImporterApproachDescendAsLandThreshold={}\n", IO::AnpImport::s_MaxThresholdCrossingAltitude).c_str());
@@ -87,6 +99,66 @@ namespace GRAPE {
                 return;
             }
 
+            if (sscanf_s(Line, "DatabaseWriteAheadLog=%i", &i1) == 1)
+            {
+                Database::s_WriteAheadLog = static_cast<bool>(i1);
+                return;
+            }
+
+            if (sscanf_s(Line, "DatabaseMmapSize=%i", &i1) == 1)
+            {
+                if (i1 >= 0)
+                    Database::s_MmapSize = i1;
+                return;
+            }
+
+            if (sscanf_s(Line, "DatabaseReaderConnections=%i", &i1) == 1)
+            {
+                if (i1 >= 1)
+                    Database::s_ReaderConnections = i1;
+                return;
+            }
+
+            if (sscanf_s(Line, "DatabaseBusyTimeout=%i", &i1) == 1)
+            {
+                if (i1 >= 0)
+                    Database::s_BusyTimeout = i1;
+                return;
+            }
+
+            if (sscanf_s(Line, "PerformanceOutputMemoryBudget=%i", &i1) == 1)
+            {
+                if (i1 >= 0)
+                    PerformanceRunOutput::s_MemoryBudget = i1;
+                return;
+            }
+
+            if (sscanf_s(Line, "PerformanceOutputSavePoints=%i", &i1) == 1)
+            {
+                PerformanceRunOutput::s_SavePoints = static_cast<bool>(i1);
+                return;
+            }
+
+            if (sscanf_s(Line, "NoiseOutputMemoryBudget=%i", &i1) == 1)
+            {
+                if (i1 >= 0)
+                    NoiseRunOutput::s_MemoryBudget = i1;
+                return;
+            }
+
+            if (sscanf_s(Line, "Doc29ProfileWeightTable=%i", &i1) == 1)
+            {
+                Doc29ProfileCache::s_WeightTable = static_cast<bool>(i1);
+                return;
+            }
+
+            if (sscanf_s(Line, "Doc29ProfileWeightTableInterval=%lf", &d1) == 1)
+            {
+                if (d1 > 0.0)
+                    Doc29ProfileCache::s_WeightTableInterval = d1;
+                return;
+            }
+
             if (sscanf_s(Line, "Doc29NoiseMaximumDistance=%lf", &d1) == 1)
             {
                 if (d1 >= 0.0)
@@ -245,6 +245,12 @@ namespace GRAPE::UI {
             ImGui::PushStyleColor(ImGuiCol_PlotHistogram, g_ExtraColors[GrapeColNew]);
             ImGui::ProgressBar(1.0f, ImVec2(-FLT_MIN, 0), "Done");
         }
+        else if (Jb.outdated())
+        {
+            ImGui::PushStyleColor(ImGuiCol_Text, g_ExtraColors[GrapeColEdit]);
+            if (selectableWithIcon("Update", ICON_FA_ROTATE))
+                start = true;
+        }
         else { GRAPE_ASSERT(false); }
         ImGui::PopStyleColor();
 
@@ -0,0 +1,336 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#include "GRAPE_pch.h"
+
+#include "BatchRunner.h"
+
+#include "Json.h"
+
+#include "Aircraft/Doc29/Doc29NoiseGenerator.h"
+#include "Aircraft/Doc29/Doc29ProfileCache.h"
+#include "Airport/RouteCalculator.h"
+#include "IO/StudyCsvExport.h"
+#include "Scenario/NoiseRunOutput.h"
+#include "Scenario/PerformanceRunOutput.h"
+
+#include <charconv>
+#include <fstream>
+
+namespace GRAPE {
+    bool BatchRunner::open(const std::filesystem::path& Path) {
+        close();
+        m_Study = std::make_unique<Study>();
+        if (!m_Study->open(Path))
+        {
+            m_Study.reset();
+            return false;
+        }
+        return true;
+    }
+
+    bool BatchRunner::create(const std::filesystem::path& Path) {
+        close();
+        m_Study = std::make_unique<Study>();
+        if (!m_Study->create(Path))
+        {
+            m_Study.reset();
+            return false;
+        }
+        return true;
+    }
+
+    bool BatchRunner::deleteOutputs() {
+        if (!m_Study)
+        {
+            Log::core()->error("Deleting outputs. No study open.");
+            return false;
+        }
+
+        m_Study->Scenarios.eraseOutputs();
+        return true;
+    }
+
+    void BatchRunner::close() {
+        if (!m_Study)
+            return;
+
+        waitForRuns();
+        m_Study.reset(); // Shuts down the job manager and closes the database
+    }
+
+    bool BatchRunner::queuePerformanceRun(const std::string& ScenarioName, const std::string& PerformanceRunName) {
+        const auto perfRun = performanceRun(ScenarioName, PerformanceRunName);
+        if (!perfRun)
+            return false;
+
+        const auto& perfRunJob = perfRun->job();
+        if (!perfRunJob->ready())
+        {
+            Log::core()->info("Performance run '{}' of scenario '{}' has already been run.", PerformanceRunName, ScenarioName);
+            return true;
+        }
+
+        m_Study->Jobs.queueJob(perfRunJob);
+        m_Queued.emplace_back(perfRunJob);
+        return perfRunJob->waiting();
+    }
+
+    bool BatchRunner::queueNoiseRun(const std::string& ScenarioName, const std::string& PerformanceRunName, const std::string& NoiseRunName) {
+        const auto perfRun = performanceRun(ScenarioName, PerformanceRunName);
+        if (!perfRun)
+            return false;
+
+        if (!perfRun->NoiseRuns.contains(NoiseRunName))
+        {
+            Log::core()->error("Noise run '{}' not found in performance run '{}' of scenario '{}'.", NoiseRunName, PerformanceRunName, ScenarioName);
+            return false;
+        }
+
+        const auto& nsRunJob = perfRun->NoiseRuns(NoiseRunName).job();
+        if (!nsRunJob->ready())
+        {
+            Log::core()->info("Noise run '{}' of performance run '{}' of scenario '{}' has already been run.", NoiseRunName, PerformanceRunName, ScenarioName);
+            return true;
+        }
+
+        m_Study->Jobs.queueJob(nsRunJob, { perfRun->job() });
+        m_Queued.emplace_back(nsRunJob);
+        return nsRunJob->waiting();
+    }
+
+    bool BatchRunner::queueEmissionsRun(const std::string& ScenarioName, const std::string& PerformanceRunName, const std::string& EmissionsRunName) {
+        const auto perfRun = performanceRun(ScenarioName, PerformanceRunName);
+        if (!perfRun)
+            return false;
+
+        if (!perfRun->EmissionsRuns.contains(EmissionsRunName))
+        {
+            Log::core()->error("Emissions run '{}' not found in performance run '{}' of scenario '{}'.", EmissionsRunName, PerformanceRunName, ScenarioName);
+            return false;
+        }
+
+        const auto& emiRunJob = perfRun->EmissionsRuns(EmissionsRunName).job();
+        if (!emiRunJob->ready())
+        {
+            Log::core()->info("Emissions run '{}' of performance run '{}' of scenario '{}' has already been run.", EmissionsRunName, PerformanceRunName, ScenarioName);
+            return true;
+        }
+
+        m_Study->Jobs.queueJob(emiRunJob, { perfRun->job() });
+        m_Queued.emplace_back(emiRunJob);
+        return emiRunJob->waiting();
+    }
+
+    bool BatchRunner::waitForRuns() {
+        if (!m_Study)
+            return true;
+
+        m_Study->Jobs.waitForJobs();
+        const bool success = std::ranges::all_of(m_Queued, [](const std::shared_ptr<Job>& Jb) { return Jb->finished(); });
+        m_Queued.clear();
+        return success;
+    }
+
+    bool BatchRunner::exportCsv(const std::filesystem::path& FolderPath) const {
+        if (!m_Study)
+        {
+            Log::core()->error("Exporting CSV files to '{}'. No study open.", FolderPath.string());
+            return false;
+        }
+
+        std::error_code err;
+        std::filesystem::create_directories(FolderPath, err);
+        if (err)
+        {
+            Log::core()->error("Exporting CSV files to '{}'. {}", FolderPath.string(), err.message());
+            return false;
+        }
+
+        IO::CSV::exportStudyFiles(*m_Study, FolderPath.string());
+        return true;
+    }
+
+    bool BatchRunner::runManifest(const std::filesystem::path& Path) {
+        try
+        {
+            const auto manifest = JsonValue::parseFile(Path);
+            if (const auto settings = manifest.find("settings"))
+                applySettings(*settings);
+
+            bool success = true;
+            for (const auto& studyEntry : manifest.at("studies").elements())
+                success &= runManifestStudy(studyEntry, Path.parent_path());
+            return success;
+        }
+        catch (const std::exception& err)
+        {
+            Log::core()->error("Running manifest '{}'. {}", Path.string(), err.what());
+            close();
+            return false;
+        }
+    }
+
+    PerformanceRun* BatchRunner::performanceRun(const std::string& ScenarioName, const std::string& PerformanceRunName) const {
+        if (!m_Study)
+        {
+            Log::core()->error("Starting performance run '{}' of scenario '{}'. No study open.", PerformanceRunName, ScenarioName);
+            return nullptr;
+        }
+
+        if (!m_Study->Scenarios().contains(ScenarioName))
+        {
+            Log::core()->error("Scenario '{}' not found in study '{}'.", ScenarioName, m_Study->name());
+            return nullptr;
+        }
+        auto& scen = m_Study->Scenarios(ScenarioName);
+
+        if (!scen.PerformanceRuns.contains(PerformanceRunName))
+        {
+            Log::core()->error("Performance run '{}' not found in scenario '{}'.", PerformanceRunName, ScenarioName);
+            return nullptr;
+        }
+        return &scen.PerformanceRuns(PerformanceRunName);
+    }
+
+    bool BatchRunner::loadSettings(const std::filesystem::path& Path) {
+        std::ifstream file(Path);
+        if (!file)
+        {
+            Log::core()->error("Loading settings from '{}'. Could not open file.", Path.string());
+            return false;
+        }
+
+        // Section written by the settings handler of the graphical application
+        constexpr std::string_view section = "[Grape Settings][Grape Settings]";
+
+        bool inSection = false;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.ends_with('\r'))
+                line.pop_back();
+
+            if (line.starts_with('['))
+            {
+                inSection = line == section;
+                continue;
+            }
+
+            const auto eqPos = line.find('=');
+            if (!inSection || eqPos == std::string::npos)
+                continue;
+
+            const std::string_view key(line.data(), eqPos);
+            const std::string_view valueStr(line.data() + eqPos + 1, line.size() - eqPos - 1);
+            double value = 0.0;
+            const auto [ptr, ec] = std::from_chars(valueStr.data(), valueStr.data() + valueStr.size(), value);
+            if (ec != std::errc() || ptr != valueStr.data() + valueStr.size())
+            {
+                Log::core()->warn("Invalid value for setting '{}' ignored.", key);
+                continue;
+            }
+
+            // The unit and ANP import settings are skipped as unknown keys
+            applySetting(key, value, false);
+        }
+        return true;
+    }
+
+    void BatchRunner::applySettings(const JsonValue& Settings) {
+        const auto& keys = Settings.keys();
+        const auto& values = Settings.elements();
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            const auto& value = values.at(i);
+            applySetting(keys.at(i), value.isBool() ? static_cast<double>(value.asBool()) : value.asNumber(), true);
+        }
+    }
+
+    /**
+    * Same validation as the settings read from grape.ini by the graphical application, invalid values are ignored with a warning.
+    */
+    void BatchRunner::applySetting(std::string_view Key, double Value, bool WarnUnknown) {
+        const auto setNumber = [&]<typename T>(T& Setting, bool Valid) {
+            if (Valid)
+                Setting = static_cast<T>(Value);
+            else
+                Log::core()->warn("Invalid value for setting '{}' ignored.", Key);
+        };
+
+        if (Key == "ConcurrentJobs")
+            setNumber(JobManager::s_ConcurrentJobs, Value >= 1.0);
+        else if (Key == "DatabaseWriteAheadLog")
+            Database::s_WriteAheadLog = Value != 0.0;
+        else if (Key == "DatabaseMmapSize")
+            setNumber(Database::s_MmapSize, Value >= 0.0);
+        else if (Key == "DatabaseReaderConnections")
+            setNumber(Database::s_ReaderConnections, Value >= 1.0);
+        else if (Key == "DatabaseBusyTimeout")
+            setNumber(Database::s_BusyTimeout, Value >= 0.0);
+        else if (Key == "RouteArcInterval")
+            setNumber(RouteCalculator::s_ArcInterval, Value >= Constants::Precision && Value < 360.0);
+        else if (Key == "RouteHeadingChangeWarning")
+            setNumber(RouteCalculator::s_WarnHeadingChange, Value >= 1.0 && Value < 360.0);
+        else if (Key == "RouteRNPRadiusDeltaWarning")
+            setNumber(RouteCalculator::s_WarnRnpRadiusDifference, Value >= 0.0);
+        else if (Key == "PerformanceOutputMemoryBudget")
+            setNumber(PerformanceRunOutput::s_MemoryBudget, Value >= 0.0);
+        else if (Key == "PerformanceOutputSavePoints")
+            PerformanceRunOutput::s_SavePoints = Value != 0.0;
+        else if (Key == "NoiseOutputMemoryBudget")
+            setNumber(NoiseRunOutput::s_MemoryBudget, Value >= 0.0);
+        else if (Key == "Doc29ProfileWeightTable")
+            Doc29ProfileCache::s_WeightTable = Value != 0.0;
+        else if (Key == "Doc29ProfileWeightTableInterval")
+            setNumber(Doc29ProfileCache::s_WeightTableInterval, Value > 0.0);
+        else if (Key == "Doc29NoiseMaximumDistance")
+            setNumber(Doc29NoiseGenerator::s_MaximumDistance, Value >= 0.0);
+        else if (WarnUnknown)
+            Log::core()->warn("Unknown setting '{}' ignored.", Key);
+    }
+
+    bool BatchRunner::runManifestStudy(const JsonValue& StudyEntry, const std::filesystem::path& ManifestDir) {
+        std::filesystem::path path = StudyEntry.at("path").asString();
+        if (path.is_relative())
+            path = ManifestDir / path;
+
+        const auto create = StudyEntry.find("create");
+        if (!(create && create->asBool() ? this->create(path) : open(path)))
+            return false;
+
+        bool success = true;
+        if (const auto deleteOuts = StudyEntry.find("delete_outputs"); deleteOuts && deleteOuts->asBool())
+            success &= deleteOutputs();
+
+        if (const auto runs = StudyEntry.find("runs"))
+        {
+            for (const auto& run : runs->elements())
+            {
+                const auto& scenName = run.at("scenario").asString();
+                const auto& perfRunName = run.at("performance_run").asString();
+                success &= queuePerformanceRun(scenName, perfRunName);
+
+                if (const auto nsRuns = run.find("noise_runs"))
+                    for (const auto& nsRunName : nsRuns->elements())
+                        success &= queueNoiseRun(scenName, perfRunName, nsRunName.asString());
+
+                if (const auto emiRuns = run.find("emissions_runs"))
+                    for (const auto& emiRunName : emiRuns->elements())
+                        success &= queueEmissionsRun(scenName, perfRunName, emiRunName.asString());
+            }
+        }
+
+        success &= waitForRuns();
+
+        if (const auto exportCsvEntry = StudyEntry.find("export_csv"))
+        {
+            std::filesystem::path exportPath = exportCsvEntry->asString();
+            if (exportPath.is_relative())
+                exportPath = ManifestDir / exportPath;
+            success &= exportCsv(exportPath);
+        }
+
+        close();
+        return success;
+    }
+}
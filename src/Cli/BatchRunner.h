@@ -0,0 +1,86 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#pragma once
+
+#include "Study/Study.h"
+
+namespace GRAPE {
+    class JsonValue;
+
+    /**
+    * @brief Opens studies and runs their performance, noise and emissions runs without the graphical application.
+    *
+    * Runs are queued in the JobManager of the study, noise and emissions runs depend on their performance run and consume its outputs while it is running.
+    * A run manifest is a JSON document with the following layout, relative study paths are resolved against the folder of the manifest:
+    * {
+    *   "settings": { "ConcurrentJobs": 4, "PerformanceOutputMemoryBudget": 1024, ... },
+    *   "studies": [
+    *     {
+    *       "path": "study.grp",
+    *       "create": false,
+    *       "delete_outputs": false,
+    *       "export_csv": "Exported",
+    *       "runs": [ { "scenario": "Scenario", "performance_run": "Performance Run", "noise_runs": [ "Noise Run" ], "emissions_runs": [ "Emissions Run" ] } ]
+    *     }
+    *   ]
+    * }
+    * The settings have the same names as in grape.ini, with the addition of ConcurrentJobs. They are applied before any study is opened and override the settings loaded with loadSettings().
+    *
+    * If export_csv is set, the CSV files of the study tables which don't depend on unit settings are exported to that folder with exportCsv() after the runs of the study have finished. A relative folder is resolved against the folder of the manifest.
+    * The CSV and ANP import and the remaining CSV exports of the graphical application are not available, studies must be prepared with the graphical application.
+    */
+    class BatchRunner {
+    public:
+        // Constructors & Destructor
+        BatchRunner() = default;
+        BatchRunner(const BatchRunner&) = delete;
+        BatchRunner(BatchRunner&&) = delete;
+        BatchRunner& operator=(const BatchRunner&) = delete;
+        BatchRunner& operator=(BatchRunner&&) = delete;
+        ~BatchRunner() = default;
+
+        // Study
+        bool open(const std::filesystem::path& Path);
+        bool create(const std::filesystem::path& Path);
+        bool deleteOutputs();
+        void close();
+
+        // Runs
+        bool queuePerformanceRun(const std::string& ScenarioName, const std::string& PerformanceRunName);
+        bool queueNoiseRun(const std::string& ScenarioName, const std::string& PerformanceRunName, const std::string& NoiseRunName);
+        bool queueEmissionsRun(const std::string& ScenarioName, const std::string& PerformanceRunName, const std::string& EmissionsRunName);
+
+        /**
+        * @brief Blocks until all queued runs have finished.
+        * @return True if all runs queued since the last call finished successfully.
+        */
+        bool waitForRuns();
+
+        /**
+        * @brief Exports the CSV files of the study tables which don't depend on unit settings to FolderPath, which is created if needed.
+        * @return False if no study is open or the folder could not be created.
+        */
+        bool exportCsv(const std::filesystem::path& FolderPath) const;
+
+        /**
+        * @brief Loads the global settings saved by the graphical application in the grape.ini file at Path. The unit and ANP import settings are ignored.
+        * @return False if the file could not be opened.
+        */
+        static bool loadSettings(const std::filesystem::path& Path);
+
+        /**
+        * @brief Applies the settings and processes each study of the manifest at Path in order, waiting for its runs before opening the next.
+        * @return True if the manifest is valid and all studies and runs were processed successfully.
+        */
+        bool runManifest(const std::filesystem::path& Path);
+
+    private:
+        std::unique_ptr<Study> m_Study;
+        std::vector<std::shared_ptr<Job>> m_Queued;
+    private:
+        [[nodiscard]] PerformanceRun* performanceRun(const std::string& ScenarioName, const std::string& PerformanceRunName) const;
+        static void applySettings(const JsonValue& Settings);
+        static void applySetting(std::string_view Key, double Value, bool WarnUnknown);
+        bool runManifestStudy(const JsonValue& StudyEntry, const std::filesystem::path& ManifestDir);
+    };
+}
@@ -0,0 +1,382 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#include "GRAPE_pch.h"
+
+#include "Json.h"
+
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace GRAPE {
+    /**
+    * @brief Recursive descent parser. Strings support all escapes, \u escapes are encoded as UTF-8.
+    */
+    class JsonParser {
+    public:
+        explicit JsonParser(std::string_view Text) : m_Text(Text) {}
+
+        JsonValue parseDocument() {
+            JsonValue outValue = parseValue(0);
+            skipWhitespace();
+            if (m_Pos != m_Text.size())
+                error("Unexpected characters after the end of the document.");
+            return outValue;
+        }
+
+    private:
+        // Protects against stack overflows on malicious inputs
+        static constexpr std::size_t s_MaximumDepth = 256;
+
+        std::string_view m_Text;
+        std::size_t m_Pos = 0;
+    private:
+        [[noreturn]] void error(std::string_view Message) const {
+            const auto line = std::ranges::count(m_Text.substr(0, std::min(m_Pos, m_Text.size())), '\n') + 1;
+            throw GrapeException(std::format("Invalid JSON at line {}. {}", line, Message));
+        }
+
+        void skipWhitespace() {
+            while (m_Pos < m_Text.size() && (m_Text[m_Pos] == ' ' || m_Text[m_Pos] == '\t' || m_Text[m_Pos] == '\n' || m_Text[m_Pos] == '\r'))
+                ++m_Pos;
+        }
+
+        [[nodiscard]] char peek() const { return m_Pos < m_Text.size() ? m_Text[m_Pos] : '\0'; }
+
+        void expect(char C) {
+            if (peek() != C)
+                error(std::format("Expected '{}'.", C));
+            ++m_Pos;
+        }
+
+        bool consumeLiteral(std::string_view Literal) {
+            if (m_Text.substr(m_Pos, Literal.size()) != Literal)
+                return false;
+            m_Pos += Literal.size();
+            return true;
+        }
+
+        JsonValue parseValue(std::size_t Depth) {
+            if (Depth > s_MaximumDepth)
+                error("Maximum nesting depth exceeded.");
+
+            skipWhitespace();
+            JsonValue outValue;
+            switch (peek())
+            {
+            case '{':
+                {
+                    outValue.m_Type = JsonValue::Type::Object;
+                    ++m_Pos;
+                    skipWhitespace();
+                    if (peek() == '}')
+                    {
+                        ++m_Pos;
+                        break;
+                    }
+
+                    while (true)
+                    {
+                        skipWhitespace();
+                        if (peek() != '"')
+                            error("Expected member name.");
+                        outValue.m_Keys.emplace_back(parseString());
+                        skipWhitespace();
+                        expect(':');
+                        outValue.m_Elements.emplace_back(parseValue(Depth + 1));
+                        skipWhitespace();
+                        if (peek() == ',')
+                        {
+                            ++m_Pos;
+                            continue;
+                        }
+                        expect('}');
+                        break;
+                    }
+                    break;
+                }
+            case '[':
+                {
+                    outValue.m_Type = JsonValue::Type::Array;
+                    ++m_Pos;
+                    skipWhitespace();
+                    if (peek() == ']')
+                    {
+                        ++m_Pos;
+                        break;
+                    }
+
+                    while (true)
+                    {
+                        outValue.m_Elements.emplace_back(parseValue(Depth + 1));
+                        skipWhitespace();
+                        if (peek() == ',')
+                        {
+                            ++m_Pos;
+                            continue;
+                        }
+                        expect(']');
+                        break;
+                    }
+                    break;
+                }
+            case '"':
+                {
+                    outValue.m_Type = JsonValue::Type::String;
+                    outValue.m_String = parseString();
+                    break;
+                }
+            case 't':
+            case 'f':
+                {
+                    outValue.m_Type = JsonValue::Type::Bool;
+                    if (consumeLiteral("true"))
+                        outValue.m_Bool = true;
+                    else if (!consumeLiteral("false"))
+                        error("Invalid literal.");
+                    break;
+                }
+            case 'n':
+                {
+                    if (!consumeLiteral("null"))
+                        error("Invalid literal.");
+                    break;
+                }
+            default:
+                {
+                    outValue.m_Type = JsonValue::Type::Number;
+                    outValue.m_Number = parseNumber();
+                    break;
+                }
+            }
+            return outValue;
+        }
+
+        std::string parseString() {
+            expect('"');
+            std::string outStr;
+            while (true)
+            {
+                if (m_Pos >= m_Text.size())
+                    error("Unterminated string.");
+
+                const char c = m_Text[m_Pos++];
+                if (c == '"')
+                    break;
+
+                if (static_cast<unsigned char>(c) < 0x20)
+                    error("Control character in string.");
+
+                if (c != '\\')
+                {
+                    outStr.push_back(c);
+                    continue;
+                }
+
+                if (m_Pos >= m_Text.size())
+                    error("Unterminated string.");
+
+                switch (const char escaped = m_Text[m_Pos++])
+                {
+                case '"':
+                case '\\':
+                case '/': outStr.push_back(escaped); break;
+                case 'b': outStr.push_back('\b'); break;
+                case 'f': outStr.push_back('\f'); break;
+                case 'n': outStr.push_back('\n'); break;
+                case 'r': outStr.push_back('\r'); break;
+                case 't': outStr.push_back('\t'); break;
+                case 'u': appendUtf8(outStr, parseCodePoint()); break;
+                default: error("Invalid escape sequence.");
+                }
+            }
+            return outStr;
+        }
+
+        unsigned int parseHex4() {
+            if (m_Pos + 4 > m_Text.size())
+                error("Invalid unicode escape.");
+
+            unsigned int outValue = 0;
+            const auto [ptr, ec] = std::from_chars(m_Text.data() + m_Pos, m_Text.data() + m_Pos + 4, outValue, 16);
+            if (ec != std::errc() || ptr != m_Text.data() + m_Pos + 4)
+                error("Invalid unicode escape.");
+            m_Pos += 4;
+            return outValue;
+        }
+
+        unsigned int parseCodePoint() {
+            const unsigned int high = parseHex4();
+            if (high < 0xD800 || high > 0xDBFF)
+                return high;
+
+            // Surrogate pair
+            if (!consumeLiteral("\\u"))
+                error("Invalid unicode surrogate pair.");
+            const unsigned int low = parseHex4();
+            if (low < 0xDC00 || low > 0xDFFF)
+                error("Invalid unicode surrogate pair.");
+            return 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+        }
+
+        static void appendUtf8(std::string& Str, unsigned int CodePoint) {
+            if (CodePoint < 0x80)
+            {
+                Str.push_back(static_cast<char>(CodePoint));
+            }
+            else if (CodePoint < 0x800)
+            {
+                Str.push_back(static_cast<char>(0xC0 | (CodePoint >> 6)));
+                Str.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+            }
+            else if (CodePoint < 0x10000)
+            {
+                Str.push_back(static_cast<char>(0xE0 | (CodePoint >> 12)));
+                Str.push_back(static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)));
+                Str.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+            }
+            else
+            {
+                Str.push_back(static_cast<char>(0xF0 | (CodePoint >> 18)));
+                Str.push_back(static_cast<char>(0x80 | ((CodePoint >> 12) & 0x3F)));
+                Str.push_back(static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)));
+                Str.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+            }
+        }
+
+        double parseNumber() {
+            const std::size_t start = m_Pos;
+            if (peek() == '-')
+                ++m_Pos;
+
+            if (peek() == '0')
+                ++m_Pos;
+            else if (std::isdigit(static_cast<unsigned char>(peek())))
+                while (std::isdigit(static_cast<unsigned char>(peek())))
+                    ++m_Pos;
+            else
+                error("Invalid value.");
+
+            if (peek() == '.')
+            {
+                ++m_Pos;
+                if (!std::isdigit(static_cast<unsigned char>(peek())))
+                    error("Invalid number.");
+                while (std::isdigit(static_cast<unsigned char>(peek())))
+                    ++m_Pos;
+            }
+
+            if (peek() == 'e' || peek() == 'E')
+            {
+                ++m_Pos;
+                if (peek() == '+' || peek() == '-')
+                    ++m_Pos;
+                if (!std::isdigit(static_cast<unsigned char>(peek())))
+                    error("Invalid number.");
+                while (std::isdigit(static_cast<unsigned char>(peek())))
+                    ++m_Pos;
+            }
+
+            double outValue = 0.0;
+            const auto [ptr, ec] = std::from_chars(m_Text.data() + start, m_Text.data() + m_Pos, outValue);
+            if (ec != std::errc())
+                error("Invalid number.");
+            return outValue;
+        }
+    };
+
+    JsonValue JsonValue::parse(std::string_view Text) {
+        JsonParser parser(Text);
+        return parser.parseDocument();
+    }
+
+    JsonValue JsonValue::parseFile(const std::filesystem::path& Path) {
+        std::ifstream file(Path, std::ios::binary);
+        if (!file)
+            throw GrapeException(std::format("Can't open file '{}'.", Path.string()));
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return parse(buffer.str());
+    }
+
+    bool JsonValue::asBool() const {
+        if (!isBool())
+            throw GrapeException("JSON value is not a boolean.");
+        return m_Bool;
+    }
+
+    double JsonValue::asNumber() const {
+        if (!isNumber())
+            throw GrapeException("JSON value is not a number.");
+        return m_Number;
+    }
+
+    const std::string& JsonValue::asString() const {
+        if (!isString())
+            throw GrapeException("JSON value is not a string.");
+        return m_String;
+    }
+
+    const std::vector<JsonValue>& JsonValue::elements() const {
+        if (!isArray() && !isObject())
+            throw GrapeException("JSON value is not an array or an object.");
+        return m_Elements;
+    }
+
+    const std::vector<std::string>& JsonValue::keys() const {
+        if (!isObject())
+            throw GrapeException("JSON value is not an object.");
+        return m_Keys;
+    }
+
+    const JsonValue* JsonValue::find(std::string_view Key) const {
+        if (!isObject())
+            throw GrapeException("JSON value is not an object.");
+
+        const auto it = std::ranges::find(m_Keys, Key);
+        return it == m_Keys.end() ? nullptr : &m_Elements.at(std::distance(m_Keys.begin(), it));
+    }
+
+    const JsonValue& JsonValue::at(std::string_view Key) const {
+        const auto value = find(Key);
+        if (!value)
+            throw GrapeException(std::format("JSON object has no member '{}'.", Key));
+        return *value;
+    }
+
+    TEST_CASE("JSON Parsing") {
+        SUBCASE("Document") {
+            const auto doc = JsonValue::parse(R"({
+                "study": "C:\\studies\\a.grp",
+                "create": false,
+                "runs": [ { "scenario": "S1", "weight": -1.5e3 }, null ],
+                "name": "\u00e9\ud83d\ude00"
+            })");
+
+            REQUIRE(doc.isObject());
+            CHECK(doc.keys() == std::vector<std::string>{ "study", "create", "runs", "name" });
+            CHECK(doc.at("study").asString() == "C:\\studies\\a.grp");
+            CHECK_FALSE(doc.at("create").asBool());
+            CHECK(doc.find("missing") == nullptr);
+
+            const auto& runs = doc.at("runs").elements();
+            REQUIRE(runs.size() == 2);
+            CHECK(runs.at(0).at("scenario").asString() == "S1");
+            CHECK(runs.at(0).at("weight").asNumber() == doctest::Approx(-1500.0));
+            CHECK(runs.at(1).isNull());
+
+            CHECK(doc.at("name").asString() == "\xC3\xA9\xF0\x9F\x98\x80");
+        }
+
+        SUBCASE("Errors") {
+            CHECK_THROWS_AS(JsonValue::parse(""), GrapeException);
+            CHECK_THROWS_AS(JsonValue::parse("{ \"a\": 1, }"), GrapeException);
+            CHECK_THROWS_AS(JsonValue::parse("[1 2]"), GrapeException);
+            CHECK_THROWS_AS(JsonValue::parse("\"unterminated"), GrapeException);
+            CHECK_THROWS_AS(JsonValue::parse("01"), GrapeException);
+            CHECK_THROWS_AS(JsonValue::parse("{} {}"), GrapeException);
+            CHECK_THROWS_AS(JsonValue::parse("true").asNumber(), GrapeException);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#pragma once
+
+namespace GRAPE {
+    /**
+    * @brief Minimal JSON document model, sufficient to read batch run manifests.
+    *
+    * Objects keep the order of their members. Numbers are stored as double. Parsing errors throw a GrapeException with the line of the error.
+    */
+    class JsonValue {
+    public:
+        enum class Type {
+            Null = 0,
+            Bool,
+            Number,
+            String,
+            Array,
+            Object,
+        };
+
+        JsonValue() = default;
+
+        /**
+        * @brief Parses a complete JSON document. Throws if Text is not valid JSON.
+        */
+        [[nodiscard]] static JsonValue parse(std::string_view Text);
+
+        /**
+        * @brief Reads and parses the JSON document at Path. Throws if the file can't be read or is not valid JSON.
+        */
+        [[nodiscard]] static JsonValue parseFile(const std::filesystem::path& Path);
+
+        // Access Data
+        [[nodiscard]] Type type() const { return m_Type; }
+        [[nodiscard]] bool isNull() const { return m_Type == Type::Null; }
+        [[nodiscard]] bool isBool() const { return m_Type == Type::Bool; }
+        [[nodiscard]] bool isNumber() const { return m_Type == Type::Number; }
+        [[nodiscard]] bool isString() const { return m_Type == Type::String; }
+        [[nodiscard]] bool isArray() const { return m_Type == Type::Array; }
+        [[nodiscard]] bool isObject() const { return m_Type == Type::Object; }
+
+        /**
+        * @brief Throw if the value is not of the requested type.
+        */
+        [[nodiscard]] bool asBool() const;
+        [[nodiscard]] double asNumber() const;
+        [[nodiscard]] const std::string& asString() const;
+
+        /**
+        * @return The elements of an array or the member values of an object. Throws for other types.
+        */
+        [[nodiscard]] const std::vector<JsonValue>& elements() const;
+
+        /**
+        * @return The member names of an object, in the same order as elements(). Throws for other types.
+        */
+        [[nodiscard]] const std::vector<std::string>& keys() const;
+
+        /**
+        * @return The member Key of an object, nullptr if the object has no such member. Throws if the value is not an object.
+        */
+        [[nodiscard]] const JsonValue* find(std::string_view Key) const;
+
+        /**
+        * @return The member Key of an object. Throws if the value is not an object or has no such member.
+        */
+        [[nodiscard]] const JsonValue& at(std::string_view Key) const;
+
+    private:
+        Type m_Type = Type::Null;
+        bool m_Bool = false;
+        double m_Number = 0.0;
+        std::string m_String;
+        std::vector<std::string> m_Keys;
+        std::vector<JsonValue> m_Elements;
+
+        friend class JsonParser;
+    };
+}
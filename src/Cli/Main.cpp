@@ -0,0 +1,137 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#include "GRAPE_pch.h"
+
+#include "BatchRunner.h"
+
+namespace GRAPE {
+    namespace {
+        constexpr std::string_view CommandLineHelp =
+            "\n"
+            "    **** GRAPE command line interface ****\n"
+            "\n"
+            "    Options are processed in the order they are given.\n"
+            "\n"
+            "    [-h]  - Display this help.\n"
+            "    [-s]  - Load the global settings from the grape.ini file specified by the following argument. Unit and ANP import settings are ignored.\n"
+            "    [-c]  - Create a GRAPE study located at the path specified by the following argument.\n"
+            "    [-o]  - Open a GRAPE study located at the path specified by the following argument.\n"
+            "    [-d]  - Delete all outputs from the open study.\n"
+            "    [-rp] - Start the performance run specified by the following argument as <scenario name>-<performance run name>.\n"
+            "    [-rn] - Start the noise run specified by the following argument as <scenario name>-<performance run name>-<noise run name>.\n"
+            "    [-re] - Start the emissions run specified by the following argument as <scenario name>-<performance run name>-<emissions run name>.\n"
+            "    [-x]  - Export the CSV files of the open study to the folder specified by the following argument, after its queued runs have finished.\n"
+            "    [-m]  - Run the JSON manifest located at the path specified by the following argument.\n"
+            "\n"
+            "    Settings loaded with -s apply to the studies opened after it, settings in a manifest override them.\n"
+            "    -x exports the study tables which don't depend on unit settings: Doc29 noise and spectrum, fleet, simple and RNP routes, 4D tracks, scenarios and their operations, noise runs and their cumulative metrics.\n"
+            "    CSV and ANP import and the remaining CSV exports are not available, studies must be prepared with the graphical application.\n"
+            "\n"
+            "    Returns 0 if all options were processed and all runs finished successfully, 1 otherwise.\n";
+
+        /**
+        * @return The first Count names of Arg separated by '-', the last name takes the remainder of Arg. Empty if Arg has less than Count names.
+        */
+        std::vector<std::string> splitRunName(std::string_view Arg, std::size_t Count) {
+            std::vector<std::string> outNames;
+            for (std::size_t i = 0; i + 1 < Count; ++i)
+            {
+                const auto splitPos = Arg.find('-');
+                if (splitPos == std::string_view::npos)
+                    return {};
+                outNames.emplace_back(Arg.substr(0, splitPos));
+                Arg = Arg.substr(splitPos + 1);
+            }
+            outNames.emplace_back(Arg);
+            return outNames;
+        }
+    }
+
+    int main(int ArgCount, char** ArgValues) {
+        initGRAPE();
+
+        const std::vector<std::string> args(ArgValues + 1, ArgValues + ArgCount);
+        if (args.empty() || std::ranges::find(args, "-h") != args.end())
+        {
+            Log::core()->info(CommandLineHelp);
+            return 0;
+        }
+
+        const auto incorrectUsage = [](const std::string& Opt) {
+            Log::core()->error("Incorrect use of option '{}'. Run with -h for help.", Opt);
+            return false;
+        };
+
+        BatchRunner runner;
+        bool success = true;
+        for (std::size_t i = 0; i < args.size(); ++i)
+        {
+            const auto& opt = args.at(i);
+            const bool hasValue = i + 1 < args.size() && !args.at(i + 1).starts_with('-');
+
+            if (opt == "-d")
+            {
+                success &= runner.deleteOutputs();
+                continue;
+            }
+
+            if (!hasValue)
+            {
+                success &= incorrectUsage(opt);
+                continue;
+            }
+
+            const auto& val = args.at(++i);
+            if (opt == "-c")
+            {
+                success &= runner.create(val);
+            }
+            else if (opt == "-o")
+            {
+                success &= runner.open(val);
+            }
+            else if (opt == "-rp")
+            {
+                const auto names = splitRunName(val, 2);
+                success &= names.empty() ? incorrectUsage(opt) : runner.queuePerformanceRun(names.at(0), names.at(1));
+            }
+            else if (opt == "-rn")
+            {
+                const auto names = splitRunName(val, 3);
+                success &= names.empty() ? incorrectUsage(opt) : runner.queueNoiseRun(names.at(0), names.at(1), names.at(2));
+            }
+            else if (opt == "-re")
+            {
+                const auto names = splitRunName(val, 3);
+                success &= names.empty() ? incorrectUsage(opt) : runner.queueEmissionsRun(names.at(0), names.at(1), names.at(2));
+            }
+            else if (opt == "-s")
+            {
+                success &= BatchRunner::loadSettings(val);
+            }
+            else if (opt == "-x")
+            {
+                success &= runner.waitForRuns();
+                success &= runner.exportCsv(val);
+            }
+            else if (opt == "-m")
+            {
+                success &= runner.runManifest(val);
+            }
+            else
+            {
+                Log::core()->error("Unknown option '{}'. Run with -h for help.", opt);
+                success = false;
+            }
+        }
+
+        success &= runner.waitForRuns();
+        runner.close();
+
+        return success ? 0 : 1;
+    }
+}
+
+int main(int ArgCount, char** ArgValues) {
+    return GRAPE::main(ArgCount, ArgValues);
+}
@@ -17,7 +17,7 @@
 #define GRAPE_DOCS_URL "https://goncaloroque30.github.io/GRAPE-Docs/"
 #define GRAPE_ID 367
 #define GRAPE_VERSION_MAJOR 1
-#define GRAPE_VERSION_MINOR 1
+#define GRAPE_VERSION_MINOR 5
 
 #define GRAPE_VERSION_NUMBER GRAPE_MACRO_CONCAT(GRAPE_VERSION_MAJOR, GRAPE_VERSION_MINOR)
 #define GRAPE_VERSION_STRING GRAPE_MACRO_STRINGIFY(GRAPE_VERSION_MAJOR) "." GRAPE_MACRO_STRINGIFY(GRAPE_VERSION_MINOR)
@@ -131,7 +131,9 @@ and it has __linux__ defined */
 #include <utility>
 
 #include "BlockMap.h"
+#include "FlatMap.h"
 #include "GrapeMap.h"
+#include "ThreadPool.h"
 #include "Timer.h"
 
 #include "Platform.h"
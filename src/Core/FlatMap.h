@@ -0,0 +1,179 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace GRAPE {
+    /**
+    * @brief Ordered map with unique keys stored as sorted key value pairs in a contiguous vector.
+    *
+    * Lookups are binary searches and iteration is linear over contiguous memory. Iterators are random access.
+    * Inserting at the end is amortized constant, inserting anywhere else shifts the following elements. Prefer merge() to insert many elements at once.
+    * Any insertion or erasure invalidates iterators and references to the elements.
+    */
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class FlatMap {
+    public:
+        typedef std::pair<Key, Value> value_type;
+        typedef std::vector<value_type> container_type;
+        typedef typename container_type::iterator iterator;
+        typedef typename container_type::const_iterator const_iterator;
+        typedef typename container_type::reverse_iterator reverse_iterator;
+        typedef typename container_type::const_reverse_iterator const_reverse_iterator;
+
+        FlatMap() = default;
+
+        auto begin() noexcept { return m_Data.begin(); }
+        auto end() noexcept { return m_Data.end(); }
+        auto rbegin() noexcept { return m_Data.rbegin(); }
+        auto rend() noexcept { return m_Data.rend(); }
+
+        [[nodiscard]] auto begin() const noexcept { return m_Data.begin(); }
+        [[nodiscard]] auto end() const noexcept { return m_Data.end(); }
+        [[nodiscard]] auto rbegin() const noexcept { return m_Data.rbegin(); }
+        [[nodiscard]] auto rend() const noexcept { return m_Data.rend(); }
+
+        [[nodiscard]] value_type& operator[](std::size_t Index) noexcept { return m_Data[Index]; }
+        [[nodiscard]] const value_type& operator[](std::size_t Index) const noexcept { return m_Data[Index]; }
+
+        [[nodiscard]] value_type& front() noexcept { return m_Data.front(); }
+        [[nodiscard]] const value_type& front() const noexcept { return m_Data.front(); }
+        [[nodiscard]] value_type& back() noexcept { return m_Data.back(); }
+        [[nodiscard]] const value_type& back() const noexcept { return m_Data.back(); }
+
+        [[nodiscard]] bool empty() const noexcept { return m_Data.empty(); }
+        [[nodiscard]] std::size_t size() const noexcept { return m_Data.size(); }
+
+        void reserve(std::size_t Capacity) { m_Data.reserve(Capacity); }
+        void clear() noexcept { m_Data.clear(); }
+
+        /**
+        * @return Iterator to the first element with key not less than K.
+        */
+        [[nodiscard]] iterator lower_bound(const Key& K) { return std::ranges::lower_bound(m_Data, K, m_Compare, &value_type::first); }
+        [[nodiscard]] const_iterator lower_bound(const Key& K) const { return std::ranges::lower_bound(m_Data, K, m_Compare, &value_type::first); }
+
+        /**
+        * @return Iterator to the first element with key greater than K.
+        */
+        [[nodiscard]] iterator upper_bound(const Key& K) { return std::ranges::upper_bound(m_Data, K, m_Compare, &value_type::first); }
+        [[nodiscard]] const_iterator upper_bound(const Key& K) const { return std::ranges::upper_bound(m_Data, K, m_Compare, &value_type::first); }
+
+        /**
+        * @return Iterator to the element with key K or end() if there is none.
+        */
+        [[nodiscard]] iterator find(const Key& K) {
+            const auto it = lower_bound(K);
+            return it != end() && !m_Compare(K, it->first) ? it : end();
+        }
+        [[nodiscard]] const_iterator find(const Key& K) const {
+            const auto it = lower_bound(K);
+            return it != end() && !m_Compare(K, it->first) ? it : end();
+        }
+
+        [[nodiscard]] bool contains(const Key& K) const { return find(K) != end(); }
+
+        /**
+        * @brief Constructs the value in place with Args if K is not in the map.
+        * @return Iterator to the inserted element and true or to the already existing element and false.
+        */
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& K, Args&&... ArgsIn) {
+            // Fast path for elements inserted in ascending order
+            if (m_Data.empty() || m_Compare(m_Data.back().first, K))
+            {
+                m_Data.emplace_back(std::piecewise_construct, std::forward_as_tuple(K), std::forward_as_tuple(std::forward<Args>(ArgsIn)...));
+                return { std::prev(m_Data.end()), true };
+            }
+
+            const auto it = lower_bound(K);
+            if (!m_Compare(K, it->first))
+                return { it, false };
+
+            return { m_Data.emplace(it, std::piecewise_construct, std::forward_as_tuple(K), std::forward_as_tuple(std::forward<Args>(ArgsIn)...)), true };
+        }
+
+        /**
+        * @brief Inserts all Elements, which don't need to be sorted, with one sort and one linear merge.
+        *
+        * Elements with a key already in the map are not inserted and OnExisting is called with the value in the map.
+        * If several elements share the same key only the first one is inserted and OnExisting is called for each of the others.
+        */
+        template <typename Fn>
+        void merge(container_type&& Elements, Fn&& OnExisting) {
+            if (Elements.empty())
+                return;
+
+            std::ranges::stable_sort(Elements, m_Compare, &value_type::first);
+
+            container_type merged;
+            merged.reserve(m_Data.size() + Elements.size());
+
+            auto itThis = m_Data.begin();
+            auto itOther = Elements.begin();
+            while (itThis != m_Data.end() || itOther != Elements.end())
+            {
+                // Take element from the map
+                if (itOther == Elements.end() || (itThis != m_Data.end() && !m_Compare(itOther->first, itThis->first)))
+                {
+                    merged.emplace_back(std::move(*itThis));
+                    ++itThis;
+                    continue;
+                }
+
+                // Take element from Elements
+                if (!merged.empty() && !m_Compare(merged.back().first, itOther->first))
+                    std::invoke(OnExisting, merged.back().second);
+                else
+                    merged.emplace_back(std::move(*itOther));
+                ++itOther;
+            }
+
+            m_Data = std::move(merged);
+        }
+
+        /**
+        * @brief Inserts all Elements, which don't need to be sorted, with one sort and one linear merge. Elements with a key already in the map are not inserted.
+        */
+        void merge(container_type&& Elements) { merge(std::move(Elements), [](Value&) {}); }
+
+        /**
+        * @brief Moves the underlying sorted vector out of the map, leaving it empty.
+        */
+        [[nodiscard]] container_type extract() && {
+            container_type out = std::move(m_Data);
+            m_Data.clear();
+            return out;
+        }
+
+        /**
+        * @brief Replaces the underlying vector with Sorted, which must be sorted by key without duplicate keys.
+        */
+        void replace(container_type&& Sorted) {
+            GRAPE_ASSERT(std::ranges::adjacent_find(Sorted, [&](const value_type& A, const value_type& B) { return !m_Compare(A.first, B.first); }) == Sorted.end());
+            m_Data = std::move(Sorted);
+        }
+
+        /**
+        * @return Iterator following the removed element.
+        */
+        iterator erase(const_iterator It) { return m_Data.erase(It); }
+
+        /**
+        * @brief Removes all elements for which Pred returns true, keeping the order of the remaining elements.
+        * @return The number of elements removed.
+        */
+        template <typename Pred>
+        std::size_t erase_if(Pred&& P) { return std::erase_if(m_Data, std::forward<Pred>(P)); }
+
+    private:
+        container_type m_Data;
+        Compare m_Compare;
+    };
+}
@@ -0,0 +1,346 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GRAPE {
+    class TaskGroup;
+
+    /**
+    * @brief Process wide work stealing thread pool, shared by all jobs.
+    *
+    * Each worker owns a deque of tasks. Tasks submitted from a worker are pushed to its own deque and popped in last in first out order, idle workers steal from the front of the other deques.
+    * Tasks submitted from other threads are pushed to a shared injection queue.
+    * Tasks are always submitted through a TaskGroup, which allows nested fork join: waiting on a group executes the pending tasks of that group instead of blocking the thread.
+    * Each task is also queued in its group and runs exactly once, on whichever thread claims it first.
+    */
+    class ThreadPool {
+    public:
+        /**
+        * @return The pool shared by the whole process, with one worker per hardware thread. Created on first use.
+        */
+        static ThreadPool& get() {
+            static ThreadPool s_Pool(std::max(std::thread::hardware_concurrency(), 1u));
+            return s_Pool;
+        }
+
+        explicit ThreadPool(std::size_t ThreadCount) {
+            m_Workers.reserve(ThreadCount);
+            for (std::size_t i = 0; i < ThreadCount; ++i)
+                m_Workers.emplace_back(std::make_unique<Worker>());
+
+            for (std::size_t i = 0; i < ThreadCount; ++i)
+                m_Workers.at(i)->Thread = std::thread([this, i] { work(i); });
+        }
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+        ~ThreadPool() {
+            {
+                std::scoped_lock lck(m_SleepMutex);
+                m_Stop = true;
+            }
+            m_SleepCondition.notify_all();
+
+            for (const auto& worker : m_Workers)
+                if (worker->Thread.joinable())
+                    worker->Thread.join();
+        }
+
+        [[nodiscard]] std::size_t threadCount() const { return m_Workers.size(); }
+
+        /**
+        * @brief Calls Func(Index) for every index in [0, Count) and waits for all calls to finish.
+        *
+        * The range is split into a few chunks per worker. Can be called from within a task, the calling thread executes only chunks of this call while waiting.
+        */
+        template <typename Function>
+        void parallelFor(std::size_t Count, Function&& Func);
+
+    private:
+        friend class TaskGroup;
+
+        struct Task {
+            Task(std::function<void()>&& FuncIn, TaskGroup& GroupIn) : Func(std::move(FuncIn)), Group(GroupIn) {}
+
+            std::function<void()> Func;
+            TaskGroup& Group;
+            std::atomic_bool Claimed = false;
+        };
+        using TaskPtr = std::shared_ptr<Task>;
+
+        struct Worker {
+            std::deque<TaskPtr> Tasks;
+            std::mutex Mutex;
+            std::thread Thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+
+        std::deque<TaskPtr> m_Injected;
+        std::mutex m_InjectedMutex;
+
+        // Number of tasks in all deques, idle workers sleep while it is 0
+        std::atomic_size_t m_Queued = 0;
+        std::mutex m_SleepMutex;
+        std::condition_variable m_SleepCondition;
+        bool m_Stop = false;
+
+        // Index of the worker running on the current thread in the pool of the current thread
+        inline static thread_local const ThreadPool* t_Pool = nullptr;
+        inline static thread_local std::size_t t_WorkerIndex = 0;
+    private:
+        void submit(const TaskPtr& Tsk) {
+            if (t_Pool == this)
+            {
+                Worker& worker = *m_Workers.at(t_WorkerIndex);
+                std::scoped_lock lck(worker.Mutex);
+                worker.Tasks.push_back(Tsk);
+            }
+            else
+            {
+                std::scoped_lock lck(m_InjectedMutex);
+                m_Injected.push_back(Tsk);
+            }
+
+            ++m_Queued;
+            {
+                // Pairs with the predicate check of sleeping workers, no wake up is lost
+                std::scoped_lock lck(m_SleepMutex);
+            }
+            m_SleepCondition.notify_one();
+        }
+
+        /**
+        * @brief Pops a task from the deque of the current worker, then from the injection queue, then steals from the other workers.
+        */
+        bool tryPop(TaskPtr& Tsk) {
+            const bool isWorker = t_Pool == this;
+            if (isWorker)
+            {
+                Worker& worker = *m_Workers.at(t_WorkerIndex);
+                std::scoped_lock lck(worker.Mutex);
+                if (!worker.Tasks.empty())
+                {
+                    Tsk = std::move(worker.Tasks.back());
+                    worker.Tasks.pop_back();
+                    --m_Queued;
+                    return true;
+                }
+            }
+
+            {
+                std::scoped_lock lck(m_InjectedMutex);
+                if (!m_Injected.empty())
+                {
+                    Tsk = std::move(m_Injected.front());
+                    m_Injected.pop_front();
+                    --m_Queued;
+                    return true;
+                }
+            }
+
+            const std::size_t start = isWorker ? t_WorkerIndex + 1 : 0;
+            for (std::size_t i = 0; i < m_Workers.size(); ++i)
+            {
+                Worker& victim = *m_Workers.at((start + i) % m_Workers.size());
+                std::scoped_lock lck(victim.Mutex);
+                if (!victim.Tasks.empty())
+                {
+                    Tsk = std::move(victim.Tasks.front());
+                    victim.Tasks.pop_front();
+                    --m_Queued;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+        * @brief Pops one pending task and executes it on the calling thread, unless it was already claimed by the thread waiting on its group.
+        * @return False if no task was available.
+        */
+        bool tryRunOne();
+
+        /**
+        * @brief Executes Tsk if no other thread claimed it.
+        */
+        static void execute(Task& Tsk);
+
+        void work(std::size_t WorkerIndex) {
+            t_Pool = this;
+            t_WorkerIndex = WorkerIndex;
+
+            while (true)
+            {
+                if (tryRunOne())
+                    continue;
+
+                std::unique_lock lck(m_SleepMutex);
+                m_SleepCondition.wait(lck, [&] { return m_Stop || m_Queued.load() > 0; });
+                if (m_Stop)
+                    return;
+            }
+        }
+    };
+
+    /**
+    * @brief Set of tasks submitted to a ThreadPool which can be waited on together.
+    *
+    * Tasks may run further groups and wait on them (nested fork join).
+    * A cancelled group skips the tasks which have not yet started and ignores new tasks until reset() is called.
+    */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& Pool = ThreadPool::get()) : m_Pool(Pool) {}
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup(TaskGroup&&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        TaskGroup& operator=(TaskGroup&&) = delete;
+        ~TaskGroup() { wait(); }
+
+        /**
+        * @brief Submits Func to the pool. Ignored if the group is cancelled.
+        */
+        template <typename Function>
+        void run(Function&& Func) {
+            if (m_Cancelled.load())
+                return;
+
+            ++m_Pending;
+            const auto tsk = std::make_shared<ThreadPool::Task>(std::function<void()>(std::forward<Function>(Func)), *this);
+            {
+                std::scoped_lock lck(m_QueueMutex);
+                m_Queue.push_back(tsk);
+            }
+            m_Pool.submit(tsk);
+        }
+
+        /**
+        * @brief Returns once all submitted tasks have finished.
+        * The calling thread executes the tasks of this group which have not started, most recent first, and blocks while the remaining ones run on other threads.
+        * Tasks of other groups never run on the calling thread, which keeps the stack bounded and long tasks off threads waiting for short ones.
+        */
+        void wait() {
+            while (m_Pending.load() > 0)
+            {
+                ThreadPool::TaskPtr tsk;
+                {
+                    std::scoped_lock lck(m_QueueMutex);
+                    if (!m_Queue.empty())
+                    {
+                        tsk = std::move(m_Queue.back());
+                        m_Queue.pop_back();
+                    }
+                }
+
+                if (tsk)
+                {
+                    ThreadPool::execute(*tsk);
+                    continue;
+                }
+
+                // Remaining tasks are running on other threads
+                std::unique_lock lck(m_Mutex);
+                m_Condition.wait(lck, [&] { return m_Pending.load() == 0; });
+            }
+
+            // Tasks claimed by the pool are still referenced by the queue
+            {
+                std::scoped_lock lck(m_QueueMutex);
+                m_Queue.clear();
+            }
+
+            // The last finish() has released the mutex, the group can be safely destroyed
+            std::scoped_lock lck(m_Mutex);
+        }
+
+        /**
+        * @brief Tasks of this group which have not started are skipped. Can be called from any thread.
+        */
+        void cancel() { m_Cancelled.store(true); }
+
+        /**
+        * @brief Clears a previous cancel(). All tasks must have finished.
+        */
+        void reset() { m_Cancelled.store(false); }
+
+        [[nodiscard]] bool cancelled() const { return m_Cancelled.load(); }
+
+    private:
+        friend class ThreadPool;
+
+        ThreadPool& m_Pool;
+        std::atomic_size_t m_Pending = 0;
+        std::atomic_bool m_Cancelled = false;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+
+        // Submitted tasks, the waiting thread runs the ones not yet claimed by the pool
+        std::deque<ThreadPool::TaskPtr> m_Queue;
+        std::mutex m_QueueMutex;
+    private:
+        void finish() {
+            std::scoped_lock lck(m_Mutex);
+            if (--m_Pending == 0)
+                m_Condition.notify_all();
+        }
+    };
+
+    inline bool ThreadPool::tryRunOne() {
+        TaskPtr tsk;
+        if (!tryPop(tsk))
+            return false;
+
+        execute(*tsk);
+        return true;
+    }
+
+    inline void ThreadPool::execute(Task& Tsk) {
+        if (Tsk.Claimed.exchange(true))
+            return;
+
+        if (!Tsk.Group.cancelled())
+            Tsk.Func();
+        Tsk.Func = nullptr; // Releases the captures, the task may still be referenced by a queue
+
+        // Last access to Tsk, the group may be destroyed afterwards
+        Tsk.Group.finish();
+    }
+
+    template <typename Function>
+    void ThreadPool::parallelFor(std::size_t Count, Function&& Func) {
+        if (Count == 0)
+            return;
+
+        const std::size_t chunkCount = std::min(Count, 4 * threadCount());
+        const std::size_t chunkSize = (Count + chunkCount - 1) / chunkCount;
+
+        TaskGroup group(*this);
+        for (std::size_t begin = chunkSize; begin < Count; begin += chunkSize)
+        {
+            group.run([&Func, begin, end = std::min(begin + chunkSize, Count)] {
+                for (std::size_t i = begin; i < end; ++i)
+                    Func(i);
+                });
+        }
+
+        // First chunk on the calling thread
+        for (std::size_t i = 0; i < std::min(chunkSize, Count); ++i)
+            Func(i);
+
+        group.wait();
+    }
+}
@@ -10,6 +10,11 @@ namespace GRAPE {
     public:
         Blob() = default;
 
+        /**
+        * @brief Reserves Size bytes.
+        */
+        void reserve(std::size_t Size) { m_Bytes.reserve(Size); }
+
         /**
         * @return The number of bytes in the vector.
         */
@@ -32,6 +37,16 @@ namespace GRAPE {
             m_Pos += 4;
         }
 
+        /**
+        * @brief Adds exactly 4 bytes to the vector.
+        * @param Value The 4 bytes to be added represented as a float with the system endianness.
+        */
+        void add(float Value) {
+            m_Bytes.resize(size() + 4, std::byte{ 0 });
+            std::memcpy(endPointer(), &Value, 4);
+            m_Pos += 4;
+        }
+
         /**
         * @brief Adds exactly 8 bytes to the vector.
         * @param Value The 8 bytes to be added represented as a double with the system endianness.
@@ -16,10 +16,18 @@ namespace GRAPE {
 
     int Column::getInt() const noexcept { return sqlite3_column_int(m_Stmt, m_Index); }
 
+    std::int64_t Column::getInt64() const noexcept { return sqlite3_column_int64(m_Stmt, m_Index); }
+
     double Column::getDouble() const noexcept { return sqlite3_column_double(m_Stmt, m_Index); }
 
     std::string Column::getString() const noexcept {
         const auto strPtr = reinterpret_cast<const char*>(sqlite3_column_text(m_Stmt, m_Index));
         return strPtr ? strPtr : "";
     }
+
+    std::span<const std::byte> Column::getBlob() const noexcept {
+        const auto blobPtr = static_cast<const std::byte*>(sqlite3_column_blob(m_Stmt, m_Index));
+        const auto blobSize = static_cast<std::size_t>(sqlite3_column_bytes(m_Stmt, m_Index));
+        return blobPtr ? std::span<const std::byte>(blobPtr, blobSize) : std::span<const std::byte>();
+    }
 }
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <span>
+
 // Avoid including sqlite3.h in header file
 struct sqlite3_stmt;
 
@@ -25,6 +27,11 @@ namespace GRAPE {
         */
         [[nodiscard]] int getInt() const noexcept;
 
+        /**
+        * @brief Call sqlite3_column_int64, performs the sqlite conversions. Used for rowids.
+        */
+        [[nodiscard]] std::int64_t getInt64() const noexcept;
+
         /**
         * @brief Call sqlite3_column_double, performs the sqlite conversions.
         */
@@ -36,6 +43,18 @@ namespace GRAPE {
         */
         [[nodiscard]] std::string getString() const noexcept;
 
+        /**
+        * @brief Call sqlite3_column_blob, the bytes are not copied.
+        * @return View of the blob bytes, valid until the statement is stepped, reset or destroyed. Empty if null.
+        */
+        [[nodiscard]] std::span<const std::byte> getBlob() const noexcept;
+
+        /**
+        * @brief Call sqlite3_column_int and casts the integer code to Enum.
+        */
+        template <typename Enum> requires std::is_enum_v<Enum>
+        [[nodiscard]] Enum getEnum() const noexcept { return static_cast<Enum>(getInt()); }
+
         /**
         * @brief Enables implicit conversion to int.
         */
@@ -17,8 +17,8 @@ namespace GRAPE {
     Database::Database(const Database& Other) {
         m_FilePath = Other.m_FilePath;
 
-        if (Other.m_File)
-            open(m_FilePath);
+        if (Other.m_File && open(m_FilePath))
+            shareConnections(Other);
     }
 
     Database& Database::operator=(const Database& Other) {
@@ -27,12 +27,22 @@ namespace GRAPE {
 
         m_FilePath = Other.m_FilePath;
 
-        if (Other.m_File)
-            open(m_FilePath);
+        if (Other.m_File && open(m_FilePath))
+            shareConnections(Other);
 
         return *this;
     }
 
+    Database::Reader::Reader(std::shared_ptr<Connections> Pool, std::unique_ptr<Database> Connection) : m_Pool(std::move(Pool)), m_Connection(std::move(Connection)) {}
+
+    Database::Reader::~Reader() {
+        {
+            std::scoped_lock lck(m_Pool->Mutex);
+            m_Pool->Idle.emplace_back(std::move(m_Connection));
+        }
+        m_Pool->Available.notify_all(); // attach() and detach() may be waiting for all readers
+    }
+
     bool Database::open(const std::filesystem::path& FilePath) {
         GRAPE_ASSERT(!valid(), "Database already opened!");
 
@@ -60,7 +70,11 @@ namespace GRAPE {
         }
 
         execute("PRAGMA foreign_keys = ON");
-        execute("PRAGMA busy_timeout = 10");
+        sqlite3_busy_timeout(m_File, std::max(s_BusyTimeout, 0));
+        setSchemaPragmas("main");
+
+        m_Connections = std::make_shared<Connections>(m_FilePath);
+        m_Connections->Copies.emplace_back(this);
         return true;
     }
 
@@ -111,6 +125,13 @@ namespace GRAPE {
     }
 
     void Database::close() {
+        if (m_Connections)
+        {
+            std::scoped_lock lck(m_Connections->Mutex);
+            std::erase(m_Connections->Copies, this);
+        }
+        m_Connections.reset();
+        clearStatementCache();
         sqlite3_close(m_File);
         m_File = nullptr;
     }
@@ -168,6 +189,61 @@ namespace GRAPE {
             Log::database()->info("Successfully cleaned the study.");
     }
 
+    std::size_t Database::statementCacheHits() const {
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        return m_StatementCache.Hits;
+    }
+
+    std::size_t Database::statementCacheMisses() const {
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        return m_StatementCache.Misses;
+    }
+
+    void Database::clearStatementCache() const {
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        m_StatementCache.Index.clear();
+        m_StatementCache.Statements.clear();
+    }
+
+    void Database::setSchemaPragmas(const std::string& SchemaName) const {
+        // Fails if another connection is open and the journal mode is not the requested one, the current mode is kept
+        if (const int errJournal = sqlite3_exec(m_File, std::format("PRAGMA {}.journal_mode = {}", SchemaName, s_WriteAheadLog ? "WAL" : "DELETE").c_str(), nullptr, nullptr, nullptr))
+            Log::database()->warn("Setting the journal mode of '{}'. SQLite error: '{}'.", sqlite3_db_filename(m_File, SchemaName.c_str()), sqlite3_errstr(errJournal));
+        execute(std::format("PRAGMA {}.synchronous = {}", SchemaName, s_WriteAheadLog ? "NORMAL" : "FULL"));
+        execute(std::format("PRAGMA {}.mmap_size = {}", SchemaName, static_cast<std::int64_t>(std::max(s_MmapSize, 0)) * 1024 * 1024));
+    }
+
+    bool Database::attachConnection(const std::filesystem::path& FilePath, const std::string& SchemaName) const {
+        std::string filePathStr = FilePath.string();
+        for (auto pos = filePathStr.find('\''); pos != std::string::npos; pos = filePathStr.find('\'', pos + 2))
+            filePathStr.insert(pos, 1, '\'');
+
+        if (const int errAttach = sqlite3_exec(m_File, std::format("ATTACH DATABASE '{}' AS {}", filePathStr, SchemaName).c_str(), nullptr, nullptr, nullptr))
+        {
+            Log::database()->error("SQLite error attaching file '{}': '{}'.", FilePath.string(), sqlite3_errstr(errAttach));
+            return false;
+        }
+
+        setSchemaPragmas(SchemaName);
+        return true;
+    }
+
+    void Database::shareConnections(const Database& Other) {
+        std::erase(m_Connections->Copies, this);
+        m_Connections = Other.m_Connections;
+
+        std::scoped_lock lck(m_Connections->Mutex);
+        for (const auto& [schemaName, filePath] : m_Connections->Attached)
+            attachConnection(filePath, schemaName);
+        m_Connections->Copies.emplace_back(this);
+    }
+
+    void Database::closeReaders(Connections& Pool, std::unique_lock<std::mutex>& Lock) {
+        Pool.Available.wait(Lock, [&] { return Pool.Idle.size() == Pool.Open; });
+        Pool.Idle.clear();
+        Pool.Open = 0;
+    }
+
     std::string Database::name() const { return path().stem().string(); }
 
     int Database::applicationId() const {
@@ -186,40 +262,159 @@ namespace GRAPE {
         return stmt.getColumn(0);
     }
 
-    void Database::beginTransaction() const {
+    Database::Reader Database::reader() const {
         GRAPE_ASSERT(valid());
 
-        const int err = sqlite3_exec(m_File, "BEGIN IMMEDIATE TRANSACTION", nullptr, nullptr, nullptr);
+        auto& pool = *m_Connections;
+        std::unique_lock lck(pool.Mutex);
+        const auto capacity = static_cast<std::size_t>(std::max(s_ReaderConnections, 1));
+        pool.Available.wait(lck, [&] { return !pool.Idle.empty() || pool.Open < capacity; });
 
-        if (err == SQLITE_OK)
-            return;
+        if (!pool.Idle.empty())
+        {
+            auto connection = std::move(pool.Idle.back());
+            pool.Idle.pop_back();
+            return Reader(m_Connections, std::move(connection));
+        }
 
-        if (err == SQLITE_BUSY)
+        // Open outside the lock, other readers may be given back meanwhile
+        ++pool.Open;
+        lck.unlock();
+        auto connection = std::make_unique<Database>(pool.FilePath);
+        GRAPE_ASSERT(connection->valid());
+        connection->m_Connections.reset();
+
+        // Attached before setting query only, closeReaders() waits for this connection if the attached databases change meanwhile
+        lck.lock();
+        const auto attached = pool.Attached;
+        lck.unlock();
+        for (const auto& [schemaName, filePath] : attached)
+            connection->attachConnection(filePath, schemaName);
+
+        connection->execute("PRAGMA query_only = ON");
+        return Reader(m_Connections, std::move(connection));
+    }
+
+    bool Database::attach(const std::filesystem::path& FilePath, const std::string& SchemaName) const {
+        GRAPE_ASSERT(valid());
+
+        auto& pool = *m_Connections;
+        std::unique_lock lck(pool.Mutex);
+        closeReaders(pool, lck);
+
+        bool success = true;
+        for (const auto copy : pool.Copies)
+            success &= copy->attachConnection(FilePath, SchemaName);
+
+        if (!success)
         {
-            GRAPE_DEBUG_INFO("Beginning transaction, database was BUSY. Trying again...");
-            beginTransaction();
-            return;
+            for (const auto copy : pool.Copies)
+                sqlite3_exec(copy->m_File, std::format("DETACH DATABASE {}", SchemaName).c_str(), nullptr, nullptr, nullptr);
+            return false;
         }
 
-        GRAPE_ASSERT(false, "SQLite error beginning transaction: '{2}'.", sqlite3_errstr(err));
+        pool.Attached.emplace_back(SchemaName, FilePath);
+        return true;
     }
 
-    void Database::commitTransaction() const {
+    void Database::detach(const std::string& SchemaName) const {
         GRAPE_ASSERT(valid());
 
-        const int err = sqlite3_exec(m_File, "COMMIT TRANSACTION", nullptr, nullptr, nullptr);
+        auto& pool = *m_Connections;
+        std::unique_lock lck(pool.Mutex);
+        closeReaders(pool, lck);
 
-        if (err == SQLITE_OK)
-            return;
+        // Cached statements may be using the attached database
+        for (const auto copy : pool.Copies)
+        {
+            copy->clearStatementCache();
+            copy->execute(std::format("DETACH DATABASE {}", SchemaName));
+        }
+
+        std::erase_if(pool.Attached, [&](const auto& Attached) { return Attached.first == SchemaName; });
+    }
+
+    bool Database::recreateAttached(const std::string& SchemaName) const {
+        GRAPE_ASSERT(valid());
+
+        std::filesystem::path filePath;
+        {
+            std::scoped_lock lck(m_Connections->Mutex);
+            const auto it = std::ranges::find(m_Connections->Attached, SchemaName, &std::pair<std::string, std::filesystem::path>::first);
+            GRAPE_ASSERT(it != m_Connections->Attached.end());
+            filePath = it->second;
+        }
+
+        // Schema of the current database, the automatic indexes have no sql
+        std::string createSql;
+        {
+            Statement stmt(*this, std::format("SELECT sql FROM {}.sqlite_schema WHERE sql IS NOT NULL", SchemaName));
+            stmt.step();
+            while (stmt.hasRow())
+            {
+                createSql.append(stmt.getColumn(0).getString()).append(";\n");
+                stmt.step();
+            }
+        }
+        for (const auto pragma : { "application_id", "user_version" })
+        {
+            Statement stmt(*this, std::format("PRAGMA {}.{}", SchemaName, pragma));
+            stmt.step();
+            createSql.append(std::format("PRAGMA {} = {};\n", pragma, stmt.getColumn(0).getInt()));
+        }
+
+        detach(SchemaName);
+
+        for (const auto& suffix : { "", "-wal", "-shm" })
+        {
+            std::error_code err;
+            std::filesystem::remove(std::filesystem::path(filePath).concat(suffix), err);
+            if (err)
+            {
+                Log::database()->error("Deleting file '{}': '{}'.", filePath.string(), err.message());
+                return false;
+            }
+        }
 
-        if (err == SQLITE_BUSY)
         {
-            GRAPE_DEBUG_INFO("Committing transaction, database was BUSY. Trying again...");
-            commitTransaction();
-            return;
+            Database newDb;
+            if (!newDb.create(filePath, createSql.c_str()))
+                return false;
         }
 
-        GRAPE_ASSERT(false, "SQLite error committing transaction: '{2}'.", sqlite3_errstr(err));
+        return attach(filePath, SchemaName);
+    }
+
+    void Database::beginTransaction() const {
+        GRAPE_ASSERT(valid());
+
+        // The busy timeout expired, e.g. a long transaction of another connection to the same file
+        int err = sqlite3_exec(m_File, "BEGIN IMMEDIATE TRANSACTION", nullptr, nullptr, nullptr);
+        while ((err & 0xFF) == SQLITE_BUSY)
+        {
+            Log::database()->warn("Beginning transaction on '{}', database was busy. Trying again...", m_FilePath.string());
+            err = sqlite3_exec(m_File, "BEGIN IMMEDIATE TRANSACTION", nullptr, nullptr, nullptr);
+        }
+
+        if (err != SQLITE_OK)
+            Log::database()->error("SQLite error beginning transaction on '{}': '{}'.", m_FilePath.string(), sqlite3_errstr(err));
+        GRAPE_ASSERT(err == SQLITE_OK, "SQLite error beginning transaction: '{2}'.", sqlite3_errstr(err));
+    }
+
+    void Database::commitTransaction() const {
+        GRAPE_ASSERT(valid());
+
+        // The transaction stays open while the commit is busy, it can be retried
+        int err = sqlite3_exec(m_File, "COMMIT TRANSACTION", nullptr, nullptr, nullptr);
+        while ((err & 0xFF) == SQLITE_BUSY)
+        {
+            Log::database()->warn("Committing transaction on '{}', database was busy. Trying again...", m_FilePath.string());
+            err = sqlite3_exec(m_File, "COMMIT TRANSACTION", nullptr, nullptr, nullptr);
+        }
+
+        if (err != SQLITE_OK)
+            Log::database()->error("SQLite error committing transaction on '{}': '{}'.", m_FilePath.string(), sqlite3_errstr(err));
+        GRAPE_ASSERT(err == SQLITE_OK, "SQLite error committing transaction: '{2}'.", sqlite3_errstr(err));
     }
 
     void Database::execute(const std::string& Query) const {
@@ -229,6 +424,12 @@ namespace GRAPE {
         GRAPE_ASSERT(errExec == SQLITE_OK, "SQLite error executing statement: '{2}'", sqlite3_errstr(errExec));
     }
 
+    std::int64_t Database::lastInsertRowId() const {
+        GRAPE_ASSERT(valid());
+
+        return sqlite3_last_insert_rowid(m_File);
+    }
+
     void Database::setApplicationId(int Id) const {
         execute(std::format("PRAGMA application_id = {}", Id));
     }
@@ -2,6 +2,11 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+
 #include "Column.h"
 #include "Statement.h"
 #include "Table.h"
@@ -12,6 +17,7 @@ struct sqlite3;
 namespace GRAPE {
     class Database {
         friend class Statement; // Access to sqlite3*
+        struct Connections;
     public:
         /**
         * @brief Default constructor, invalid state after construction.
@@ -29,19 +35,40 @@ namespace GRAPE {
         Database(const std::filesystem::path& FilePath, const std::uint8_t* Buffer, int BufferSize);
 
         /**
-        * @brief Opens a new connection to the same file.
+        * @brief Opens a new connection to the same file, sharing the reader connections and the attached databases of Other.
         */
         Database(const Database& Other);
         Database(Database&&) = delete;
 
         /**
-        * @brief Opens a new connection to the same file.
+        * @brief Opens a new connection to the same file, sharing the reader connections and the attached databases of Other.
         */
         Database& operator=(const Database&);
         Database& operator=(Database&&) = delete;
 
         ~Database() { close(); }
 
+        /**
+        * @brief Query only connection on loan from the reader connections of a database, given back on destruction.
+        */
+        class Reader {
+        public:
+            Reader(const Reader&) = delete;
+            Reader(Reader&&) = delete;
+            Reader& operator=(const Reader&) = delete;
+            Reader& operator=(Reader&&) = delete;
+            ~Reader();
+
+            [[nodiscard]] const Database& operator*() const { return *m_Connection; }
+            [[nodiscard]] const Database* operator->() const { return m_Connection.get(); }
+        private:
+            friend class Database;
+            Reader(std::shared_ptr<Connections> Pool, std::unique_ptr<Database> Connection);
+
+            std::shared_ptr<Connections> m_Pool;
+            std::unique_ptr<Database> m_Connection;
+        };
+
         /**
         * @brief May be called only once per class instance lifetime. Open sqlite3 database at FilePath.
         * ASSERT !valid()
@@ -109,17 +136,52 @@ namespace GRAPE {
         */
         [[nodiscard]] int userVersion() const;
 
+        /**
+        * @brief Blocks until one of the reader connections is available, opening a new one while less than s_ReaderConnections are open.
+        * The reader connections are shared by all copies of this database. In write-ahead log mode, statements executed on a reader see the last committed state and don't block nor are blocked by writers.
+        * ASSERT valid().
+        */
+        [[nodiscard]] Reader reader() const;
+
+        /**
+        * @brief Attaches the database at FilePath as SchemaName to this connection, to all its copies and to the reader connections. Copies and reader connections opened afterwards also attach it.
+        * Tables of attached databases are found by their unqualified names if no table with the same name exists in the main database.
+        * Blocks until all reader connections are given back. No transaction may be open in any of the connections.
+        * ASSERT valid().
+        *
+        * @return True on success.
+        */
+        bool attach(const std::filesystem::path& FilePath, const std::string& SchemaName) const;
+
+        /**
+        * @brief Detaches SchemaName from this connection, from all its copies and from the reader connections.
+        * Blocks until all reader connections are given back. No transaction may be open in any of the connections.
+        * ASSERT valid().
+        */
+        void detach(const std::string& SchemaName) const;
+
+        /**
+        * @brief Replaces the database attached as SchemaName by an empty database with the same schema, application ID and user version. The file of the previous database is deleted.
+        * Same requirements as detach().
+        * ASSERT valid().
+        *
+        * @return True on success.
+        */
+        bool recreateAttached(const std::string& SchemaName) const;
+
         /**
         * @brief Start an immediate transaction to the database, blocks any other threads from starting a transaction.
+        * Retried while the database is busy after s_BusyTimeout.
         * ASSERT valid().
-        * ASSERT result either SQLITE_OK or SQLITE_BUSY.
+        * ASSERT result is SQLITE_OK.
         */
         void beginTransaction() const;
 
         /**
         * @brief Commit the transaction to the database, blocks any other threads from starting a transaction.
+        * Retried while the database is busy after s_BusyTimeout.
         * ASSERT valid().
-        * ASSERT result either SQLITE_OK or SQLITE_BUSY.
+        * ASSERT result is SQLITE_OK.
         */
         void commitTransaction() const;
 
@@ -130,6 +192,12 @@ namespace GRAPE {
         */
         void execute(const std::string& Query) const;
 
+        /**
+        * @return The rowid of the last row inserted by this connection, 0 if no row was inserted.
+        * ASSERT valid().
+        */
+        [[nodiscard]] std::int64_t lastInsertRowId() const;
+
         /**
         * @brief Set the SQLite application ID to ID.
         */
@@ -148,6 +216,21 @@ namespace GRAPE {
         template <std::size_t Size, typename... Types>
         void insert(const Table<Size>& Tbl, std::initializer_list<std::size_t> InsertVars, const std::tuple<Types...>& Vals) const;
 
+        /**
+        * @brief Insert each tuple in Rows into Tbl, preparing a single statement for all rows.
+        * If InsertVars is empty: ASSERT Table Size = Number of values in each tuple.
+        * If InsertVars not empty: ASSERT InsertVars Size = Number of values in each tuple.
+        */
+        template <std::size_t Size, std::ranges::input_range Range>
+        void insertBulk(const Table<Size>& Tbl, std::initializer_list<std::size_t> InsertVars, const Range& Rows) const;
+
+        /**
+        * @brief Insert each tuple in Rows into Tbl as insertBulk, the statement returns the rowid of each inserted row.
+        * @return The rowids of the inserted rows, in the same order as Rows.
+        */
+        template <std::size_t Size, std::ranges::input_range Range>
+        [[nodiscard]] std::vector<std::int64_t> insertBulkReturningIds(const Table<Size>& Tbl, std::initializer_list<std::size_t> InsertVars, const Range& Rows) const;
+
         /**
         * @brief Update values in Tbl
         * ASSERT SetVars size = number of Vals and FilterVars size = number of FilterVals.
@@ -169,31 +252,209 @@ namespace GRAPE {
         template <std::size_t Size, typename... Types>
         void deleteD(const Table<Size>& Tbl, std::initializer_list<std::size_t> FilterVars, const std::tuple<Types...>& FilterVals) const;
 
+        /**
+        * @brief Delete the values of Tbl matching each tuple in Rows, preparing a single statement for all rows.
+        * ASSERT FilterVars size = number of values in each tuple.
+        */
+        template <std::size_t Size, std::ranges::input_range Range>
+        void deleteBulk(const Table<Size>& Tbl, std::initializer_list<std::size_t> FilterVars, const Range& Rows) const;
+
         /**
         * @brief Delete all values from Tbl.
         */
         template <std::size_t Size>
         void deleteD(const Table<Size>& Tbl) const;
+
+        /**
+        * @brief Maximum number of prepared statements kept by each connection for the insert, update and delete functions.
+        */
+        inline static std::size_t s_StatementCacheCapacity = 64;
+
+        /**
+        * @brief Use the write-ahead log journal mode with synchronous set to NORMAL. Otherwise the rollback journal is used with synchronous set to FULL.
+        * The journal mode is stored in the file, it can only be changed if no other connection to the file is open.
+        */
+        inline static bool s_WriteAheadLog = true;
+
+        /**
+        * @brief Maximum size in MiB of the database file mapped in memory by each connection. 0 disables memory mapped I/O.
+        */
+        inline static int s_MmapSize = 256;
+
+        /**
+        * @brief Maximum number of reader connections open to a database file.
+        */
+        inline static int s_ReaderConnections = 8;
+
+        /**
+        * @brief Time in milliseconds a connection waits for the locks held by other connections to the same file before a statement fails with SQLITE_BUSY.
+        */
+        inline static int s_BusyTimeout = 5000;
+
+        /**
+        * @return The number of insert, update and delete calls which reused a cached prepared statement.
+        */
+        [[nodiscard]] std::size_t statementCacheHits() const;
+
+        /**
+        * @return The number of insert, update and delete calls which had to prepare a new statement.
+        */
+        [[nodiscard]] std::size_t statementCacheMisses() const;
     private:
         sqlite3* m_File = nullptr;
         std::filesystem::path m_FilePath;
+
+        /**
+        * @brief Shared by all copies of a database.
+        * Reader connections are created on demand and closed when the last copy of the database and the last Reader are destroyed, or when the attached databases change.
+        */
+        struct Connections {
+            explicit Connections(std::filesystem::path FilePathIn) : FilePath(std::move(FilePathIn)) {}
+            std::filesystem::path FilePath;
+            std::vector<const Database*> Copies;
+            std::vector<std::pair<std::string, std::filesystem::path>> Attached; // Schema name and file path
+            std::vector<std::unique_ptr<Database>> Idle;
+            std::size_t Open = 0;
+            std::mutex Mutex;
+            std::condition_variable Available;
+        };
+        std::shared_ptr<Connections> m_Connections;
+
+        /**
+        * @brief Identifies a statement built from a Table query function. The filter variables of update queries are stored after a separator.
+        */
+        struct StatementKey {
+            enum class Kind { Insert, InsertReturningId, Update, Delete } QueryKind;
+            std::string_view TableName;
+            std::vector<std::size_t> Variables;
+
+            auto operator<=>(const StatementKey&) const = default;
+        };
+
+        /**
+        * @brief Least recently used cache of prepared statements. The front of the list is the most recently used statement.
+        */
+        struct StatementCache {
+            std::list<std::pair<StatementKey, std::unique_ptr<Statement>>> Statements;
+            std::map<StatementKey, decltype(Statements)::iterator> Index;
+            std::size_t Hits = 0;
+            std::size_t Misses = 0;
+            std::mutex Mutex;
+        };
+        mutable StatementCache m_StatementCache;
+
+        /**
+        * @brief Must be called with the statement cache mutex locked.
+        * @return The cached statement for Key, reset and with its bindings cleared, or a new statement prepared with the query returned by MakeQuery.
+        */
+        template <typename QueryFunction>
+        Statement& cachedStatement(StatementKey&& Key, QueryFunction MakeQuery) const;
+
+        /**
+        * @brief Finalizes all cached statements.
+        */
+        void clearStatementCache() const;
+
+        /**
+        * @brief Sets the journal mode, synchronous and memory map pragmas of the database SchemaName of this connection.
+        */
+        void setSchemaPragmas(const std::string& SchemaName) const;
+
+        /**
+        * @brief Attaches FilePath as SchemaName to this connection only.
+        * @return True on success.
+        */
+        bool attachConnection(const std::filesystem::path& FilePath, const std::string& SchemaName) const;
+
+        /**
+        * @brief Shares the reader connections and the attached databases of Other with this connection.
+        */
+        void shareConnections(const Database& Other);
+
+        /**
+        * @brief Must be called with the mutex of Pool locked. Waits until all reader connections are given back and closes them.
+        */
+        static void closeReaders(Connections& Pool, std::unique_lock<std::mutex>& Lock);
     };
 
+    template <typename QueryFunction>
+    Statement& Database::cachedStatement(StatementKey&& Key, QueryFunction MakeQuery) const {
+        auto& cache = m_StatementCache;
+
+        if (const auto it = cache.Index.find(Key); it != cache.Index.end())
+        {
+            ++cache.Hits;
+            cache.Statements.splice(cache.Statements.begin(), cache.Statements, it->second);
+            Statement& stmt = *it->second->second;
+            stmt.reset();
+            stmt.clearBindings();
+            return stmt;
+        }
+
+        ++cache.Misses;
+        if (cache.Statements.size() >= s_StatementCacheCapacity && !cache.Statements.empty())
+        {
+            cache.Index.erase(cache.Statements.back().first);
+            cache.Statements.pop_back();
+        }
+
+        cache.Statements.emplace_front(Key, std::make_unique<Statement>(*this, MakeQuery()));
+        cache.Index.emplace(std::move(Key), cache.Statements.begin());
+        return *cache.Statements.front().second;
+    }
+
     template <std::size_t Size, typename... Types>
     void Database::insert(const Table<Size>& Tbl, std::initializer_list<std::size_t> InsertVars, const std::tuple<Types...>& Vals) const {
         GRAPE_ASSERT(InsertVars.size() == 0 ? Size == sizeof...(Types) : InsertVars.size() == sizeof...(Types));
 
-        Statement stmt(*this, Tbl.queryInsert(InsertVars));
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        Statement& stmt = cachedStatement({ StatementKey::Kind::Insert, Tbl.name(), InsertVars }, [&] { return Tbl.queryInsert(InsertVars); });
         stmt.bindValues(Vals);
         stmt.step();
     }
 
+    template <std::size_t Size, std::ranges::input_range Range>
+    void Database::insertBulk(const Table<Size>& Tbl, std::initializer_list<std::size_t> InsertVars, const Range& Rows) const {
+        GRAPE_ASSERT(InsertVars.size() == 0 ? Size == std::tuple_size_v<std::ranges::range_value_t<Range>> : InsertVars.size() == std::tuple_size_v<std::ranges::range_value_t<Range>>);
+
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        Statement& stmt = cachedStatement({ StatementKey::Kind::Insert, Tbl.name(), InsertVars }, [&] { return Tbl.queryInsert(InsertVars); });
+        for (const auto& row : Rows)
+            stmt.stepValues(row);
+    }
+
+    template <std::size_t Size, std::ranges::input_range Range>
+    std::vector<std::int64_t> Database::insertBulkReturningIds(const Table<Size>& Tbl, std::initializer_list<std::size_t> InsertVars, const Range& Rows) const {
+        GRAPE_ASSERT(InsertVars.size() == 0 ? Size == std::tuple_size_v<std::ranges::range_value_t<Range>> : InsertVars.size() == std::tuple_size_v<std::ranges::range_value_t<Range>>);
+
+        std::vector<std::int64_t> ids;
+        if constexpr (std::ranges::sized_range<Range>)
+            ids.reserve(std::ranges::size(Rows));
+
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        Statement& stmt = cachedStatement({ StatementKey::Kind::InsertReturningId, Tbl.name(), InsertVars }, [&] { return Tbl.queryInsert(InsertVars).append(" RETURNING rowid"); });
+        for (const auto& row : Rows)
+        {
+            stmt.bindValues(row);
+            stmt.step();
+            GRAPE_ASSERT(stmt.hasRow());
+            ids.emplace_back(stmt.getColumn(0).getInt64());
+            stmt.reset();
+        }
+        return ids;
+    }
+
     template <std::size_t Size, typename... SetTypes, typename... FilterTypes>
     void Database::update(const Table<Size>& Tbl, std::initializer_list<std::size_t> SetVars, const std::tuple<SetTypes...>& Vals, std::initializer_list<std::size_t> FilterVars, const std::tuple<FilterTypes...>& FilterVals) const {
         GRAPE_ASSERT(SetVars.size() == sizeof...(SetTypes));
         GRAPE_ASSERT(FilterVars.size() == sizeof...(FilterTypes));
 
-        Statement stmt(*this, Tbl.queryUpdate(SetVars, FilterVars));
+        std::vector<std::size_t> keyVars(SetVars);
+        keyVars.emplace_back(Size);
+        keyVars.insert(keyVars.end(), FilterVars);
+
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        Statement& stmt = cachedStatement({ StatementKey::Kind::Update, Tbl.name(), std::move(keyVars) }, [&] { return Tbl.queryUpdate(SetVars, FilterVars); });
         stmt.bindValues(Vals);
         stmt.bindValues<sizeof...(SetTypes)>(FilterVals);
         stmt.step();
@@ -204,7 +465,11 @@ namespace GRAPE {
         GRAPE_ASSERT(Size == sizeof...(SetTypes));
         GRAPE_ASSERT(FilterVars.size() == sizeof...(FilterTypes));
 
-        Statement stmt(*this, Tbl.queryUpdate({}, FilterVars));
+        std::vector<std::size_t> keyVars{ Size };
+        keyVars.insert(keyVars.end(), FilterVars);
+
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        Statement& stmt = cachedStatement({ StatementKey::Kind::Update, Tbl.name(), std::move(keyVars) }, [&] { return Tbl.queryUpdate({}, FilterVars); });
         stmt.bindValues(Vals);
         stmt.bindValues<Size>(FilterVals);
         stmt.step();
@@ -214,14 +479,26 @@ namespace GRAPE {
     void Database::deleteD(const Table<Size>& Tbl, std::initializer_list<std::size_t> FilterVars, const std::tuple<Types...>& FilterVals) const {
         GRAPE_ASSERT(FilterVars.size() == sizeof...(Types));
 
-        Statement stmt(*this, Tbl.queryDelete(FilterVars));
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        Statement& stmt = cachedStatement({ StatementKey::Kind::Delete, Tbl.name(), FilterVars }, [&] { return Tbl.queryDelete(FilterVars); });
         stmt.bindValues(FilterVals);
         stmt.step();
     }
 
+    template <std::size_t Size, std::ranges::input_range Range>
+    void Database::deleteBulk(const Table<Size>& Tbl, std::initializer_list<std::size_t> FilterVars, const Range& Rows) const {
+        GRAPE_ASSERT(FilterVars.size() == std::tuple_size_v<std::ranges::range_value_t<Range>>);
+
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        Statement& stmt = cachedStatement({ StatementKey::Kind::Delete, Tbl.name(), FilterVars }, [&] { return Tbl.queryDelete(FilterVars); });
+        for (const auto& row : Rows)
+            stmt.stepValues(row);
+    }
+
     template <std::size_t Size>
     void Database::deleteD(const Table<Size>& Tbl) const {
-        Statement stmt(*this, Tbl.queryDelete());
+        std::scoped_lock lck(m_StatementCache.Mutex);
+        Statement& stmt = cachedStatement({ StatementKey::Kind::Delete, Tbl.name(), {} }, [&] { return Tbl.queryDelete(); });
         stmt.step();
     }
 }
@@ -38,6 +38,13 @@ namespace GRAPE {
         GRAPE_ASSERT(err == SQLITE_OK, "SQLite error binding value: '{2}'", sqlite3_errstr(err));
     }
 
+    void Statement::bind(int Index, std::int64_t Value) const noexcept {
+        GRAPE_ASSERT(Index <= sqlite3_bind_parameter_count(m_Stmt));
+
+        const int err = sqlite3_bind_int64(m_Stmt, Index + 1, Value);
+        GRAPE_ASSERT(err == SQLITE_OK, "SQLite error binding value: '{2}'", sqlite3_errstr(err));
+    }
+
     void Statement::bind(int Index, double Value) const noexcept {
         GRAPE_ASSERT(Index <= sqlite3_bind_parameter_count(m_Stmt));
 
@@ -67,7 +74,14 @@ namespace GRAPE {
     }
 
     void Statement::step() noexcept {
-        const int err = sqlite3_step(m_Stmt);
+        int err = sqlite3_step(m_Stmt);
+
+        // Busy timeout expired outside of a transaction, the statement can be retried
+        while ((err & 0xFF) == SQLITE_BUSY && sqlite3_get_autocommit(sqlite3_db_handle(m_Stmt)))
+        {
+            Log::database()->warn("Stepping statement, database was busy. Trying again...");
+            err = sqlite3_step(m_Stmt);
+        }
 
         if (err == SQLITE_ROW) { m_HasRow = true; }
         else if (err == SQLITE_DONE)
@@ -75,7 +89,11 @@ namespace GRAPE {
             m_HasRow = false;
             m_Done = true;
         }
-        else { GRAPE_ASSERT(false, "SQLite error stepping statement: '{2}'", sqlite3_errstr(err)); }
+        else
+        {
+            Log::database()->error("SQLite error stepping statement '{}': '{}'.", sqlite3_sql(m_Stmt), sqlite3_errstr(err));
+            GRAPE_ASSERT(false, "SQLite error stepping statement: '{2}'", sqlite3_errstr(err));
+        }
     }
 
     void Statement::reset() noexcept {
@@ -86,6 +104,11 @@ namespace GRAPE {
         GRAPE_ASSERT(err == SQLITE_OK, "SQLite error reseting value: '{2}'", sqlite3_errstr(err));
     }
 
+    void Statement::clearBindings() noexcept {
+        const int err = sqlite3_clear_bindings(m_Stmt);
+        GRAPE_ASSERT(err == SQLITE_OK, "SQLite error clearing bindings: '{2}'", sqlite3_errstr(err));
+    }
+
     Column Statement::getColumn(int Index) const noexcept {
         GRAPE_ASSERT(m_HasRow);
         GRAPE_ASSERT(Index < m_ColumnCount);
@@ -48,6 +48,11 @@ namespace GRAPE {
         */
         void bind(int Index, int Value) const noexcept;
 
+        /**
+        * @brief ASSERT that Index is smaller that sqlite3_column_count value after parsing string in the constructor.
+        */
+        void bind(int Index, std::int64_t Value) const noexcept;
+
         /**
         * @brief ASSERT that Index is smaller that sqlite3_column_count value after parsing string in the constructor.
         */
@@ -68,9 +73,21 @@ namespace GRAPE {
         */
         void bind(int Index, const std::string& Value) const noexcept;
 
+        /**
+        * @brief Binds the underlying value of the enum, stored as an integer code.
+        * ASSERT that Index is smaller that sqlite3_column_count value after parsing string in the constructor.
+        */
+        template <typename Enum> requires std::is_enum_v<Enum>
+        void bind(int Index, Enum Value) const noexcept { bind(Index, static_cast<int>(Value)); }
+
         void step() noexcept;
         void reset() noexcept;
 
+        /**
+        * @brief Sets all bound values to NULL.
+        */
+        void clearBindings() noexcept;
+
         /**
         * ASSERT that step() was called and returned SQLITE_ROW.
         * ASSERT that Index is smaller that sqlite3_column_count value after parsing string in the constructor.
@@ -114,6 +131,17 @@ namespace GRAPE {
         template <typename... Types>
         void bindValues(const Types&... Values) { bindValues(std::forward_as_tuple(Values...)); }
 
+        /**
+        * @brief Binds tuple values in order starting at index Offset, steps and resets the statement.
+        * Values bound at other indexes are kept, which allows a single prepared statement to be reused for bulk inserts.
+        */
+        template <std::size_t Offset = 0, typename... Types>
+        void stepValues(const std::tuple<Types...>& Values) {
+            bindValues<Offset>(Values);
+            step();
+            reset();
+        }
+
     private:
         sqlite3* m_Db;
         sqlite3_stmt* m_Stmt = nullptr;
@@ -59,7 +59,8 @@ namespace GRAPE {
 
     void NpdData::clear() noexcept {
         m_NpdData.clear();
-        m_InterpolationMatrix.clear();
+        m_Thrusts.clear();
+        m_InterpolationCells.clear();
     }
 
     void NpdData::addThrustE(double Thrust, const PowerNoiseLevelsArray& ThrustNoiseLevels) {
@@ -78,53 +79,53 @@ namespace GRAPE {
             throw GrapeException(std::format("Noise levels at thrust {:.0f} N already exist.", Thrust));
     }
 
-    double NpdData::interpolate(double Thrust, double Distance) const {
-        // Get thrust and noise levels that bound Thrust
-        // If thrust is not between min and max npd levels the first two or the last two are selected
-        auto itThrust1 = m_NpdData.lower_bound(Thrust);
-        if (itThrust1 == m_NpdData.end()) // Thrust is higher than maximum NPD thrust
-            itThrust1 = std::prev(itThrust1, 2); // Npd MUST have at least 2 entries
-        else if (itThrust1 != m_NpdData.begin())
-            itThrust1 = std::prev(itThrust1, 1);
-        auto itThrust2 = std::next(itThrust1, 1);
-        const std::size_t indexThrust = std::distance(m_NpdData.begin(), itThrust1);
-        auto& [Thrust1, NoiseLevels1] = *itThrust1;
-        auto& [Thrust2, NoiseLevels2] = *itThrust2;
-
-        auto itDist1 = std::ranges::lower_bound(NpdStandardDistances, Distance);
-
-        std::size_t indexBase;
-        std::size_t indexDist;
-
-        // Distance is higher than max npd distance, extrapolate outwards
-        if (itDist1 == NpdStandardDistances.end()) // 
-        {
-            itDist1 = std::prev(itDist1, 2);
-            indexDist = std::distance(NpdStandardDistances.begin(), itDist1);
-            indexBase = indexDist;
+    namespace {
+        const std::array<double, NpdStandardDistancesSize> NpdStandardLogDistances = [] {
+            std::array<double, NpdStandardDistancesSize> logDistances{};
+            std::ranges::transform(NpdStandardDistances, logDistances.begin(), [](double Distance) { return std::log10(Distance); });
+            return logDistances;
+        }();
 
-        }
-        // Distance is between min and max npd distances, interpolate
-        else if (itDist1 != NpdStandardDistances.begin())
-        {
-            itDist1 = std::prev(itDist1, 1);
-            indexDist = std::distance(NpdStandardDistances.begin(), itDist1);
-            indexBase = indexDist;
-        }
-        // Distance is lower than min npd distance, extrapolate inwards
-        else
-        {
-            Distance = std::max(Distance, 30.0); // Distance lower than min npd distance -> apply minimum of 30.0 meters
-            indexDist = 0;
-            indexBase = 1;
+        constexpr std::size_t NpdCellsSize = NpdStandardDistancesSize - 1;
+    }
 
-        }
+    /**
+    * If thrust is not between min and max npd levels the first two or the last two are selected (extrapolation).
+    */
+    NpdData::ThrustBracket NpdData::thrustBracket(double Thrust) const {
+        GRAPE_ASSERT(m_Thrusts.size() > 1);
+
+        const auto it = std::ranges::lower_bound(m_Thrusts, Thrust);
+        const std::size_t index = std::clamp(static_cast<std::size_t>(std::distance(m_Thrusts.begin(), it)), std::size_t{ 1 }, m_Thrusts.size() - 1) - 1;
+
+        return { index, (Thrust - m_Thrusts[index]) / (m_Thrusts[index + 1] - m_Thrusts[index]) };
+    }
+
+    /**
+    * Distances lower than the minimum NPD distance are extrapolated inwards down to 30 m.
+    */
+    double NpdData::logDistance(double Distance) {
+        return std::log10(std::max(Distance, 30.0));
+    }
+
+    /**
+    * The first cell is used below the second standard distance, the last cell above the second to last standard distance.
+    */
+    double NpdData::interpolate(const ThrustBracket& Bracket, double LogDistance) const {
+        std::size_t cell = 0;
+        while (cell < NpdCellsSize - 1 && LogDistance > NpdStandardLogDistances[cell + 1])
+            ++cell;
+
+        const auto& [intercept1, slope1] = m_InterpolationCells[Bracket.Index * NpdCellsSize + cell];
+        const auto& [intercept2, slope2] = m_InterpolationCells[(Bracket.Index + 1) * NpdCellsSize + cell];
+        const double noiseLvlThrust1Dist = intercept1 + slope1 * LogDistance;
+        const double noiseLvlThrust2Dist = intercept2 + slope2 * LogDistance;
 
-        const double iFactor = std::log10(Distance) - std::log10(NpdStandardDistances.at(indexBase));
-        const double noiseLvlThrust1Dist = NoiseLevels1.at(indexBase) + iFactor * m_InterpolationMatrix.at(indexThrust).at(indexDist);
-        const double noiseLvlThrust2Dist = NoiseLevels2.at(indexBase) + iFactor * m_InterpolationMatrix.at(indexThrust + 1).at(indexDist);
+        return noiseLvlThrust1Dist + Bracket.Factor * (noiseLvlThrust2Dist - noiseLvlThrust1Dist);
+    }
 
-        return noiseLvlThrust1Dist + (Thrust - Thrust1) * (noiseLvlThrust2Dist - noiseLvlThrust1Dist) / (Thrust2 - Thrust1);
+    double NpdData::interpolate(double Thrust, double Distance) const {
+        return interpolate(thrustBracket(Thrust), logDistance(Distance));
     }
 
     void NpdData::applyDelta(const PowerNoiseLevelsArray& Deltas) {
@@ -133,22 +134,23 @@ namespace GRAPE {
             for (std::size_t i = 0; i < NpdStandardDistancesSize; ++i)
                 powerNoiseValues.at(i) += Deltas.at(i);
         }
-        updateInterpolationMatrix();
+        updateInterpolationTables();
     }
 
-    void NpdData::updateInterpolationMatrix() {
-        m_InterpolationMatrix.clear();
+    void NpdData::updateInterpolationTables() {
+        m_Thrusts.clear();
+        m_InterpolationCells.clear();
+        m_Thrusts.reserve(m_NpdData.size());
+        m_InterpolationCells.reserve(m_NpdData.size() * NpdCellsSize);
 
-        for (const auto& noiseLevels : m_NpdData | std::views::values)
+        for (const auto& [thrust, noiseLevels] : m_NpdData)
         {
-            std::array<double, NpdStandardDistancesSize - 1> interpValues{};
-            for (auto itDist = NpdStandardDistances.begin(); itDist != std::prev(NpdStandardDistances.end(), 1); ++itDist)
+            m_Thrusts.emplace_back(thrust);
+            for (std::size_t i = 0; i < NpdCellsSize; ++i)
             {
-                const std::size_t indexDist = std::distance(NpdStandardDistances.begin(), itDist);
-                interpValues.at(indexDist) = (noiseLevels.at(indexDist + 1) - noiseLevels.at(indexDist))
-                    / (std::log10(NpdStandardDistances.at(indexDist + 1)) - std::log10(NpdStandardDistances.at(indexDist)));
+                const double slope = (noiseLevels.at(i + 1) - noiseLevels.at(i)) / (NpdStandardLogDistances.at(i + 1) - NpdStandardLogDistances.at(i));
+                m_InterpolationCells.emplace_back(noiseLevels.at(i) - slope * NpdStandardLogDistances.at(i), slope);
             }
-            m_InterpolationMatrix.emplace_back(interpValues);
         }
     }
 
@@ -165,4 +167,32 @@ namespace GRAPE {
     bool Doc29Noise::validDeparture() const {
         return DepartureLamax.size() > 1 && DepartureSel.size() > 1;
     }
+
+    TEST_CASE("NPD Interpolation") {
+        NpdData npd;
+        constexpr NpdData::PowerNoiseLevelsArray levelsLow{ 94.0, 88.0, 84.0, 80.0, 75.0, 70.0, 64.0, 58.0, 51.0, 44.0 };
+        constexpr NpdData::PowerNoiseLevelsArray levelsHigh{ 102.0, 96.0, 92.0, 88.0, 83.0, 78.0, 72.0, 66.0, 59.0, 52.0 };
+        npd.addThrust(20000.0, levelsLow);
+        npd.addThrust(60000.0, levelsHigh);
+        npd.applyDelta({});
+
+        // Standard distances reproduce the table
+        for (std::size_t i = 0; i < NpdStandardDistancesSize; ++i)
+        {
+            CHECK(npd.interpolate(20000.0, NpdStandardDistances.at(i)) == doctest::Approx(levelsLow.at(i)));
+            CHECK(npd.interpolate(60000.0, NpdStandardDistances.at(i)) == doctest::Approx(levelsHigh.at(i)));
+            CHECK(npd.interpolate(40000.0, NpdStandardDistances.at(i)) == doctest::Approx(std::midpoint(levelsLow.at(i), levelsHigh.at(i))));
+        }
+
+        // Logarithmic interpolation in distance
+        const double dist = std::sqrt(NpdStandardDistances.at(3) * NpdStandardDistances.at(4));
+        CHECK(npd.interpolate(20000.0, dist) == doctest::Approx(std::midpoint(levelsLow.at(3), levelsLow.at(4))));
+
+        // Extrapolation in distance and thrust
+        CHECK(npd.interpolate(20000.0, 10.0) == doctest::Approx(npd.interpolate(20000.0, 30.0)));
+        CHECK(npd.interpolate(20000.0, 30.0) == doctest::Approx(levelsLow.at(0) + (levelsLow.at(1) - levelsLow.at(0)) * std::log10(30.0 / NpdStandardDistances.at(0)) / std::log10(NpdStandardDistances.at(1) / NpdStandardDistances.at(0))));
+        CHECK(npd.interpolate(20000.0, 2.0 * NpdStandardDistances.at(9)) == doctest::Approx(levelsLow.at(9) + (levelsLow.at(9) - levelsLow.at(8)) * std::log10(2.0) / std::log10(NpdStandardDistances.at(9) / NpdStandardDistances.at(8))));
+        CHECK(npd.interpolate(100000.0, NpdStandardDistances.at(0)) == doctest::Approx(levelsHigh.at(0) + 8.0));
+        CHECK(npd.interpolate(0.0, NpdStandardDistances.at(0)) == doctest::Approx(levelsLow.at(0) - 4.0));
+    }
 }
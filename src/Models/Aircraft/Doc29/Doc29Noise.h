@@ -175,17 +175,50 @@ namespace GRAPE {
         */
         void applyDelta(const PowerNoiseLevelsArray& Deltas);
 
+        /**
+        * @brief The two NPD thrust levels bounding a thrust value and the linear interpolation factor between them.
+        */
+        struct ThrustBracket {
+            std::size_t Index = 0; ///< Index of the lower thrust level.
+            double Factor = 0.0; ///< 0 at the lower and 1 at the upper thrust level, outside [0, 1] when extrapolating.
+        };
+
+        /**
+        * @return The thrust bracket of Thrust, which can be reused for any number of interpolate() calls at that thrust.
+        * Only valid after applyDelta() was called.
+        */
+        [[nodiscard]] ThrustBracket thrustBracket(double Thrust) const;
+
+        /**
+        * @return The base 10 logarithm of Distance as used by interpolate(), with the minimum distance of 30 m applied.
+        */
+        [[nodiscard]] static double logDistance(double Distance);
+
+        /**
+        * @return Interpolates the interpolation tables at the thrust of Bracket and at the distance of LogDistance (see logDistance()).
+        * Only valid after applyDelta() was called.
+        */
+        [[nodiscard]] double interpolate(const ThrustBracket& Bracket, double LogDistance) const;
+
         /**
         * @return Interpolates the NPD map to get a noise value at Thrust and Distance.
+        * Only valid after applyDelta() was called.
         */
         [[nodiscard]] double interpolate(double Thrust, double Distance) const;
     private:
         // Data
         std::map<double, PowerNoiseLevelsArray> m_NpdData;
-        std::vector<std::array<double, NpdStandardDistancesSize - 1>> m_InterpolationMatrix;
+
+        // Interpolation tables, thrust major. Each cell is the line Intercept + Slope * log10(Distance) between two standard NPD distances.
+        struct InterpolationCell {
+            double Intercept;
+            double Slope;
+        };
+        std::vector<double> m_Thrusts;
+        std::vector<InterpolationCell> m_InterpolationCells;
 
     private:
-        void updateInterpolationMatrix();
+        void updateInterpolationTables();
     };
 
     /**
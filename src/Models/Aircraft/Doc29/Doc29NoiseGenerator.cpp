@@ -4,8 +4,9 @@
 
 #include "Doc29NoiseGenerator.h"
 
-#include "Base/CoordinateSystem.h"
+#include "Base/Atmosphere.h"
 #include "Base/Math.h"
+#include "Noise/ReceptorOutput.h"
 
 namespace GRAPE {
     namespace {
@@ -35,21 +36,20 @@ namespace GRAPE {
             bool SegmentTooFar = false;
         };
 
-        SegmentReceptorData segmentReceptorData(double Length, double Angle, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const CoordinateSystem& Cs) {
+        SegmentReceptorData segmentReceptorData(double Length, double Angle, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom) {
             SegmentReceptorData outSegReceptData{};
-            const double distance1 = Cs.distance(Recept.Longitude, Recept.Latitude, P1.Longitude, P1.Latitude);
-            const double distance2 = Cs.distance(Recept.Longitude, Recept.Latitude, P2.Longitude, P2.Latitude);
+            const double distance1 = Geom.Distance1;
+            const double distance2 = Geom.Distance2;
             if (std::min(distance1, distance2) > Doc29NoiseGenerator::s_MaximumDistance)
             {
                 outSegReceptData.SegmentTooFar = true;
                 return outSegReceptData;
             }
 
-            auto [lonP, latP, intersectTyp] = Cs.intersection(P1.Longitude, P1.Latitude, P2.Longitude, P2.Latitude, Recept.Longitude, Recept.Latitude);
-            outSegReceptData.IntersectionType = intersectTyp;
-            outSegReceptData.GroundDistanceP = Cs.distance(Recept.Longitude, Recept.Latitude, lonP, latP);
+            outSegReceptData.IntersectionType = Geom.IntersectionType;
+            outSegReceptData.GroundDistanceP = Geom.GroundDistanceP;
 
-            const double groundLengthQ = Cs.distance(P1.Longitude, P1.Latitude, lonP, latP);
+            const double groundLengthQ = Geom.GroundLengthQ;
 
             switch (outSegReceptData.IntersectionType)
             {
@@ -193,7 +193,7 @@ namespace GRAPE {
             default: GRAPE_ASSERT(false); break;
             }
 
-            const double bankAngleMultiplier = static_cast<double>(Cs.turnDirection(P1.Longitude, P1.Latitude, P2.Longitude, P2.Latitude, Recept.Longitude, Recept.Latitude)) * -1.0; // Determine if receptor is left or right and sign multiplier properly
+            const double bankAngleMultiplier = static_cast<double>(Geom.TurnDirection) * -1.0; // Determine if receptor is left or right and sign multiplier properly
 
             outSegReceptData.DepressionAngleE = outSegReceptData.ElevationAngleE + bankAngleMultiplier * outSegReceptData.BankAngle;
             outSegReceptData.DepressionAngleS = outSegReceptData.ElevationAngleS + bankAngleMultiplier * outSegReceptData.BankAngle;
@@ -280,22 +280,188 @@ namespace GRAPE {
 
             return outCommonCorrFactors;
         }
-    }
-    Doc29NoiseGenerator::Doc29NoiseGenerator(const NpdData& Sel, const NpdData& Lamax, const Doc29Spectrum& Spectrum, const Doc29Noise::LateralDirectivity& LateralDir) : m_Sel(Sel), m_Lamax(Lamax), m_Spectrum(Spectrum), m_LateralDir(LateralDir) {}
 
-    void Doc29NoiseGenerator::applyAtmosphericAbsorption(const AtmosphericAbsorption& AtmAbsorption) {
-        resetAtmosphericAbsorption();
+        typedef Doc29NoiseGenerator::BlockLevels BlockLevels;
+
+        /**
+        * @brief SegmentReceptorData of the receptors of a ReceptorBlock, structure of arrays layout.
+        *
+        * The distance used for the exposure level (DistanceE) equals the distance to P in every intersection case, DistanceP holds both.
+        */
+        struct SegmentReceptorDataBlock {
+            BlockLevels Q{};
+            BlockLevels DistanceP{};
+
+            BlockLevels GroundDistanceS{};
+            BlockLevels DistanceS{};
+            BlockLevels ElevationAngleS{};
+            BlockLevels DepressionAngleS{};
+
+            BlockLevels GroundDistanceE{};
+            BlockLevels ElevationAngleE{};
+            BlockLevels DepressionAngleE{};
+
+            BlockLevels TrueAirspeed{};
+            BlockLevels Thrust{};
+
+            std::array<bool, ReceptorBlock::Size> BehindTakeoffRollOrAheadOfLandingRoll{};
+            std::array<bool, ReceptorBlock::Size> SegmentTooFar{};
+        };
+
+        /**
+        * @brief Same results as segmentReceptorData() for the first Block.Count lanes.
+        * The intersection cases are selected per lane instead of branched on, so that the loop can be vectorized by the compiler.
+        */
+        void segmentReceptorData(const FlightPathGeometry::Segment& Seg, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, const SegmentReceptorGeometryBlock& Geom, SegmentReceptorDataBlock& Out) {
+            BlockLevels elevations{};
+            for (std::size_t i = 0; i < Block.Count; ++i)
+                elevations[i] = Block.Receptors[i]->Elevation;
+
+            const double cosAngle = std::cos(Seg.Angle);
+            const double tanAngle = std::tan(Seg.Angle);
+            const bool rollSegment = P2.FlPhase == FlightPhase::TakeoffRoll || P1.FlPhase == FlightPhase::LandingRoll;
+            const double rollTrueAirspeed = std::midpoint(P1.TrueAirspeed, P2.TrueAirspeed);
+
+            for (std::size_t i = 0; i < Block.Count; ++i)
+            {
+                const double distance1 = Geom.Distance1[i];
+                const double distance2 = Geom.Distance2[i];
+                Out.SegmentTooFar[i] = std::min(distance1, distance2) > Doc29NoiseGenerator::s_MaximumDistance;
+
+                // Same classification as FlightPathGeometry::Segment::receptorGeometry()
+                const double along = Geom.Along[i];
+                const bool behind = !(along > -0.05);
+                const bool ahead = !behind && !(along < Seg.GroundLength + 0.05);
+                const bool between = !behind && !ahead;
+                const double groundDistanceP = Seg.GroundLength < Constants::Precision ? distance1 : std::abs(Geom.Cross[i]);
+                const double groundLengthQ = behind ? -std::abs(along) : std::abs(along);
+
+                // Projection P of the receptor on the segment line
+                const double q = groundLengthQ / cosAngle;
+                const double altDiffP = P1.AltitudeMsl + groundLengthQ * tanAngle - elevations[i];
+                const double distanceP = std::hypot(groundDistanceP, altDiffP);
+                const double elevationAngleP = altDiffP < Constants::Precision ? 0.0 : std::atan(altDiffP / groundDistanceP);
+
+                // Closest segment end, used if P is behind or ahead of the segment
+                const double groundDistanceEnd = behind ? distance1 : distance2;
+                const double altDiffEnd = (behind ? P1.AltitudeMsl : P2.AltitudeMsl) - elevations[i];
+                const double distanceEnd = std::hypot(groundDistanceEnd, altDiffEnd);
+                const double elevationAngleEnd = altDiffEnd < Constants::Precision ? 0.0 : std::atan(altDiffEnd / groundDistanceEnd);
+                const double elevationAngleEndP = altDiffEnd < Constants::Precision ? 0.0 : std::atan(altDiffEnd / cosAngle / groundDistanceP);
+
+                // Finite segment correction behind takeoff roll or ahead of landing roll
+                const bool roll = behind ? P2.FlPhase == FlightPhase::TakeoffRoll : ahead && P1.FlPhase == FlightPhase::LandingRoll;
+
+                Out.Q[i] = q;
+                Out.DistanceP[i] = roll ? distanceEnd : distanceP;
+                Out.GroundDistanceS[i] = between ? groundDistanceP : groundDistanceEnd;
+                Out.DistanceS[i] = between ? distanceP : distanceEnd;
+                Out.ElevationAngleS[i] = between ? elevationAngleP : elevationAngleEnd;
+                Out.GroundDistanceE[i] = roll ? groundDistanceEnd : groundDistanceP;
+                Out.ElevationAngleE[i] = between ? elevationAngleP : roll ? elevationAngleEnd : elevationAngleEndP;
+                Out.BehindTakeoffRollOrAheadOfLandingRoll[i] = roll;
+
+                const double iFactor = q / Seg.Length;
+                Out.TrueAirspeed[i] = rollSegment ? rollTrueAirspeed : behind ? P1.TrueAirspeed : ahead ? P2.TrueAirspeed : timeInterpolation(P1.TrueAirspeed, P2.TrueAirspeed, iFactor);
+                Out.Thrust[i] = behind ? P1.CorrNetThrustPerEng : ahead ? P2.CorrNetThrustPerEng : timeInterpolation(P1.CorrNetThrustPerEng, P2.CorrNetThrustPerEng, iFactor);
+                const double bankAngle = behind ? P1.BankAngle : ahead ? P2.BankAngle : distanceInterpolation(P1.BankAngle, P2.BankAngle, iFactor);
+
+                const double bankAngleMultiplier = Geom.Cross[i] > 0.0 ? 1.0 : -1.0; // Receptor to the left of the segment
+                Out.DepressionAngleE[i] = Out.ElevationAngleE[i] + bankAngleMultiplier * bankAngle;
+                Out.DepressionAngleS[i] = Out.ElevationAngleS[i] + bankAngleMultiplier * bankAngle;
+            }
+        }
+
+        struct CommonCorrectionFactorsBlock {
+            BlockLevels Duration{};
+            BlockLevels EngineInstallationMaximumLevel{};
+            BlockLevels EngineInstallationExposure{};
+            BlockLevels LateralAttenuationMaximumLevel{};
+            BlockLevels LateralAttenuationExposure{};
+        };
+
+        /**
+        * @brief Same results as commonCorrectionFactors() for the first Count lanes. The lateral directivity is resolved once for the whole block.
+        */
+        void commonCorrectionFactors(const SegmentReceptorDataBlock& SegReceptorData, std::size_t Count, Doc29Noise::LateralDirectivity LateralDirectivity, CommonCorrectionFactorsBlock& Out) {
+            // Duration Correction
+            for (std::size_t i = 0; i < Count; ++i)
+                Out.Duration[i] = SegReceptorData.TrueAirspeed[i] < Constants::Precision ? 0.0 : 10 * std::log10(fromKnots(160.0) / SegReceptorData.TrueAirspeed[i]);
+
+            // Engine Installation Correction
+            const auto engineInstallation = [&](double A, double B, double C) {
+                for (std::size_t i = 0; i < Count; ++i)
+                {
+                    Out.EngineInstallationMaximumLevel[i] = engineInstallationCorrection(A, B, C, SegReceptorData.DepressionAngleS[i]);
+                    Out.EngineInstallationExposure[i] = engineInstallationCorrection(A, B, C, SegReceptorData.DepressionAngleE[i]);
+                }
+                };
+
+            switch (LateralDirectivity)
+            {
+            case Doc29Noise::LateralDirectivity::Wing: engineInstallation(0.0039, 0.062, 0.8786); break;
+            case Doc29Noise::LateralDirectivity::Fuselage: engineInstallation(0.1225, 0.329, 1.0); break;
+            case Doc29Noise::LateralDirectivity::Propeller:
+                {
+                    Out.EngineInstallationMaximumLevel.fill(0.0);
+                    Out.EngineInstallationExposure.fill(0.0);
+                    break;
+                }
+            default: GRAPE_ASSERT(false); break;
+            }
+
+            // Lateral Attenuation
+            for (std::size_t i = 0; i < Count; ++i)
+            {
+                Out.LateralAttenuationMaximumLevel[i] = lateralAttenuation(SegReceptorData.GroundDistanceS[i], SegReceptorData.ElevationAngleS[i]);
+                Out.LateralAttenuationExposure[i] = lateralAttenuation(SegReceptorData.GroundDistanceE[i], SegReceptorData.ElevationAngleE[i]);
+            }
+        }
+
+        /**
+        * @return The finite segment correction with the scaled distance between the two segment ends at Alpha1 and Alpha2.
+        */
+        double finiteSegmentCorrection(double Alpha1, double Alpha2) {
+            return std::max(-150.0, 10.0 * std::log10(std::numbers::inv_pi * (Alpha2 / (1 + Alpha2 * Alpha2) + std::atan(Alpha2) - Alpha1 / (1 + Alpha1 * Alpha1) - std::atan(Alpha1))));
+        }
+    }
+    Doc29NoiseGenerator::Doc29NoiseGenerator(const NpdData& Sel, const NpdData& Lamax, const Doc29Spectrum& Spectrum, const Doc29Noise::LateralDirectivity& LateralDir, const AtmosphericAbsorption& AtmAbsorption) : m_Sel(Sel), m_Lamax(Lamax), m_LateralDir(LateralDir) {
         if (AtmAbsorption.type() != AtmosphericAbsorption::Type::None)
+            calculateAtmosphericAbsorptionDeltas(Spectrum, AtmAbsorption);
+
+        // Always applied, also updates the interpolation matrices
+        m_Sel.applyDelta(m_Deltas);
+        m_Lamax.applyDelta(m_Deltas);
+    }
+
+    Doc29NoiseGenerator::SegmentThrusts Doc29NoiseGenerator::segmentThrusts(const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2) const {
+        return { P1.CorrNetThrustPerEng, P2.CorrNetThrustPerEng, m_Sel.thrustBracket(P1.CorrNetThrustPerEng), m_Lamax.thrustBracket(P1.CorrNetThrustPerEng), m_Sel.thrustBracket(P2.CorrNetThrustPerEng), m_Lamax.thrustBracket(P2.CorrNetThrustPerEng) };
+    }
+
+    std::pair<NpdData::ThrustBracket, NpdData::ThrustBracket> Doc29NoiseGenerator::thrustBrackets(const SegmentThrusts& SegThrusts, double Thrust) const {
+        if (Thrust == SegThrusts.Thrust1)
+            return { SegThrusts.Sel1, SegThrusts.Lamax1 };
+
+        if (Thrust == SegThrusts.Thrust2)
+            return { SegThrusts.Sel2, SegThrusts.Lamax2 };
+
+        return { m_Sel.thrustBracket(Thrust), m_Lamax.thrustBracket(Thrust) };
+    }
+
+    void Doc29NoiseGenerator::npdLevels(const SegmentThrusts& SegThrusts, double Delta, std::size_t Count, const BlockLevels& Thrust, const BlockLevels& DistanceS, const BlockLevels& DistanceP, BlockLevels& Sel, BlockLevels& Lamax, BlockLevels& LamaxP) const {
+        for (std::size_t i = 0; i < Count; ++i)
         {
-            calculateAtmosphericAbsorptionDeltas(AtmAbsorption);
-            m_Sel.applyDelta(m_Deltas);
-            m_Lamax.applyDelta(m_Deltas);
+            const auto [selBracket, lamaxBracket] = thrustBrackets(SegThrusts, Thrust[i]);
+            const double logDistanceP = NpdData::logDistance(DistanceP[i]);
+            Sel[i] = m_Sel.interpolate(selBracket, logDistanceP) + Delta;
+            Lamax[i] = m_Lamax.interpolate(lamaxBracket, NpdData::logDistance(DistanceS[i])) + Delta;
+            LamaxP[i] = m_Lamax.interpolate(lamaxBracket, logDistanceP) + Delta;
         }
     }
 
-    void Doc29NoiseGenerator::calculateAtmosphericAbsorptionDeltas(const AtmosphericAbsorption& AtmAbsorption) {
+    void Doc29NoiseGenerator::calculateAtmosphericAbsorptionDeltas(const Doc29Spectrum& Spectrum, const AtmosphericAbsorption& AtmAbsorption) {
         OneThirdOctaveArray correctedLevels{};
-        std::ranges::transform(m_Spectrum.noiseLevels(), NpdStandardAverageAttenuationRates, correctedLevels.begin(), [](double Level, double Attenuation) { return Level + Attenuation * 305.0; });
+        std::ranges::transform(Spectrum.noiseLevels(), NpdStandardAverageAttenuationRates, correctedLevels.begin(), [](double Level, double Attenuation) { return Level + Attenuation * 305.0; });
 
         SpectrumArray standardAtm{};
         for (std::size_t i = 0; i < NpdStandardDistancesSize; ++i)
@@ -318,25 +484,23 @@ namespace GRAPE {
         }
     }
 
-    void Doc29NoiseGenerator::resetAtmosphericAbsorption() {
-        std::ranges::transform(m_Deltas, m_Deltas.begin(), [](const double Val) { return Val * -1.0; });
-        m_Sel.applyDelta(m_Deltas);
-        m_Lamax.applyDelta(m_Deltas);
-        std::ranges::fill(m_Deltas, 0.0);
-    }
+    Doc29NoiseGeneratorArrival::Doc29NoiseGeneratorArrival(const Doc29Noise& Doc29Ns, const AtmosphericAbsorption& AtmAbsorption) : Doc29NoiseGenerator(Doc29Ns.ArrivalSel, Doc29Ns.ArrivalLamax, Doc29Ns.ArrivalSpectrum, Doc29Ns.LateralDir, AtmAbsorption) {}
 
-    Doc29NoiseGeneratorArrival::Doc29NoiseGeneratorArrival(const Doc29Noise& Doc29Ns) : Doc29NoiseGenerator(Doc29Ns.ArrivalSel, Doc29Ns.ArrivalLamax, Doc29Ns.ArrivalSpectrum, Doc29Ns.LateralDir) {}
+    std::pair<double, double> Doc29NoiseGeneratorArrival::calculateArrivalNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom, const Atmosphere& Atm) const {
+        return calculateArrivalNoise(Length, Angle, Delta, P1, P2, Recept, Geom, segmentThrusts(P1, P2));
+    }
 
-    std::pair<double, double> Doc29NoiseGeneratorArrival::calculateArrivalNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const CoordinateSystem& Cs, const Atmosphere& Atm) const {
+    std::pair<double, double> Doc29NoiseGeneratorArrival::calculateArrivalNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom, const SegmentThrusts& SegThrusts) const {
         // Data dependent on segment receptor geometry
-        const SegmentReceptorData segReceptData = segmentReceptorData(Length, Angle, P1, P2, Recept, Cs);
+        const SegmentReceptorData segReceptData = segmentReceptorData(Length, Angle, P1, P2, Recept, Geom);
         if (segReceptData.SegmentTooFar)
             return { 0.0, 0.0 };
 
         // Noise Interpolation
-        double selSeg = m_Sel.interpolate(segReceptData.Thrust, segReceptData.DistanceE) + Delta;
-        double laMaxSeg = m_Lamax.interpolate(segReceptData.Thrust, segReceptData.DistanceS) + Delta;
-        const double laMaxSegP = m_Lamax.interpolate(segReceptData.Thrust, segReceptData.DistanceP) + Delta;
+        const auto [selBracket, lamaxBracket] = thrustBrackets(SegThrusts, segReceptData.Thrust);
+        double selSeg = m_Sel.interpolate(selBracket, NpdData::logDistance(segReceptData.DistanceE)) + Delta;
+        double laMaxSeg = m_Lamax.interpolate(lamaxBracket, NpdData::logDistance(segReceptData.DistanceS)) + Delta;
+        const double laMaxSegP = m_Lamax.interpolate(lamaxBracket, NpdData::logDistance(segReceptData.DistanceP)) + Delta;
 
         // Common Correction Factors
         const auto [corrDuration, corrEngineInstallationMaximumLevel, corrEngineInstallationExposure, corrLateralAttenuationMaximumLevel, corrLateralAttenuationExposure] = commonCorrectionFactors(segReceptData, m_LateralDir);
@@ -365,18 +529,53 @@ namespace GRAPE {
         return { laMaxSeg, selSeg };
     }
 
-    Doc29NoiseGeneratorDeparture::Doc29NoiseGeneratorDeparture(const Doc29Noise& Doc29Ns) : Doc29NoiseGenerator(Doc29Ns.DepartureSel, Doc29Ns.DepartureLamax, Doc29Ns.DepartureSpectrum, Doc29Ns.LateralDir), m_SOR(Doc29Ns.SOR) {}
+    void Doc29NoiseGeneratorArrival::calculateArrivalNoise(const FlightPathGeometry::Segment& Seg, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, const Atmosphere& Atm, BlockLevels& Lamax, BlockLevels& Sel) const {
+        // Data dependent on segment receptor geometry
+        SegmentReceptorGeometryBlock geomBlock;
+        Seg.receptorGeometry(Block, geomBlock);
+        SegmentReceptorDataBlock segReceptData;
+        segmentReceptorData(Seg, P1, P2, Block, geomBlock, segReceptData);
 
-    std::pair<double, double> Doc29NoiseGeneratorDeparture::calculateDepartureNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const CoordinateSystem& Cs, const Atmosphere& Atm) const {
+        // Noise Interpolation
+        BlockLevels laMaxSegP{};
+        npdLevels(segmentThrusts(P1, P2), Delta, Block.Count, segReceptData.Thrust, segReceptData.DistanceS, segReceptData.DistanceP, Sel, Lamax, laMaxSegP);
+
+        // Common Correction Factors
+        CommonCorrectionFactorsBlock corr;
+        commonCorrectionFactors(segReceptData, Block.Count, m_LateralDir, corr);
+
+        for (std::size_t i = 0; i < Block.Count; ++i)
+        {
+            // Finite Segment Correction, the second segment end is not considered ahead of the landing roll
+            const double distScaled = 2.0 / std::numbers::pi * fromKnots(160.0) * std::pow(10.0, (Sel[i] - laMaxSegP[i]) / 10.0);
+            const bool roll = segReceptData.BehindTakeoffRollOrAheadOfLandingRoll[i];
+            const double alpha1 = (roll ? -Seg.Length : -segReceptData.Q[i]) / distScaled;
+            const double alpha2 = roll ? 0.0 : -(segReceptData.Q[i] - Seg.Length) / distScaled;
+            const double corrFiniteSegment = finiteSegmentCorrection(alpha1, alpha2);
+
+            // Apply correction factors
+            Lamax[i] = segReceptData.SegmentTooFar[i] ? 0.0 : Lamax[i] + corr.EngineInstallationMaximumLevel[i] - corr.LateralAttenuationMaximumLevel[i];
+            Sel[i] = segReceptData.SegmentTooFar[i] ? 0.0 : Sel[i] + corr.Duration[i] + corr.EngineInstallationExposure[i] - corr.LateralAttenuationExposure[i] + corrFiniteSegment;
+        }
+    }
+
+    Doc29NoiseGeneratorDeparture::Doc29NoiseGeneratorDeparture(const Doc29Noise& Doc29Ns, const AtmosphericAbsorption& AtmAbsorption) : Doc29NoiseGenerator(Doc29Ns.DepartureSel, Doc29Ns.DepartureLamax, Doc29Ns.DepartureSpectrum, Doc29Ns.LateralDir, AtmAbsorption), m_SOR(Doc29Ns.SOR) {}
+
+    std::pair<double, double> Doc29NoiseGeneratorDeparture::calculateDepartureNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom, const Atmosphere& Atm) const {
+        return calculateDepartureNoise(Length, Angle, Delta, P1, P2, Recept, Geom, segmentThrusts(P1, P2));
+    }
+
+    std::pair<double, double> Doc29NoiseGeneratorDeparture::calculateDepartureNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom, const SegmentThrusts& SegThrusts) const {
         // Data dependent on segment receptor geometry
-        const SegmentReceptorData segReceptData = segmentReceptorData(Length, Angle, P1, P2, Recept, Cs);
+        const SegmentReceptorData segReceptData = segmentReceptorData(Length, Angle, P1, P2, Recept, Geom);
         if (segReceptData.SegmentTooFar)
             return { 0.0, 0.0 };
 
         // Noise Interpolation
-        double selSeg = m_Sel.interpolate(segReceptData.Thrust, segReceptData.DistanceE) + Delta;
-        double laMaxSeg = m_Lamax.interpolate(segReceptData.Thrust, segReceptData.DistanceS) + Delta;
-        const double laMaxSegP = m_Lamax.interpolate(segReceptData.Thrust, segReceptData.DistanceP) + Delta;
+        const auto [selBracket, lamaxBracket] = thrustBrackets(SegThrusts, segReceptData.Thrust);
+        double selSeg = m_Sel.interpolate(selBracket, NpdData::logDistance(segReceptData.DistanceE)) + Delta;
+        double laMaxSeg = m_Lamax.interpolate(lamaxBracket, NpdData::logDistance(segReceptData.DistanceS)) + Delta;
+        const double laMaxSegP = m_Lamax.interpolate(lamaxBracket, NpdData::logDistance(segReceptData.DistanceP)) + Delta;
 
         // Common Correction Factors
         const auto [corrDuration, corrEngineInstallationMaximumLevel, corrEngineInstallationExposure, corrLateralAttenuationMaximumLevel, corrLateralAttenuationExposure] = commonCorrectionFactors(segReceptData, m_LateralDir);
@@ -425,6 +624,60 @@ namespace GRAPE {
         return { laMaxSeg, selSeg };
     }
 
+    void Doc29NoiseGeneratorDeparture::calculateDepartureNoise(const FlightPathGeometry::Segment& Seg, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, const Atmosphere& Atm, BlockLevels& Lamax, BlockLevels& Sel) const {
+        // Data dependent on segment receptor geometry
+        SegmentReceptorGeometryBlock geomBlock;
+        Seg.receptorGeometry(Block, geomBlock);
+        SegmentReceptorDataBlock segReceptData;
+        segmentReceptorData(Seg, P1, P2, Block, geomBlock, segReceptData);
+
+        // Noise Interpolation
+        BlockLevels laMaxSegP{};
+        npdLevels(segmentThrusts(P1, P2), Delta, Block.Count, segReceptData.Thrust, segReceptData.DistanceS, segReceptData.DistanceP, Sel, Lamax, laMaxSegP);
+
+        // Common Correction Factors
+        CommonCorrectionFactorsBlock corr;
+        commonCorrectionFactors(segReceptData, Block.Count, m_LateralDir, corr);
+
+        // Start of Roll directivity Function, only behind the takeoff roll
+        BlockLevels corrSor{};
+        const auto sorCorrection = [&](auto SorCorrection) {
+            for (std::size_t i = 0; i < Block.Count; ++i)
+            {
+                if (!segReceptData.BehindTakeoffRollOrAheadOfLandingRoll[i])
+                    continue;
+
+                const double ratio = segReceptData.Q[i] / segReceptData.DistanceS[i];
+                const double azimuth = std::isnan(ratio) || ratio + 1.0 < Constants::Precision ? 180.0 : fromRadians(std::acos(ratio));
+                corrSor[i] = SorCorrection(azimuth);
+                if (segReceptData.DistanceS[i] > 762.0)
+                    corrSor[i] = corrSor[i] * 762.0 / segReceptData.DistanceS[i];
+            }
+            };
+
+        switch (m_SOR)
+        {
+        case Doc29Noise::SORCorrection::None: break;
+        case Doc29Noise::SORCorrection::Jet: sorCorrection(sorCorrectionJet); break;
+        case Doc29Noise::SORCorrection::Turboprop: sorCorrection(sorCorrectionTurboprop); break;
+        default: GRAPE_ASSERT(false);
+        }
+
+        for (std::size_t i = 0; i < Block.Count; ++i)
+        {
+            // Finite Segment Correction, the first segment end is not considered behind the takeoff roll
+            const double distScaled = 2.0 / std::numbers::pi * fromKnots(160.0) * std::pow(10.0, (Sel[i] - laMaxSegP[i]) / 10.0);
+            const bool roll = segReceptData.BehindTakeoffRollOrAheadOfLandingRoll[i];
+            const double alpha1 = roll ? 0.0 : -segReceptData.Q[i] / distScaled;
+            const double alpha2 = (roll ? Seg.Length : -(segReceptData.Q[i] - Seg.Length)) / distScaled;
+            const double corrFiniteSegment = finiteSegmentCorrection(alpha1, alpha2);
+
+            // Apply correction factors
+            Lamax[i] = segReceptData.SegmentTooFar[i] ? 0.0 : Lamax[i] + corr.EngineInstallationMaximumLevel[i] - corr.LateralAttenuationMaximumLevel[i] + corrSor[i];
+            Sel[i] = segReceptData.SegmentTooFar[i] ? 0.0 : Sel[i] + corr.Duration[i] + corr.EngineInstallationExposure[i] - corr.LateralAttenuationExposure[i] + corrFiniteSegment + corrSor[i];
+        }
+    }
+
     TEST_CASE("NPD Corrections") {
         Doc29Noise doc29Noise("NPD Corrections");
 
@@ -480,14 +733,11 @@ namespace GRAPE {
         doc29Noise.DepartureSpectrum.setValue(22, 42.3);
         doc29Noise.DepartureSpectrum.setValue(23, 37.7);
 
-        Doc29NoiseGeneratorArrival arrNoise(doc29Noise);
-        Doc29NoiseGeneratorDeparture depNoise(doc29Noise);
-
         SUBCASE("SAE ARP 5534") {
             const AtmosphericAbsorption saeArp5534(fromCelsius(10.0), 101325.0, 0.8);
 
-            arrNoise.applyAtmosphericAbsorption(saeArp5534);
-            depNoise.applyAtmosphericAbsorption(saeArp5534);
+            const Doc29NoiseGeneratorArrival arrNoise(doc29Noise, saeArp5534);
+            const Doc29NoiseGeneratorDeparture depNoise(doc29Noise, saeArp5534);
 
             /// Commented cases fail. Reason for that might be due to rounding errors during the calculation of the reference values.
             const auto& arrDeltas = arrNoise.deltas();
@@ -518,8 +768,8 @@ namespace GRAPE {
         SUBCASE("SAE ARP 866") {
             const AtmosphericAbsorption saeArp866(fromCelsius(10.0), 0.8);
 
-            arrNoise.applyAtmosphericAbsorption(saeArp866);
-            depNoise.applyAtmosphericAbsorption(saeArp866);
+            const Doc29NoiseGeneratorArrival arrNoise(doc29Noise, saeArp866);
+            const Doc29NoiseGeneratorDeparture depNoise(doc29Noise, saeArp866);
 
             /// Commented cases fail. Reason for that might be due to rounding errors during the calculation of the reference values.
             const auto& arrDeltas = arrNoise.deltas();
@@ -547,4 +797,107 @@ namespace GRAPE {
             CHECK_EQ(round(depDeltas.at(9), 1), doctest::Approx(2.8).epsilon(Constants::PrecisionTest));
         }
     }
+
+    TEST_CASE("Doc29 Noise Block") {
+        Doc29Noise doc29Noise("Doc29 Noise Block");
+        doc29Noise.LateralDir = Doc29Noise::LateralDirectivity::Wing;
+        doc29Noise.SOR = Doc29Noise::SORCorrection::Jet;
+        constexpr NpdData::PowerNoiseLevelsArray lamaxLow{ 94.0, 88.0, 84.0, 80.0, 75.0, 70.0, 64.0, 58.0, 51.0, 44.0 };
+        constexpr NpdData::PowerNoiseLevelsArray lamaxHigh{ 102.0, 96.0, 92.0, 88.0, 83.0, 78.0, 72.0, 66.0, 59.0, 52.0 };
+        constexpr NpdData::PowerNoiseLevelsArray selLow{ 96.0, 91.0, 88.0, 85.0, 81.0, 77.0, 72.0, 67.0, 61.0, 55.0 };
+        constexpr NpdData::PowerNoiseLevelsArray selHigh{ 104.0, 99.0, 96.0, 93.0, 89.0, 85.0, 80.0, 75.0, 69.0, 63.0 };
+        for (auto npd : { &doc29Noise.ArrivalLamax, &doc29Noise.DepartureLamax })
+        {
+            npd->addThrust(20000.0, lamaxLow);
+            npd->addThrust(100000.0, lamaxHigh);
+        }
+        for (auto npd : { &doc29Noise.ArrivalSel, &doc29Noise.DepartureSel })
+        {
+            npd->addThrust(20000.0, selLow);
+            npd->addThrust(100000.0, selHigh);
+        }
+
+        const Doc29NoiseGeneratorArrival arrNoise(doc29Noise, AtmosphericAbsorption());
+        const Doc29NoiseGeneratorDeparture depNoise(doc29Noise, AtmosphericAbsorption());
+        const Atmosphere atm;
+        const LocalCartesian frame(0.0, 0.0);
+
+        // Approach and landing roll to the north
+        PerformanceOutput perfOutputArr;
+        perfOutputArr.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::Approach, 0.0, 0.0, -0.05, 300.0, 75.0, 75.0, 30000.0, 0.0);
+        perfOutputArr.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::LandingRoll, 5530.0, 0.0, 0.0, 0.0, 70.0, 70.0, 30000.0, 0.0);
+        perfOutputArr.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::LandingRoll, 6525.0, 0.0, 0.009, 0.0, 15.0, 15.0, 50000.0, 0.0);
+
+        // Takeoff roll to the north and banked initial climb to the north east
+        PerformanceOutput perfOutputDep;
+        perfOutputDep.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::TakeoffRoll, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 110000.0, 0.0);
+        perfOutputDep.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::TakeoffRoll, 1500.0, 0.0, 0.0135, 0.0, 80.0, 80.0, 100000.0, 0.0);
+        perfOutputDep.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::InitialClimb, 5500.0, 0.02, 0.0494, 600.0, 100.0, 100.0, 60000.0, toRadians(15.0));
+
+        // One full and one partial block, receptors behind, beside and ahead of the segments, on both sides, on the flight path and above the aircraft
+        ReceptorOutput receptOutput;
+        constexpr std::array<std::array<double, 3>, 18> receptors{ {
+            { 0.0, -0.01, 0.0 }, { 0.005, -0.002, 0.0 }, { -0.004, 0.005, 0.0 }, { 0.004, 0.01, 10.0 },
+            { 0.0, 0.03, 0.0 }, { 0.01, 0.0315, 0.0 }, { 0.015, 0.03, 20.0 }, { -0.01, 0.04, 0.0 },
+            { 0.03, 0.06, 0.0 }, { 0.02, 0.08, 50.0 }, { -0.03, -0.03, 0.0 }, { 0.05, 0.0, 0.0 },
+            { 0.0, -0.06, 0.0 }, { 0.002, -0.03, 0.0 }, { -0.006, -0.045, 15.0 }, { 0.0004, 0.0135, 0.0 },
+            { -0.001, 0.02, 700.0 }, { 0.012, -0.015, 5.0 },
+        } };
+        for (std::size_t i = 0; i < receptors.size(); ++i)
+            receptOutput.addReceptor(std::format("{}", i), receptors.at(i).at(0), receptors.at(i).at(1), receptors.at(i).at(2));
+
+        // Maximum level and exposure over all segments, calculated with the single receptor implementation before the block kernel and the local frame were introduced (geodesic segment receptor geometry)
+        constexpr std::array<double, 18> arrLamaxRef{ 95.1294, 67.3052, 69.6690, 70.0948, 52.1821, 50.1012, 49.4754, 46.1538, 37.0133, 33.5746, 48.9416, 37.5772, 68.9621, 81.6883, 73.4836, 69.1269, 58.7499, 61.6243 };
+        constexpr std::array<double, 18> arrSelRef{ 97.7482, 73.9308, 78.0108, 75.5369, 60.4086, 58.6250, 58.0969, 55.2331, 47.2383, 44.1993, 58.6500, 49.6481, 54.5573, 87.0713, 80.0969, 74.6991, 65.8995, 69.4367 };
+        constexpr std::array<double, 18> depLamaxRef{ 58.0641, 73.2747, 76.0817, 75.7098, 76.3861, 85.1729, 79.5614, 62.1257, 67.0528, 56.5362, 48.1360, 46.1050, 41.2735, 50.2777, 45.2352, 103.9936, 71.1616, 58.6224 };
+        constexpr std::array<double, 18> depSelRef{ 65.0453, 79.3697, 84.7344, 84.5220, 82.6905, 89.8578, 85.1618, 70.2028, 46.4659, 35.7389, 58.1215, 59.0090, 51.9816, 59.5474, 55.3536, 106.9437, 77.5833, 66.9512 };
+
+        // The local frame changes the levels by less than 1e-4 dB this close to its origin, the reference levels are rounded to 1e-4 dB
+        constexpr double tolerance = 0.001; // dB
+
+        const auto check = [&](const PerformanceOutput& PerfOutput, const auto& CalculateNoise, const std::array<double, 18>& LamaxRef, const std::array<double, 18>& SelRef) {
+            const FlightPathGeometry flightPath(frame, PerfOutput);
+            std::vector<const PerformanceOutput::Point*> points;
+            for (const auto& pt : PerfOutput | std::views::values)
+                points.emplace_back(&pt);
+
+            for (std::size_t start = 0; start < receptOutput.size(); start += ReceptorBlock::Size)
+            {
+                ReceptorBlock block;
+                for (std::size_t i = start; i < std::min(start + ReceptorBlock::Size, receptOutput.size()); ++i)
+                {
+                    const auto& recept = receptOutput(i);
+                    std::tie(block.X.at(block.Count), block.Y.at(block.Count)) = frame.forward(recept.Longitude, recept.Latitude);
+                    block.Receptors.at(block.Count) = &recept;
+                    ++block.Count;
+                }
+
+                Doc29NoiseGenerator::BlockLevels laMax{}, selEnergy{};
+                for (std::size_t segIndex = 0; segIndex < flightPath.size(); ++segIndex)
+                {
+                    Doc29NoiseGenerator::BlockLevels laMaxSeg{}, selSeg{};
+                    CalculateNoise(flightPath.segment(segIndex), *points.at(segIndex), *points.at(segIndex + 1), block, laMaxSeg, selSeg);
+                    for (std::size_t lane = 0; lane < block.Count; ++lane)
+                    {
+                        laMax.at(lane) = std::max(laMax.at(lane), laMaxSeg.at(lane));
+                        selEnergy.at(lane) += std::pow(10.0, selSeg.at(lane) / 10.0);
+                    }
+                }
+
+                for (std::size_t lane = 0; lane < block.Count; ++lane)
+                {
+                    CHECK(std::abs(laMax.at(lane) - LamaxRef.at(start + lane)) < tolerance);
+                    CHECK(std::abs(10.0 * std::log10(selEnergy.at(lane)) - SelRef.at(start + lane)) < tolerance);
+                }
+            }
+            };
+
+        SUBCASE("Arrival") {
+            check(perfOutputArr, [&](const FlightPathGeometry::Segment& Seg, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, Doc29NoiseGenerator::BlockLevels& Lamax, Doc29NoiseGenerator::BlockLevels& Sel) { arrNoise.calculateArrivalNoise(Seg, 0.0, P1, P2, Block, atm, Lamax, Sel); }, arrLamaxRef, arrSelRef);
+        }
+
+        SUBCASE("Departure") {
+            check(perfOutputDep, [&](const FlightPathGeometry::Segment& Seg, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, Doc29NoiseGenerator::BlockLevels& Lamax, Doc29NoiseGenerator::BlockLevels& Sel) { depNoise.calculateDepartureNoise(Seg, 0.0, P1, P2, Block, atm, Lamax, Sel); }, depLamaxRef, depSelRef);
+        }
+    }
 }
@@ -4,51 +4,91 @@
 
 #include "Doc29Noise.h"
 
+#include "Noise/FlightPathGeometry.h"
 #include "Noise/Noise.h"
 #include "Performance/PerformanceOutput.h"
 
 namespace GRAPE {
     class Atmosphere;
-    class CoordinateSystem;
 
+    /**
+    * @brief Base class for the Doc29 noise generators. The NPD maps are copied and adjusted to the atmospheric absorption given on construction.
+    *
+    * The generator is immutable after construction, and can therefore be shared between threads calculating different operations.
+    */
     class Doc29NoiseGenerator {
     public:
-        Doc29NoiseGenerator(const NpdData& Sel, const NpdData& Lamax, const Doc29Spectrum& Spectrum, const Doc29Noise::LateralDirectivity& LateralDir);
+        Doc29NoiseGenerator(const NpdData& Sel, const NpdData& Lamax, const Doc29Spectrum& Spectrum, const Doc29Noise::LateralDirectivity& LateralDir, const AtmosphericAbsorption& AtmAbsorption);
 
         inline static double s_MaximumDistance = Constants::Inf;
 
+        typedef std::array<double, ReceptorBlock::Size> BlockLevels;
+
         /**
-        * @brief Change the NPD maps to the atmospheric absorption defined by AtmAbsorption.
+        * @return The deltas applied to the NPD maps at each standard NPD distance.
         */
-        void applyAtmosphericAbsorption(const AtmosphericAbsorption& AtmAbsorption);
-
         const NpdData::PowerNoiseLevelsArray& deltas() const { return m_Deltas; }
     protected:
         NpdData m_Sel;
         NpdData m_Lamax;
-        Doc29Spectrum m_Spectrum;
         Doc29Noise::LateralDirectivity m_LateralDir;
         NpdData::PowerNoiseLevelsArray m_Deltas{};
+
+        /**
+        * @brief NPD thrust brackets at the start and end thrust of a segment, shared by all receptors of the segment.
+        */
+        struct SegmentThrusts {
+            double Thrust1, Thrust2;
+            NpdData::ThrustBracket Sel1, Lamax1;
+            NpdData::ThrustBracket Sel2, Lamax2;
+        };
+    protected:
+        [[nodiscard]] SegmentThrusts segmentThrusts(const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2) const;
+
+        /**
+        * @return The SEL and LAMAX thrust brackets at Thrust, taken from SegThrusts if Thrust is the start or end thrust of the segment.
+        */
+        [[nodiscard]] std::pair<NpdData::ThrustBracket, NpdData::ThrustBracket> thrustBrackets(const SegmentThrusts& SegThrusts, double Thrust) const;
+
+        /**
+        * @brief NPD levels of the first Count lanes of a block at Thrust, Delta added: SEL at DistanceP, LAMAX at DistanceS and LAMAX at DistanceP.
+        */
+        void npdLevels(const SegmentThrusts& SegThrusts, double Delta, std::size_t Count, const BlockLevels& Thrust, const BlockLevels& DistanceS, const BlockLevels& DistanceP, BlockLevels& Sel, BlockLevels& Lamax, BlockLevels& LamaxP) const;
     private:
         typedef std::array<OneThirdOctaveArray, NpdStandardDistancesSize> SpectrumArray;
 
-        void calculateAtmosphericAbsorptionDeltas(const AtmosphericAbsorption& AtmAbsorption);
-        void resetAtmosphericAbsorption();
+        void calculateAtmosphericAbsorptionDeltas(const Doc29Spectrum& Spectrum, const AtmosphericAbsorption& AtmAbsorption);
     };
 
     class Doc29NoiseGeneratorArrival : public Doc29NoiseGenerator {
     public:
-        Doc29NoiseGeneratorArrival(const Doc29Noise& Doc29Ns);
+        Doc29NoiseGeneratorArrival(const Doc29Noise& Doc29Ns, const AtmosphericAbsorption& AtmAbsorption);
+
+        std::pair<double, double> calculateArrivalNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom, const Atmosphere& Atm) const;
 
-        std::pair<double, double> calculateArrivalNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const CoordinateSystem& Cs, const Atmosphere& Atm) const;
+        /**
+        * @brief Calculates the maximum level and exposure of Seg at each receptor in Block. Same results as the single receptor version.
+        * Each calculation step runs over all lanes of the block before the next one, the intersection cases are selected per lane. Receptors farther than #s_MaximumDistance are set to 0.
+        */
+        void calculateArrivalNoise(const FlightPathGeometry::Segment& Seg, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, const Atmosphere& Atm, BlockLevels& Lamax, BlockLevels& Sel) const;
+    private:
+        std::pair<double, double> calculateArrivalNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom, const SegmentThrusts& SegThrusts) const;
     };
 
     class Doc29NoiseGeneratorDeparture : public Doc29NoiseGenerator {
     public:
-        Doc29NoiseGeneratorDeparture(const Doc29Noise& Doc29Ns);
+        Doc29NoiseGeneratorDeparture(const Doc29Noise& Doc29Ns, const AtmosphericAbsorption& AtmAbsorption);
+
+        std::pair<double, double> calculateDepartureNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom, const Atmosphere& Atm) const;
 
-        std::pair<double, double> calculateDepartureNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const CoordinateSystem& Cs, const Atmosphere& Atm) const;
+        /**
+        * @brief Calculates the maximum level and exposure of Seg at each receptor in Block. Same results as the single receptor version.
+        * Each calculation step runs over all lanes of the block before the next one, the intersection cases are selected per lane. Receptors farther than #s_MaximumDistance are set to 0.
+        */
+        void calculateDepartureNoise(const FlightPathGeometry::Segment& Seg, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, const Atmosphere& Atm, BlockLevels& Lamax, BlockLevels& Sel) const;
     private:
         Doc29Noise::SORCorrection m_SOR;
+    private:
+        std::pair<double, double> calculateDepartureNoise(double Length, double Angle, double Delta, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const Receptor& Recept, const SegmentReceptorGeometry& Geom, const SegmentThrusts& SegThrusts) const;
     };
 }
@@ -0,0 +1,213 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#include "GRAPE_pch.h"
+
+#include "Doc29ProfileCache.h"
+
+#include "Doc29ProfileCalculator.h"
+
+namespace GRAPE {
+    namespace {
+        /**
+        * @return The profile interpolated point by point between Prof1 and Prof2, empty if they don't have the same points and flight phases.
+        */
+        std::optional<ProfileOutput> interpolateProfiles(const ProfileOutput& Prof1, const ProfileOutput& Prof2, double Factor) {
+            if (Prof1.size() != Prof2.size())
+                return {};
+
+            ProfileOutput outProf;
+            for (auto it1 = Prof1.begin(), it2 = Prof2.begin(); it1 != Prof1.end(); ++it1, ++it2)
+            {
+                const auto& [cumGroundDist1, p1] = *it1;
+                const auto& [cumGroundDist2, p2] = *it2;
+                if (p1.FlPhase != p2.FlPhase)
+                    return {};
+
+                outProf.addPoint(std::lerp(cumGroundDist1, cumGroundDist2, Factor), std::lerp(p1.AltitudeMsl, p2.AltitudeMsl, Factor), std::lerp(p1.TrueAirspeed, p2.TrueAirspeed, Factor), std::lerp(p1.Groundspeed, p2.Groundspeed, Factor), std::lerp(p1.Thrust, p2.Thrust, Factor), std::lerp(p1.BankAngle, p2.BankAngle, Factor), p1.FlPhase);
+            }
+
+            // Points merged by the interpolation
+            if (outProf.size() != Prof1.size())
+                return {};
+
+            return outProf;
+        }
+
+        struct ProfileDifference {
+            double Altitude = 0.0;
+            double CumulativeGroundDistance = 0.0;
+        };
+
+        /**
+        * @return The maximum differences between the points of Prof1 and Prof2, empty if they don't have the same number of points.
+        */
+        std::optional<ProfileDifference> maximumDifference(const ProfileOutput& Prof1, const ProfileOutput& Prof2) {
+            if (Prof1.size() != Prof2.size())
+                return {};
+
+            ProfileDifference outDiff;
+            for (auto it1 = Prof1.begin(), it2 = Prof2.begin(); it1 != Prof1.end(); ++it1, ++it2)
+            {
+                outDiff.Altitude = std::max(outDiff.Altitude, std::abs(it1->second.AltitudeMsl - it2->second.AltitudeMsl));
+                outDiff.CumulativeGroundDistance = std::max(outDiff.CumulativeGroundDistance, std::abs(it1->first - it2->first));
+            }
+            return outDiff;
+        }
+    }
+
+    std::shared_ptr<const ProfileOutput> Doc29ProfileCache::arrival(const Doc29ProfileArrival& Prof, const Atmosphere& Atm, const Doc29Aircraft& Doc29Acft, const Runway& Rwy, const RouteOutput& RteOutput, double Weight, double EngineCount) {
+        return get({ &Prof, &Doc29Acft, &Rwy, &RteOutput, &Atm, EngineCount, 1.0, 1.0, Weight });
+    }
+
+    std::shared_ptr<const ProfileOutput> Doc29ProfileCache::departure(const Doc29ProfileDeparture& Prof, const Atmosphere& Atm, const Doc29Aircraft& Doc29Acft, const Runway& Rwy, const RouteOutput& RteOutput, double Weight, double EngineCount, double ThrustPercentageTakeoff, double ThrustPercentageClimb) {
+        return get({ &Prof, &Doc29Acft, &Rwy, &RteOutput, &Atm, EngineCount, ThrustPercentageTakeoff, ThrustPercentageClimb, Weight });
+    }
+
+    /**
+    * Profiles are calculated outside the lock. Two threads may calculate the same profile, only the first one is kept.
+    */
+    std::shared_ptr<const ProfileOutput> Doc29ProfileCache::get(const Key& K) {
+        {
+            std::scoped_lock lck(m_Mutex);
+            if (const auto it = m_Profiles.find(K); it != m_Profiles.end())
+                return it->second;
+        }
+
+        auto prof = s_WeightTable && s_WeightTableInterval > 0.0 ? interpolate(K) : calculate(K);
+
+        std::scoped_lock lck(m_Mutex);
+        return m_Profiles.try_emplace(K, std::move(prof)).first->second;
+    }
+
+    std::shared_ptr<const ProfileOutput> Doc29ProfileCache::calculate(const Key& K) {
+        std::optional<ProfileOutput> profOutputOpt;
+        switch (K.Prof->operationType())
+        {
+        case OperationType::Arrival:
+            {
+                Doc29ProfileArrivalCalculator profCalculator(m_Cs, *K.Atm, *K.Doc29Acft, *K.Rwy, *K.RteOutput, K.Weight, K.EngineCount);
+                profOutputOpt = profCalculator.calculate(static_cast<const Doc29ProfileArrival&>(*K.Prof));
+                break;
+            }
+        case OperationType::Departure:
+            {
+                Doc29ProfileDepartureCalculator profCalculator(m_Cs, *K.Atm, *K.Doc29Acft, *K.Rwy, *K.RteOutput, K.Weight, K.EngineCount, K.ThrustPercentageTakeoff, K.ThrustPercentageClimb);
+                profOutputOpt = profCalculator.calculate(static_cast<const Doc29ProfileDeparture&>(*K.Prof));
+                break;
+            }
+        default: GRAPE_ASSERT(false); break;
+        }
+
+        if (!profOutputOpt)
+            return nullptr;
+
+        return std::make_shared<const ProfileOutput>(std::move(profOutputOpt.value()));
+    }
+
+    std::shared_ptr<const ProfileOutput> Doc29ProfileCache::interpolate(const Key& K) {
+        const double weight1 = std::floor(K.Weight / s_WeightTableInterval) * s_WeightTableInterval;
+        const double weight2 = weight1 + s_WeightTableInterval;
+
+        // No table node at 0 weight
+        if (weight1 < Constants::Precision || K.Weight - weight1 < Constants::Precision)
+            return calculate(K);
+
+        Key k1 = K;
+        k1.Weight = weight1;
+        if (!interpolable(k1, weight2))
+            return calculate(K);
+
+        Key k2 = K;
+        k2.Weight = weight2;
+
+        std::shared_ptr<const ProfileOutput> prof1, prof2;
+        {
+            std::scoped_lock lck(m_Mutex);
+            prof1 = m_Profiles.at(k1);
+            prof2 = m_Profiles.at(k2);
+        }
+
+        auto profOutputOpt = interpolateProfiles(*prof1, *prof2, (K.Weight - weight1) / s_WeightTableInterval);
+        if (!profOutputOpt)
+            return calculate(K);
+
+        return std::make_shared<const ProfileOutput>(std::move(profOutputOpt.value()));
+    }
+
+    /**
+    * The first call for an interval calculates the profiles at both ends, which are kept, and at the midpoint.
+    * The interval is interpolable if the profile interpolated at the midpoint has the same points as the exact profile.
+    */
+    bool Doc29ProfileCache::interpolable(const Key& K1, double Weight2) {
+        {
+            std::scoped_lock lck(m_Mutex);
+            if (const auto it = m_Intervals.find(K1); it != m_Intervals.end())
+                return it->second;
+        }
+
+        Key k2 = K1;
+        k2.Weight = Weight2;
+        Key kMid = K1;
+        kMid.Weight = std::midpoint(K1.Weight, Weight2);
+
+        const auto prof1 = calculate(K1);
+        const auto prof2 = calculate(k2);
+        const auto profMid = calculate(kMid);
+
+        bool canInterpolate = false;
+        if (prof1 && prof2 && profMid)
+        {
+            const auto interpolatedOpt = interpolateProfiles(*prof1, *prof2, 0.5);
+            const auto diffOpt = interpolatedOpt ? maximumDifference(*interpolatedOpt, *profMid) : std::nullopt;
+            if (diffOpt)
+            {
+                canInterpolate = true;
+                Log::models()->info("Interpolating Doc29 profile '{}' between weights {:.0f} kg and {:.0f} kg. Maximum error at {:.0f} kg: {:.2f} m altitude, {:.2f} m cumulative ground distance.", K1.Prof->Name, K1.Weight, Weight2, kMid.Weight, diffOpt->Altitude, diffOpt->CumulativeGroundDistance);
+            }
+        }
+
+        if (!canInterpolate)
+            Log::models()->info("Doc29 profile '{}' can't be interpolated between weights {:.0f} kg and {:.0f} kg, the profile points change. Profiles in this interval are calculated exactly.", K1.Prof->Name, K1.Weight, Weight2);
+
+        std::scoped_lock lck(m_Mutex);
+        m_Profiles.try_emplace(K1, prof1);
+        m_Profiles.try_emplace(k2, prof2);
+        m_Profiles.try_emplace(kMid, profMid);
+        return m_Intervals.try_emplace(K1, canInterpolate).first->second;
+    }
+
+    TEST_CASE("Doc29 Profile Weight Interpolation") {
+        ProfileOutput prof1;
+        prof1.addPoint(0.0, 100.0, 80.0, 80.0, 60000.0, 0.0, FlightPhase::TakeoffRoll);
+        prof1.addPoint(1500.0, 100.0, 85.0, 85.0, 60000.0, 0.0, FlightPhase::InitialClimb);
+        prof1.addPoint(5000.0, 600.0, 90.0, 90.0, 55000.0, 0.0, FlightPhase::Climb);
+
+        ProfileOutput prof2;
+        prof2.addPoint(0.0, 100.0, 90.0, 90.0, 70000.0, 0.0, FlightPhase::TakeoffRoll);
+        prof2.addPoint(2000.0, 100.0, 95.0, 95.0, 70000.0, 0.0, FlightPhase::InitialClimb);
+        prof2.addPoint(6000.0, 500.0, 100.0, 100.0, 65000.0, 0.0, FlightPhase::Climb);
+
+        SUBCASE("Same points") {
+            const auto interpolatedOpt = interpolateProfiles(prof1, prof2, 0.25);
+            REQUIRE(interpolatedOpt);
+            REQUIRE(interpolatedOpt->size() == 3);
+
+            const auto& [cumGroundDist, pt] = *std::next(interpolatedOpt->begin());
+            CHECK(cumGroundDist == doctest::Approx(1625.0));
+            CHECK(pt.TrueAirspeed == doctest::Approx(87.5));
+            CHECK(pt.Thrust == doctest::Approx(62500.0));
+            CHECK(pt.FlPhase == FlightPhase::InitialClimb);
+
+            const auto diffOpt = maximumDifference(prof1, *interpolatedOpt);
+            REQUIRE(diffOpt);
+            CHECK(diffOpt->Altitude == doctest::Approx(25.0));
+            CHECK(diffOpt->CumulativeGroundDistance == doctest::Approx(250.0));
+        }
+
+        SUBCASE("Different points") {
+            prof2.addPoint(8000.0, 900.0, 110.0, 110.0, 60000.0, 0.0, FlightPhase::Climb);
+            CHECK_FALSE(interpolateProfiles(prof1, prof2, 0.5));
+            CHECK_FALSE(maximumDifference(prof1, prof2));
+        }
+    }
+}
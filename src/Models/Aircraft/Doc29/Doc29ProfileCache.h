@@ -0,0 +1,81 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "Doc29Profile.h"
+
+#include "Performance/ProfileOutput.h"
+
+namespace GRAPE {
+    class CoordinateSystem;
+    class Atmosphere;
+    class Doc29Aircraft;
+    class Runway;
+    class RouteOutput;
+
+    /**
+    * @brief Thread safe cache of the ProfileOutput calculated by Doc29ProfileArrivalCalculator and Doc29ProfileDepartureCalculator.
+    *
+    * Flights with the same profile, aircraft, route, atmosphere, weight, engine count and thrust percentages share the same ProfileOutput, even if their aircraft differ in other parameters.
+    * Optionally, profiles are calculated at weights multiple of s_WeightTableInterval and interpolated for the weights in between, see s_WeightTable.
+    */
+    class Doc29ProfileCache {
+    public:
+        /**
+        * @brief If true, ProfileOutput are linearly interpolated between the two closest weights multiple of s_WeightTableInterval.
+        * The interpolation error of each interval is estimated once against the exact profile at its midpoint weight and logged.
+        * Profiles which change their points between two weights (e.g. a step is skipped) are always calculated exactly.
+        */
+        inline static bool s_WeightTable = false;
+
+        /**
+        * @brief Weight interval of the weight tables in kg.
+        */
+        inline static double s_WeightTableInterval = 1000.0;
+
+        explicit Doc29ProfileCache(const CoordinateSystem& Cs) : m_Cs(Cs) {}
+
+        /**
+        * @return The ProfileOutput of Prof, nullptr if the profile generated no points.
+        */
+        [[nodiscard]] std::shared_ptr<const ProfileOutput> arrival(const Doc29ProfileArrival& Prof, const Atmosphere& Atm, const Doc29Aircraft& Doc29Acft, const Runway& Rwy, const RouteOutput& RteOutput, double Weight, double EngineCount);
+
+        /**
+        * @return The ProfileOutput of Prof, nullptr if the profile generated no points.
+        */
+        [[nodiscard]] std::shared_ptr<const ProfileOutput> departure(const Doc29ProfileDeparture& Prof, const Atmosphere& Atm, const Doc29Aircraft& Doc29Acft, const Runway& Rwy, const RouteOutput& RteOutput, double Weight, double EngineCount, double ThrustPercentageTakeoff, double ThrustPercentageClimb);
+
+    private:
+        struct Key {
+            const Doc29Profile* Prof = nullptr;
+            const Doc29Aircraft* Doc29Acft = nullptr;
+            const Runway* Rwy = nullptr;
+            const RouteOutput* RteOutput = nullptr;
+            const Atmosphere* Atm = nullptr;
+            double EngineCount = 0.0;
+            double ThrustPercentageTakeoff = 1.0;
+            double ThrustPercentageClimb = 1.0;
+            double Weight = 0.0;
+
+            auto operator<=>(const Key&) const = default;
+        };
+
+        const CoordinateSystem& m_Cs;
+
+        std::map<Key, std::shared_ptr<const ProfileOutput>> m_Profiles;
+
+        // Weight table intervals, keyed with the weight at the start of the interval, true if the profiles can be interpolated
+        std::map<Key, bool> m_Intervals;
+
+        std::mutex m_Mutex;
+    private:
+        std::shared_ptr<const ProfileOutput> get(const Key& K);
+        std::shared_ptr<const ProfileOutput> calculate(const Key& K);
+        std::shared_ptr<const ProfileOutput> interpolate(const Key& K);
+        bool interpolable(const Key& K1, double Weight2);
+    };
+}
@@ -29,7 +29,7 @@ namespace GRAPE {
 
         // Set heading of last point to be the same as the previous
         if (size() >= 2)
-            m_Output.rbegin()->second.Heading = std::next(m_Output.rbegin())->second.Heading;
+            m_Output.back().second.Heading = std::next(m_Output.rbegin())->second.Heading;
     }
 
     double RouteOutput::turnRadius(double CumulativeGroundDistance) const {
@@ -93,7 +93,97 @@ namespace GRAPE {
         return Point{ lon, lat, PreviousPoint.Heading, PreviousPoint.Radius, PreviousPoint.Dir };
     }
 
-    std::map<double, RouteOutput::Point>::const_iterator RouteOutput::previousPoint(double CumulativeGroundDistance) const {
+    /**
+    * Each distance is interpolated from an anchor point and heading as in interpolate(const CoordinateSystem&, double), the first point with the reversed heading before the start, the last point after the end and the previous point in between.
+    * Consecutive distances with the same anchor point and heading are solved in one call to CoordinateSystem::points().
+    */
+    std::vector<RouteOutput::Point> RouteOutput::interpolate(const CoordinateSystem& Cs, std::span<const double> CumulativeGroundDistances) const {
+        GRAPE_ASSERT(!empty());
+        GRAPE_ASSERT(std::ranges::is_sorted(CumulativeGroundDistances));
+
+        std::vector<Point> outPoints;
+        outPoints.reserve(CumulativeGroundDistances.size());
+
+        // Distances waiting to be solved from the same anchor point and heading
+        std::size_t anchorIndex = 0;
+        double anchorHeading = Constants::NaN;
+        std::vector<double> anchorDistances;
+        std::vector<std::size_t> anchorOutIndexes;
+
+        auto solve = [&] {
+            if (anchorDistances.empty())
+                return;
+
+            const auto& [anchorCumDist, anchorPt] = m_Output[anchorIndex];
+            const auto coordinates = Cs.points(anchorPt.Longitude, anchorPt.Latitude, anchorDistances, anchorHeading);
+            for (std::size_t i = 0; i < coordinates.size(); ++i)
+            {
+                auto& pt = outPoints.at(anchorOutIndexes.at(i));
+                std::tie(pt.Longitude, pt.Latitude) = coordinates.at(i);
+            }
+            anchorDistances.clear();
+            anchorOutIndexes.clear();
+        };
+
+        auto addFromAnchor = [&](std::size_t AnchorIndex, double Heading, double Distance, const Point& Pt) {
+            if (AnchorIndex != anchorIndex || Heading != anchorHeading)
+            {
+                solve();
+                anchorIndex = AnchorIndex;
+                anchorHeading = Heading;
+            }
+            anchorDistances.emplace_back(Distance);
+            anchorOutIndexes.emplace_back(outPoints.size());
+            outPoints.emplace_back(Pt);
+        };
+
+        std::size_t nextIndex = 0;
+        for (const double cumGroundDist : CumulativeGroundDistances)
+        {
+            while (nextIndex < size() && m_Output[nextIndex].first < cumGroundDist)
+                ++nextIndex;
+
+            // Point is past the end, use last heading to calculate latitude and longitude
+            if (nextIndex == size())
+            {
+                const auto& [LastCumulativeGroundDistance, LastPoint] = m_Output.back();
+                addFromAnchor(size() - 1, LastPoint.Heading, std::abs(cumGroundDist - LastCumulativeGroundDistance), Point{ Constants::NaN, Constants::NaN, LastPoint.Heading, Constants::Inf, LastPoint.Dir });
+                continue;
+            }
+
+            // Point is before the start, use first point data and heading + 180 to calculate latitude longitude
+            if (nextIndex == 0)
+            {
+                const auto& [FirstCumulativeGroundDistance, FirstData] = m_Output.front();
+                addFromAnchor(0, normalizeHeading(FirstData.Heading + 180.0), std::abs(cumGroundDist - FirstCumulativeGroundDistance), Point{ Constants::NaN, Constants::NaN, FirstData.Heading, Constants::Inf, FirstData.Dir });
+                continue;
+            }
+
+            const auto& [NextCumulativeGroundDistance, NextPoint] = m_Output[nextIndex];
+            const auto& [PreviousCumulativeGroundDistance, PreviousPoint] = m_Output[nextIndex - 1];
+
+            // Point already in the container
+            if (std::abs(NextCumulativeGroundDistance - cumGroundDist) < Constants::Precision)
+            {
+                outPoints.emplace_back(NextPoint);
+                continue;
+            }
+
+            if (std::abs(PreviousCumulativeGroundDistance - cumGroundDist) < Constants::Precision)
+            {
+                outPoints.emplace_back(PreviousPoint);
+                continue;
+            }
+
+            // Point between defined route
+            addFromAnchor(nextIndex - 1, PreviousPoint.Heading, std::abs(cumGroundDist - PreviousCumulativeGroundDistance), Point{ Constants::NaN, Constants::NaN, PreviousPoint.Heading, PreviousPoint.Radius, PreviousPoint.Dir });
+        }
+        solve();
+
+        return outPoints;
+    }
+
+    FlatMap<double, RouteOutput::Point>::const_iterator RouteOutput::previousPoint(double CumulativeGroundDistance) const {
         GRAPE_ASSERT(!empty());
 
         auto it = m_Output.upper_bound(CumulativeGroundDistance); // it key is greater or equal to CumulativeGroundDistance
@@ -129,4 +219,25 @@ namespace GRAPE {
         CHECK_EQ(out.turnRadiusChange(-500.0, 3500.0), 3000.0);
         CHECK_EQ(out.turnRadiusChange(-500.0, 5000.0), 3000.0);
     }
+
+    TEST_CASE("Route Output Batch Interpolation") {
+        const Geodesic cs;
+        RouteOutput out;
+        out.addPoint(0.0, -9.13, 38.77, 30.0);
+        out.addPoint(5000.0, -9.10, 38.81, 60.0, 3000.0, RouteOutput::Direction::RightTurn);
+        out.addPoint(9000.0, -9.06, 38.83, 90.0);
+
+        constexpr std::array distances{ -1000.0, -500.0, 0.0, 1000.0, 2500.0, 5000.0, 6000.0, 9000.0, 9500.0, 12000.0 };
+        const auto points = out.interpolate(cs, distances);
+        REQUIRE(points.size() == distances.size());
+        for (std::size_t i = 0; i < distances.size(); ++i)
+        {
+            const auto pt = out.interpolate(cs, distances.at(i));
+            CHECK(points.at(i).Longitude == doctest::Approx(pt.Longitude).epsilon(Constants::PrecisionTest));
+            CHECK(points.at(i).Latitude == doctest::Approx(pt.Latitude).epsilon(Constants::PrecisionTest));
+            CHECK(points.at(i).Heading == doctest::Approx(pt.Heading));
+            CHECK(points.at(i).Radius == pt.Radius);
+            CHECK(points.at(i).Dir == pt.Dir);
+        }
+    }
 }
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <span>
+
 namespace GRAPE {
     class CoordinateSystem;
     class Runway;
@@ -9,7 +11,7 @@ namespace GRAPE {
     /**
     * @brief Output class of route calculations.
     *
-    * The output is implemented as a map with the cumulative ground distance as key.
+    * The output is implemented as a flat map with the cumulative ground distance as key, points are stored contiguously.
     * Departures: 0 cumulative distance at departure threshold and positive cumulative distance afterwards.
     * Arrivals: 0 cumulative distance at arrival threshold and negative cumulative distance before.
     */
@@ -47,20 +49,22 @@ namespace GRAPE {
         * Arrivals: The runway threshold.
         * Departures: the last point.
         *
+        * Returned by copy as adding points invalidates references.
         * ASSERT !empty().
         */
-        [[nodiscard]] const auto& lastPoint() const noexcept { GRAPE_ASSERT(!empty()); return *m_Output.rbegin(); }
+        [[nodiscard]] std::pair<double, Point> lastPoint() const noexcept { GRAPE_ASSERT(!empty()); return m_Output.back(); }
 
         /**
         * Arrivals: The first point.
         * Departures: the runway threshold.
         *
+        * Returned by copy as adding points invalidates references.
         * ASSERT !empty().
         */
-        [[nodiscard]] const auto& firstPoint() const noexcept { GRAPE_ASSERT(!empty()); return *m_Output.begin(); }
+        [[nodiscard]] std::pair<double, Point> firstPoint() const noexcept { GRAPE_ASSERT(!empty()); return m_Output.front(); }
 
         [[nodiscard]] const auto& points() const noexcept { return m_Output; }
-        [[nodiscard]] const auto& point(std::size_t Index) const noexcept { GRAPE_ASSERT(Index < size()); return *std::next(m_Output.begin(), Index); }
+        [[nodiscard]] const auto& point(std::size_t Index) const noexcept { GRAPE_ASSERT(Index < size()); return m_Output[Index]; }
 
         [[nodiscard]] auto begin() const noexcept { return m_Output.begin(); }
         [[nodiscard]] auto end() const noexcept { return m_Output.end(); }
@@ -113,14 +117,22 @@ namespace GRAPE {
         * ASSERT !empty().
         */
         [[nodiscard]] Point interpolate(const CoordinateSystem& Cs, double CumulativeGroundDistance) const;
+
+        /**
+        * @brief Same as interpolate(const CoordinateSystem&, double) for each of the CumulativeGroundDistances, which must be sorted in ascending order.
+        * The points are walked once instead of searched for each distance, and the coordinates of all distances starting from the same point are solved together with CoordinateSystem::points().
+        *
+        * ASSERT !empty().
+        */
+        [[nodiscard]] std::vector<Point> interpolate(const CoordinateSystem& Cs, std::span<const double> CumulativeGroundDistances) const;
     private:
         /**
         * @return The previous point to CumulativeGroundDistance in the container or the first point, if CumulativeGroundDistance is smaller than the point with the lowest cumulative ground distance value.
         *
         * ASSERT !empty().
         */
-        [[nodiscard]] std::map<double, Point>::const_iterator previousPoint(double CumulativeGroundDistance) const;
+        [[nodiscard]] FlatMap<double, Point>::const_iterator previousPoint(double CumulativeGroundDistance) const;
     private:
-        std::map<double, Point> m_Output; ///< Key is cumulative ground distance.
+        FlatMap<double, Point> m_Output; ///< Key is cumulative ground distance.
     };
 }
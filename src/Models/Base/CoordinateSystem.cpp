@@ -54,6 +54,23 @@ namespace GRAPE {
         return std::make_pair(lon2, lat2);
     }
 
+    std::vector<std::pair<double, double>> LocalCartesian::points(double Longitude1, double Latitude1, std::span<const double> Distances, double Heading) const {
+        std::vector<std::pair<double, double>> outPoints;
+        outPoints.reserve(Distances.size());
+
+        double p1X, p1Y, z;
+        m_LocalCartesian.Forward(Latitude1, Longitude1, 0, p1X, p1Y, z);
+        const double sinHdg = std::sin(toRadians(Heading));
+        const double cosHdg = std::cos(toRadians(Heading));
+        for (const double dist : Distances)
+        {
+            double lon2, lat2;
+            m_LocalCartesian.Reverse(p1X + dist * sinHdg, p1Y + dist * cosHdg, 0, lat2, lon2, z);
+            outPoints.emplace_back(lon2, lat2);
+        }
+        return outPoints;
+    }
+
     /**
     * Converts point 1 to cartesian
     * Calculates point 2 coordinates with sinus and cosine of the heading
@@ -102,6 +119,12 @@ namespace GRAPE {
         return { lonI, latI, intersectionLoc };
     }
 
+    std::pair<double, double> LocalCartesian::forward(double Longitude, double Latitude) const {
+        double x, y, z;
+        m_LocalCartesian.Forward(Latitude, Longitude, 0.0, x, y, z);
+        return { x, y };
+    }
+
     std::pair<double, double> LocalCartesian::reverse(double X, double Y) const {
         double lon, lat, alt;
         m_LocalCartesian.Reverse(X, Y, 0.0, lon, lat, alt);
@@ -189,6 +212,24 @@ namespace GRAPE {
         return std::make_pair(lon2, lat2);
     }
 
+    /**
+    * Direct problem
+    * The geodesic line is set up once and each point is a position along it, which skips the per call setup of Direct.
+    */
+    std::vector<std::pair<double, double>> Geodesic::points(double Longitude1, double Latitude1, std::span<const double> Distances, double Heading) const {
+        std::vector<std::pair<double, double>> outPoints;
+        outPoints.reserve(Distances.size());
+
+        const GeographicLib::GeodesicLine line = m_Geodesic.Line(Latitude1, Longitude1, Heading, GeographicLib::Geodesic::LATITUDE | GeographicLib::Geodesic::LONGITUDE | GeographicLib::Geodesic::DISTANCE_IN);
+        for (const double dist : Distances)
+        {
+            double lon2, lat2;
+            line.Position(dist, lat2, lon2);
+            outPoints.emplace_back(lon2, lat2);
+        }
+        return outPoints;
+    }
+
     /**
     * Inverse problem
     * Determines point 2 based on distance and heading from point 1. Returns lat and lon of calculated point, and its heading.
@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <span>
+
 #pragma warning ( push )
 #pragma warning ( disable : GRAPE_VENDOR_WARNINGS )
 #include "GeographicLib/Geodesic.hpp"
+#include "GeographicLib/GeodesicLine.hpp"
 #include "GeographicLib/LocalCartesian.hpp"
 #pragma warning ( pop )
 
@@ -70,6 +73,12 @@ namespace GRAPE {
         */
         [[nodiscard]] virtual std::pair<double, double> point(double Longitude1, double Latitude1, double Distance, double Heading) const = 0;
 
+        /**
+        * @brief Same as point() for several distances along the same Heading from point 1, solved together.
+        * @return Longitude, Latitude for each of the Distances.
+        */
+        [[nodiscard]] virtual std::vector<std::pair<double, double>> points(double Longitude1, double Latitude1, std::span<const double> Distances, double Heading) const = 0;
+
         /**
         * @return Longitude, Latitude and HeadingEnd of the point at Distance and HeadingStart from point 1 (direct problem).
         */
@@ -149,6 +158,12 @@ namespace GRAPE {
         */
         [[nodiscard]] std::pair<double, double> point(double Longitude1, double Latitude1, double Distance, double Heading) const override;
 
+        /**
+        * @brief Converts point 1 and the heading once for all Distances.
+        * @return Longitude, Latitude for each of the Distances.
+        */
+        [[nodiscard]] std::vector<std::pair<double, double>> points(double Longitude1, double Latitude1, std::span<const double> Distances, double Heading) const override;
+
         /**
         * @brief Solution of the direct problem.
         * @return Longitude, Latitude, HeadingEnd.
@@ -160,6 +175,12 @@ namespace GRAPE {
         */
         [[nodiscard]] std::tuple<double, double, Intersection> intersection(double Longitude1, double Latitude1, double Longitude2, double Latitude2, double Longitude3, double Latitude3) const override;
 
+        /**
+        * @brief Converts a pair of WGS84 coordinates at zero altitude to the local cartesian system.
+        * @return X (east), Y (north).
+        */
+        [[nodiscard]] std::pair<double, double> forward(double Longitude, double Latitude) const;
+
         /**
         * @brief Converts a pair of coordinates in the local cartesian system to longitude latitude in the WGS84.
         * @return Longitude, Latitude.
@@ -232,6 +253,12 @@ namespace GRAPE {
         */
         [[nodiscard]] std::pair<double, double> point(double Longitude1, double Latitude1, double Distance, double Heading) const override;
 
+        /**
+        * @brief Solution of the direct problem for several distances on the geodesic line starting at point 1 with Heading. The line is set up once.
+        * @return Longitude, Latitude for each of the Distances.
+        */
+        [[nodiscard]] std::vector<std::pair<double, double>> points(double Longitude1, double Latitude1, std::span<const double> Distances, double Heading) const override;
+
         /**
         * @brief Solution of the direct problem.
         * @return Longitude, Latitude, HeadingEnd.
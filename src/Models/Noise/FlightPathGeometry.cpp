@@ -0,0 +1,133 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#include "GRAPE_pch.h"
+
+#include "FlightPathGeometry.h"
+
+namespace GRAPE {
+    SegmentReceptorGeometry FlightPathGeometry::Segment::receptorGeometry(double X, double Y) const {
+        // Vector P1 Receptor
+        const double p1rX = X - X1;
+        const double p1rY = Y - Y1;
+
+        return receptorGeometry(std::hypot(p1rX, p1rY), std::hypot(X - X2, Y - Y2), p1rX * DirectionX + p1rY * DirectionY, DirectionX * p1rY - DirectionY * p1rX);
+    }
+
+    void FlightPathGeometry::Segment::receptorGeometry(const ReceptorBlock& Block, SegmentReceptorGeometryBlock& Geom) const {
+        for (std::size_t i = 0; i < ReceptorBlock::Size; ++i)
+        {
+            const double p1rX = Block.X[i] - X1;
+            const double p1rY = Block.Y[i] - Y1;
+            const double p2rX = Block.X[i] - X2;
+            const double p2rY = Block.Y[i] - Y2;
+
+            Geom.Distance1[i] = std::sqrt(p1rX * p1rX + p1rY * p1rY);
+            Geom.Distance2[i] = std::sqrt(p2rX * p2rX + p2rY * p2rY);
+            Geom.Along[i] = p1rX * DirectionX + p1rY * DirectionY;
+            Geom.Cross[i] = DirectionX * p1rY - DirectionY * p1rX;
+        }
+    }
+
+    SegmentReceptorGeometry FlightPathGeometry::Segment::receptorGeometry(const SegmentReceptorGeometryBlock& Geom, std::size_t Lane) const {
+        return receptorGeometry(Geom.Distance1.at(Lane), Geom.Distance2.at(Lane), Geom.Along.at(Lane), Geom.Cross.at(Lane));
+    }
+
+    /**
+    * Same 5 cm precision as the coordinate systems when classifying the intersection.
+    */
+    SegmentReceptorGeometry FlightPathGeometry::Segment::receptorGeometry(double Distance1, double Distance2, double Along, double Cross) const {
+        SegmentReceptorGeometry outGeom;
+
+        outGeom.Distance1 = Distance1;
+        outGeom.Distance2 = Distance2;
+
+        outGeom.GroundLengthQ = std::abs(Along);
+        outGeom.GroundDistanceP = GroundLength < Constants::Precision ? Distance1 : std::abs(Cross);
+
+        outGeom.IntersectionType = CoordinateSystem::Intersection::Behind;
+        if (Along > -0.05)
+            outGeom.IntersectionType = Along < GroundLength + 0.05 ? CoordinateSystem::Intersection::Between : CoordinateSystem::Intersection::Ahead;
+
+        outGeom.TurnDirection = Cross > 0.0 ? -1 : 1;
+
+        return outGeom;
+    }
+
+    FlightPathGeometry::FlightPathGeometry(const LocalCartesian& Frame, const PerformanceOutput& PerfOutput) {
+        if (PerfOutput.size() < 2)
+            return;
+
+        m_Segments.reserve(PerfOutput.size() - 1);
+
+        auto& [initCumulativeGroundDistance, initPoint] = *PerfOutput.begin();
+        auto [x1, y1] = Frame.forward(initPoint.Longitude, initPoint.Latitude);
+        double cumulativeGroundDistance1 = initCumulativeGroundDistance;
+        double altitudeMsl1 = initPoint.AltitudeMsl;
+
+        for (auto it = std::next(PerfOutput.begin(), 1); it != PerfOutput.end(); ++it)
+        {
+            auto& [cumulativeGroundDistance2, point2] = *it;
+            const auto [x2, y2] = Frame.forward(point2.Longitude, point2.Latitude);
+
+            const double groundLength = cumulativeGroundDistance2 - cumulativeGroundDistance1;
+            const double verticalLength = point2.AltitudeMsl - altitudeMsl1;
+
+            const double localGroundLength = std::hypot(x2 - x1, y2 - y1);
+            const double dirX = localGroundLength < Constants::Precision ? 0.0 : (x2 - x1) / localGroundLength;
+            const double dirY = localGroundLength < Constants::Precision ? 0.0 : (y2 - y1) / localGroundLength;
+
+            m_Segments.emplace_back(x1, y1, x2, y2, dirX, dirY, localGroundLength, std::hypot(groundLength, verticalLength), std::atan(verticalLength / groundLength));
+
+            x1 = x2;
+            y1 = y2;
+            cumulativeGroundDistance1 = cumulativeGroundDistance2;
+            altitudeMsl1 = point2.AltitudeMsl;
+        }
+    }
+
+    TEST_CASE("Flight Path Geometry") {
+        const Geodesic cs;
+        const LocalCartesian frame(-9.13, 38.77);
+
+        PerformanceOutput perfOutput;
+        const double lon1 = -9.35, lat1 = 38.70;
+        const double lon2 = -9.00, lat2 = 38.82;
+        const double groundLength = cs.distance(lon1, lat1, lon2, lat2);
+        perfOutput.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::Climb, 0.0, lon1, lat1, 100.0, 80.0, 80.0, 50000.0, 0.0);
+        perfOutput.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::Climb, groundLength, lon2, lat2, 1100.0, 90.0, 90.0, 50000.0, 0.0);
+
+        const FlightPathGeometry geom(frame, perfOutput);
+        REQUIRE(geom.size() == 1);
+        const auto& seg = geom.segment(0);
+        CHECK(seg.GroundLength == doctest::Approx(groundLength).epsilon(1e-4));
+        CHECK(seg.Angle == doctest::Approx(std::atan(1000.0 / groundLength)));
+
+        // Receptors up to about 40 km from the frame origin, ground distances within 2 m of the geodesic solution
+        constexpr double tolerance = 2.0;
+        for (int i = -4; i <= 4; ++i)
+        {
+            for (int j = -4; j <= 4; ++j)
+            {
+                const double lon = -9.13 + i * 0.1;
+                const double lat = 38.77 + j * 0.08;
+                const auto [x, y] = frame.forward(lon, lat);
+                const auto receptGeom = seg.receptorGeometry(x, y);
+
+                const auto [lonP, latP, intersectType] = cs.intersection(lon1, lat1, lon2, lat2, lon, lat);
+                const double groundDistP = cs.distance(lon, lat, lonP, latP);
+                const double groundLengthQ = cs.distance(lon1, lat1, lonP, latP);
+
+                CHECK(std::abs(receptGeom.Distance1 - cs.distance(lon, lat, lon1, lat1)) < tolerance);
+                CHECK(std::abs(receptGeom.Distance2 - cs.distance(lon, lat, lon2, lat2)) < tolerance);
+                CHECK(std::abs(receptGeom.GroundDistanceP - groundDistP) < tolerance);
+                CHECK(std::abs(receptGeom.GroundLengthQ - groundLengthQ) < tolerance);
+
+                if (groundDistP > tolerance)
+                    CHECK(receptGeom.TurnDirection == cs.turnDirection(lon1, lat1, lon2, lat2, lon, lat));
+
+                if (groundLengthQ > tolerance && std::abs(groundLengthQ - groundLength) > tolerance)
+                    CHECK(receptGeom.IntersectionType == intersectType);
+            }
+        }
+    }
+}
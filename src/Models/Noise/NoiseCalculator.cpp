@@ -17,14 +17,16 @@ namespace GRAPE {
         return m_PerfSpec.Atmospheres.atmosphere(Op.Time);
     }
 
-    AtmosphericAbsorption NoiseCalculator::atmosphericAbsorption(const Operation& Op)const {
-        const Atmosphere& atm = atmosphere(Op);
+    AtmosphericAbsorption NoiseCalculator::atmosphericAbsorption(const Operation& Op) const {
+        return atmosphericAbsorption(atmosphere(Op));
+    }
 
+    AtmosphericAbsorption NoiseCalculator::atmosphericAbsorption(const Atmosphere& Atm) const {
         switch (m_NsSpec.AtmAbsorptionType)
         {
         case AtmosphericAbsorption::Type::None: return AtmosphericAbsorption(); break;
-        case AtmosphericAbsorption::Type::SaeArp866: return AtmosphericAbsorption(atm.seaLevelTemperature(), atm.relativeHumidity());
-        case AtmosphericAbsorption::Type::SaeArp5534: return AtmosphericAbsorption(atm.seaLevelTemperature(), atm.seaLevelPressure(), atm.relativeHumidity()); break;
+        case AtmosphericAbsorption::Type::SaeArp866: return AtmosphericAbsorption(Atm.seaLevelTemperature(), Atm.relativeHumidity());
+        case AtmosphericAbsorption::Type::SaeArp5534: return AtmosphericAbsorption(Atm.seaLevelTemperature(), Atm.seaLevelPressure(), Atm.relativeHumidity()); break;
         default: GRAPE_ASSERT(false); break;
         }
 
@@ -34,6 +34,7 @@ namespace GRAPE {
         std::vector<ReceptorIndexed> m_ReceptorOutput;
     protected:
         const Atmosphere& atmosphere(const Operation& Op) const;
-        AtmosphericAbsorption atmosphericAbsorption(const Operation& Op)const;
+        AtmosphericAbsorption atmosphericAbsorption(const Operation& Op) const;
+        AtmosphericAbsorption atmosphericAbsorption(const Atmosphere& Atm) const;
     };
 }
@@ -6,166 +6,205 @@
 
 #include "Aircraft/Doc29/Doc29Noise.h"
 
-#include <execution>
-
 namespace GRAPE {
     namespace {
-        struct SegmentData {
-            SegmentData(double LengthIn, double AngleIn) : Length(LengthIn), Angle(AngleIn) {}
-            double Length; // Greater or equal to 0
-            double Angle; // Between -90 and 90
-        };
+        /**
+        * @brief The local frame of a LocalCartesian coordinate system is used as is. Otherwise centered at the receptors.
+        */
+        LocalCartesian localFrame(const CoordinateSystem& Cs, const ReceptorOutput& ReceptOutput) {
+            if (Cs.type() == CoordinateSystem::Type::LocalCartesian)
+                return static_cast<const LocalCartesian&>(Cs);
+
+            if (ReceptOutput.empty())
+                return LocalCartesian(0.0, 0.0);
+
+            ReceptorGrid::BoundingBox bounds;
+            for (const auto& recept : ReceptOutput)
+                bounds.add(recept.Longitude, recept.Latitude);
 
-        std::vector<SegmentData> constantSegmentData(const PerformanceOutput& PerfOutput) {
-            std::vector<SegmentData> outSegData;
-            outSegData.reserve(PerfOutput.size() - 1);
+            return LocalCartesian(std::midpoint(bounds.LongitudeMin, bounds.LongitudeMax), std::midpoint(bounds.LatitudeMin, bounds.LatitudeMax));
+        }
+
+        /**
+        * @brief Bounding boxes of the segments of PerfOutput, expanded by the Doc29 maximum segment distance.
+        */
+        std::vector<ReceptorGrid::BoundingBox> segmentBoundingBoxes(const PerformanceOutput& PerfOutput) {
+            std::vector<ReceptorGrid::BoundingBox> outBoxes;
+            outBoxes.reserve(PerfOutput.size() - 1);
 
             for (auto it = std::next(PerfOutput.begin(), 1); it != PerfOutput.end(); ++it)
             {
-                auto& [CumulativeGroundDistance1, Point1] = *std::prev(it, 1);
-                auto& [CumulativeGroundDistance2, Point2] = *it;
-                const double groundLength = CumulativeGroundDistance2 - CumulativeGroundDistance1;
-                const double verticalLength = Point2.AltitudeMsl - Point1.AltitudeMsl;
-                outSegData.emplace_back(std::hypot(groundLength, verticalLength), std::atan(verticalLength / groundLength));
+                auto& [unused1, Point1] = *std::prev(it, 1);
+                auto& [unused2, Point2] = *it;
+                ReceptorGrid::BoundingBox& box = outBoxes.emplace_back();
+                box.add(Point1.Longitude, Point1.Latitude);
+                box.add(Point2.Longitude, Point2.Latitude);
+                box.expand(Doc29NoiseGenerator::s_MaximumDistance);
             }
 
-            return outSegData;
+            return outBoxes;
         }
     }
 
-    NoiseCalculatorDoc29::NoiseCalculatorDoc29(const PerformanceSpecification& PerfSpec, const NoiseSpecification& NsSpec, const ReceptorOutput& ReceptOutput) : NoiseCalculator(PerfSpec, NsSpec, ReceptOutput) {}
-
-    NoiseSingleEventOutput NoiseCalculatorDoc29::calculateArrivalNoise(const OperationArrival& Op, const PerformanceOutput& PerfOutput) {
-        GRAPE_ASSERT(m_ArrivalGenerators.contains(Op.aircraft().Doc29Ns));
-
-        auto& arrGen = m_ArrivalGenerators(Op.aircraft().Doc29Ns);
-        arrGen.applyAtmosphericAbsorption(atmosphericAbsorption(Op));
-        const auto& atm = atmosphere(Op);
+    NoiseCalculatorDoc29::NoiseCalculatorDoc29(const PerformanceSpecification& PerfSpec, const NoiseSpecification& NsSpec, const ReceptorOutput& ReceptOutput) : NoiseCalculator(PerfSpec, NsSpec, ReceptOutput), m_ReceptorGrid(ReceptOutput), m_Frame(localFrame(m_Cs, ReceptOutput)) {
+        m_ReceptorPositions.reserve(ReceptOutput.size());
+        for (const auto& recept : ReceptOutput)
+            m_ReceptorPositions.emplace_back(m_Frame.forward(recept.Longitude, recept.Latitude));
+    }
 
+    /**
+    * Receptors are processed in blocks of ReceptorBlock::Size, in parallel.
+    * For each block the segments are iterated in order, and the noise levels of each segment are accumulated per receptor.
+    */
+    template<typename SegmentNoise>
+    NoiseSingleEventOutput NoiseCalculatorDoc29::calculateNoise(const Atmosphere& Atm, const PerformanceOutput& PerfOutput, const SegmentNoise& SegNoise) const {
         NoiseSingleEventOutput outNoise;
         outNoise.fill(m_ReceptorOutput.size());
 
-        // Constant segment data
-        const auto segData = constantSegmentData(PerfOutput);
+        // Segment geometry in the local frame
+        const FlightPathGeometry flightPath(m_Frame, PerfOutput);
+        const auto& points = PerfOutput.points();
 
-        // Iterate through receptors
-        std::for_each(std::execution::par, m_ReceptorOutput.begin(), m_ReceptorOutput.end(), [this, &atm, &PerfOutput, &arrGen, &segData, &Op, &outNoise](const ReceptorIndexed& ReceptIndexed) {
-            std::size_t index = ReceptIndexed.Index;
-            const Receptor& recept = ReceptIndexed.Recept;
+        // Receptor dependent correction factors
+        auto impedanceCorrection = [&](const Receptor& Recept) { return 10 * std::log10(416.86 / 409.81 * Atm.pressureRatio(Recept.Elevation) / std::sqrt(Atm.temperatureRatio(Recept.Elevation))); };
 
-            double laMax = 0.0;
-            double sel = 0.0;
+        // Receptors outside the bounding box of a segment are too far from it
+        const bool cull = cullSegments();
+        std::vector<ReceptorGrid::BoundingBox> segBoxes;
+        std::vector<std::size_t> receptIndexes;
+        if (cull)
+        {
+            segBoxes = segmentBoundingBoxes(PerfOutput);
+            ReceptorGrid::BoundingBox opBox;
+            for (const auto& box : segBoxes)
+                opBox.add(box);
 
-            // Impedance corrections
-            double corrImpedance = 10 * std::log10(416.86 / 409.81 * atm.pressureRatio(recept.Elevation) / std::sqrt(atm.temperatureRatio(recept.Elevation)));
+            receptIndexes = m_ReceptorGrid.query(opBox);
 
-            // Iterate through flight path
-            auto& [unused1, pInit] = *PerfOutput.begin();
-            std::reference_wrapper p1 = pInit;
+            // All segments too far, each contributes 0 dB before receptor dependent corrections
+            std::vector<char> candidates(m_ReceptorOutput.size(), false);
+            for (std::size_t i : receptIndexes)
+                candidates.at(i) = true;
 
-            for (auto it = std::next(PerfOutput.begin(), 1); it != PerfOutput.end(); ++it)
+            for (const auto& [recept, index] : m_ReceptorOutput)
             {
-                auto& [unused2, p2] = *it;
-                const std::size_t segIndex = std::distance(PerfOutput.begin(), it) - 1;
+                if (candidates.at(index))
+                    continue;
 
-                // Performance output dependent correction factors
-                auto [laMaxSeg, selSeg] = arrGen.calculateArrivalNoise(segData.at(segIndex).Length, segData.at(segIndex).Angle, Op.aircraft().Doc29NoiseDeltaArrivals, p1, p2, recept, m_Cs, atm);
+                const double corrImpedance = impedanceCorrection(recept);
+                outNoise.setValues(index, std::max(0.0, corrImpedance), 10.0 * std::log10(static_cast<double>(flightPath.size())) + corrImpedance);
+            }
+        }
+        else
+        {
+            receptIndexes.resize(m_ReceptorOutput.size());
+            std::iota(receptIndexes.begin(), receptIndexes.end(), std::size_t{ 0 });
+        }
 
-                // Receptor dependent correction factors
-                laMaxSeg += corrImpedance;
-                selSeg += corrImpedance;
+        // Nested in the operation task, the blocks are shared with the idle workers of the pool
+        const std::size_t blockCount = (receptIndexes.size() + ReceptorBlock::Size - 1) / ReceptorBlock::Size;
+        ThreadPool::get().parallelFor(blockCount, [&](std::size_t BlockIndex) {
+            ReceptorBlock block;
+            std::array<std::size_t, ReceptorBlock::Size> indexes{};
+            std::array<double, ReceptorBlock::Size> corrImpedance{};
+            for (std::size_t i = BlockIndex * ReceptorBlock::Size; i < std::min((BlockIndex + 1) * ReceptorBlock::Size, receptIndexes.size()); ++i)
+            {
+                const std::size_t index = receptIndexes.at(i);
+                const Receptor& recept = m_ReceptorOutput.at(index).Recept;
+                indexes.at(block.Count) = index;
+                std::tie(block.X.at(block.Count), block.Y.at(block.Count)) = m_ReceptorPositions.at(index);
+                block.Receptors.at(block.Count) = &recept;
+                corrImpedance.at(block.Count) = impedanceCorrection(recept);
+                ++block.Count;
+            }
 
-                // Update operation noise
-                laMax = std::max(laMax, laMaxSeg);
-                sel = sel + std::pow(10.0, selSeg / 10.0);
+            Doc29NoiseGenerator::BlockLevels laMax{};
+            Doc29NoiseGenerator::BlockLevels selEnergy{};
+            Doc29NoiseGenerator::BlockLevels laMaxSeg{};
+            Doc29NoiseGenerator::BlockLevels selSeg{};
 
-                // Prepare next segment
-                p1 = p2;
+            // Iterate through flight path
+            for (std::size_t segIndex = 0; segIndex < flightPath.size(); ++segIndex)
+            {
+                const bool blockTooFar = cull && std::ranges::none_of(block.Receptors | std::views::take(block.Count), [&](const Receptor* Recept) { return segBoxes.at(segIndex).contains(Recept->Longitude, Recept->Latitude); });
+                if (blockTooFar)
+                {
+                    laMaxSeg.fill(0.0);
+                    selSeg.fill(0.0);
+                }
+                else
+                {
+                    SegNoise(flightPath.segment(segIndex), points[segIndex].second, points[segIndex + 1].second, block, laMaxSeg, selSeg);
+                }
+
+                // Update operation noise
+                for (std::size_t lane = 0; lane < block.Count; ++lane)
+                {
+                    laMax.at(lane) = std::max(laMax.at(lane), laMaxSeg.at(lane) + corrImpedance.at(lane));
+                    selEnergy.at(lane) += std::pow(10.0, (selSeg.at(lane) + corrImpedance.at(lane)) / 10.0);
+                }
             }
 
-            sel = 10.0 * std::log10(sel);
+            for (std::size_t lane = 0; lane < block.Count; ++lane)
+            {
+                const double sel = 10.0 * std::log10(selEnergy.at(lane));
 
-            GRAPE_ASSERT(!std::isnan(laMax));
-            GRAPE_ASSERT(!std::isnan(sel));
+                GRAPE_ASSERT(!std::isnan(laMax.at(lane)));
+                GRAPE_ASSERT(!std::isnan(sel));
 
-            outNoise.setValues(index, laMax, sel);
+                outNoise.setValues(indexes.at(lane), laMax.at(lane), sel);
+            }
             }
         );
 
         return outNoise;
     }
 
-    NoiseSingleEventOutput NoiseCalculatorDoc29::calculateDepartureNoise(const OperationDeparture& Op, const PerformanceOutput& PerfOutput) {
-        GRAPE_ASSERT(m_DepartureGenerators.contains(Op.aircraft().Doc29Ns));
-
-        auto& depGen = m_DepartureGenerators(Op.aircraft().Doc29Ns);
-        depGen.applyAtmosphericAbsorption(atmosphericAbsorption(Op));
+    NoiseSingleEventOutput NoiseCalculatorDoc29::calculateArrivalNoise(const OperationArrival& Op, const PerformanceOutput& PerfOutput) {
         const auto& atm = atmosphere(Op);
+        GRAPE_ASSERT(m_ArrivalGenerators.contains({ Op.aircraft().Doc29Ns, &atm }));
 
-        NoiseSingleEventOutput outNoise;
-        outNoise.fill(m_ReceptorOutput.size());
-
-        // Constant segment data
-        const auto segData = constantSegmentData(PerfOutput);
-
-        // Iterate through receptors
-        std::for_each(std::execution::par, m_ReceptorOutput.begin(), m_ReceptorOutput.end(), [this, &atm, &PerfOutput, &depGen, &segData, &Op, &outNoise](const ReceptorIndexed& ReceptIndexed) {
-            std::size_t index = ReceptIndexed.Index;
-            const Receptor& recept = ReceptIndexed.Recept;
-
-            double laMax = 0.0;
-            double sel = 0.0;
-
-            // Impedance correction
-            double corrImpedance = 10 * std::log10(416.86 / 409.81 * atm.pressureRatio(recept.Elevation) / std::sqrt(atm.temperatureRatio(recept.Elevation)));
-
-            // Iterate through flight path
-            auto& [pnused1, pInit] = *PerfOutput.begin();
-            std::reference_wrapper p1 = pInit;
-
-            for (auto it = std::next(PerfOutput.begin(), 1); it != PerfOutput.end(); ++it)
-            {
-                auto& [unused, p2] = *it;
-                const std::size_t segIndex = std::distance(PerfOutput.begin(), it) - 1;
-
-                // Performance output dependent correction factors
-                auto [laMaxSeg, selSeg] = depGen.calculateDepartureNoise(segData.at(segIndex).Length, segData.at(segIndex).Angle, Op.aircraft().Doc29NoiseDeltaDepartures, p1, p2, recept, m_Cs, atm);
-
-                // Receptor dependent correction factors
-                laMaxSeg += corrImpedance;
-                selSeg += corrImpedance;
-
-                // Update operation noise
-                laMax = std::max(laMax, laMaxSeg);
-                sel = sel + std::pow(10.0, selSeg / 10.0);
+        const auto& arrGen = m_ArrivalGenerators({ Op.aircraft().Doc29Ns, &atm });
+        const double delta = Op.aircraft().Doc29NoiseDeltaArrivals;
 
-                // Prepare next segment
-                p1 = p2;
+        return calculateNoise(atm, PerfOutput, [&](const FlightPathGeometry::Segment& Seg, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, Doc29NoiseGenerator::BlockLevels& Lamax, Doc29NoiseGenerator::BlockLevels& Sel) {
+            arrGen.calculateArrivalNoise(Seg, delta, P1, P2, Block, atm, Lamax, Sel);
             }
+        );
+    }
 
-            sel = 10.0 * std::log10(sel);
+    NoiseSingleEventOutput NoiseCalculatorDoc29::calculateDepartureNoise(const OperationDeparture& Op, const PerformanceOutput& PerfOutput) {
+        const auto& atm = atmosphere(Op);
+        GRAPE_ASSERT(m_DepartureGenerators.contains({ Op.aircraft().Doc29Ns, &atm }));
 
-            GRAPE_ASSERT(!std::isnan(laMax));
-            GRAPE_ASSERT(!std::isnan(sel));
+        const auto& depGen = m_DepartureGenerators({ Op.aircraft().Doc29Ns, &atm });
+        const double delta = Op.aircraft().Doc29NoiseDeltaDepartures;
 
-            outNoise.setValues(index, laMax, sel);
+        return calculateNoise(atm, PerfOutput, [&](const FlightPathGeometry::Segment& Seg, const PerformanceOutput::Point& P1, const PerformanceOutput::Point& P2, const ReceptorBlock& Block, Doc29NoiseGenerator::BlockLevels& Lamax, Doc29NoiseGenerator::BlockLevels& Sel) {
+            depGen.calculateDepartureNoise(Seg, delta, P1, P2, Block, atm, Lamax, Sel);
             }
         );
+    }
 
-        return outNoise;
+    bool NoiseCalculatorDoc29::cullSegments() const {
+        return m_Cs.type() == CoordinateSystem::Type::Geodesic && Doc29NoiseGenerator::s_MaximumDistance < Constants::Inf && !m_ReceptorOutput.empty();
     }
 
-    void NoiseCalculatorDoc29::addDoc29NoiseArrival(const Doc29Noise* Doc29Ns) {
-        if (m_ArrivalGenerators.contains(Doc29Ns))
+    void NoiseCalculatorDoc29::addDoc29NoiseArrival(const OperationArrival& Op) {
+        const Doc29Noise* doc29Ns = Op.aircraft().Doc29Ns;
+        const Atmosphere& atm = atmosphere(Op);
+        if (m_ArrivalGenerators.contains({ doc29Ns, &atm }))
             return;
 
-        m_ArrivalGenerators.add(Doc29Ns, *Doc29Ns); // Forwards Doc29Noise to Doc29NoiseGeneratorArrival constructor
+        m_ArrivalGenerators.add({ doc29Ns, &atm }, *doc29Ns, atmosphericAbsorption(atm)); // Forwards Doc29Noise and AtmosphericAbsorption to Doc29NoiseGeneratorArrival constructor
     }
 
-    void NoiseCalculatorDoc29::addDoc29NoiseDeparture(const Doc29Noise* Doc29Ns) {
-        if (m_DepartureGenerators.contains(Doc29Ns))
+    void NoiseCalculatorDoc29::addDoc29NoiseDeparture(const OperationDeparture& Op) {
+        const Doc29Noise* doc29Ns = Op.aircraft().Doc29Ns;
+        const Atmosphere& atm = atmosphere(Op);
+        if (m_DepartureGenerators.contains({ doc29Ns, &atm }))
             return;
 
-        m_DepartureGenerators.add(Doc29Ns, *Doc29Ns); // Forwards Doc29Noise to Doc29NoiseGeneratorArrival constructor
+        m_DepartureGenerators.add({ doc29Ns, &atm }, *doc29Ns, atmosphericAbsorption(atm)); // Forwards Doc29Noise and AtmosphericAbsorption to Doc29NoiseGeneratorDeparture constructor
     }
 }
@@ -4,7 +4,9 @@
 
 #include "Aircraft/Doc29/Doc29NoiseGenerator.h"
 #include "Performance/PerformanceSpecification.h"
+#include "FlightPathGeometry.h"
 #include "NoiseCalculator.h"
+#include "ReceptorGrid.h"
 
 namespace GRAPE {
     class NoiseCalculatorDoc29 : public NoiseCalculator {
@@ -14,11 +16,40 @@ namespace GRAPE {
         [[nodiscard]] NoiseSingleEventOutput calculateArrivalNoise(const OperationArrival& Op, const PerformanceOutput& PerfOutput);
         [[nodiscard]] NoiseSingleEventOutput calculateDepartureNoise(const OperationDeparture& Op, const PerformanceOutput& PerfOutput);
 
-        void addDoc29NoiseArrival(const Doc29Noise* Doc29Ns);
-        void addDoc29NoiseDeparture(const Doc29Noise* Doc29Ns);
+        /**
+        * @brief Creates the noise generator for the Doc29Noise and Atmosphere of Op, if not yet created. Must be called for every operation before any calculation starts (not thread safe).
+        */
+        void addDoc29NoiseArrival(const OperationArrival& Op);
+
+        /**
+        * @brief Creates the noise generator for the Doc29Noise and Atmosphere of Op, if not yet created. Must be called for every operation before any calculation starts (not thread safe).
+        */
+        void addDoc29NoiseDeparture(const OperationDeparture& Op);
     private:
-        GrapeMap<const Doc29Noise*, Doc29NoiseGeneratorArrival> m_ArrivalGenerators;
-        GrapeMap<const Doc29Noise*, Doc29NoiseGeneratorDeparture> m_DepartureGenerators;
+        // The NPD data of the generators is adjusted for atmospheric absorption once and is read only afterwards
+        typedef std::pair<const Doc29Noise*, const Atmosphere*> GeneratorKey;
+        GrapeMap<GeneratorKey, const Doc29NoiseGeneratorArrival> m_ArrivalGenerators;
+        GrapeMap<GeneratorKey, const Doc29NoiseGeneratorDeparture> m_DepartureGenerators;
+
+        // Built once per noise run, used to skip the segment receptor pairs farther than the Doc29 maximum segment distance
+        ReceptorGrid m_ReceptorGrid;
+
+        // Flight paths and receptors are projected into this frame, see FlightPathGeometry for the accuracy
+        LocalCartesian m_Frame;
+        std::vector<std::pair<double, double>> m_ReceptorPositions;
+    private:
+        /**
+        * @return True if segment receptor pairs can be culled with bounding boxes.
+        * Only for geodesic coordinate systems, local cartesian distances are shortened away from the origin and the expanded boxes are not conservative.
+        */
+        [[nodiscard]] bool cullSegments() const;
+
+        /**
+        * @brief Calculates the single event output of PerfOutput at all receptors.
+        * SegNoise calculates the levels of a segment at a block of receptors, before receptor dependent corrections.
+        */
+        template<typename SegmentNoise>
+        [[nodiscard]] NoiseSingleEventOutput calculateNoise(const Atmosphere& Atm, const PerformanceOutput& PerfOutput, const SegmentNoise& SegNoise) const;
     };
 
 }
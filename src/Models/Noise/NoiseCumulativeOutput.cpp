@@ -5,13 +5,24 @@
 #include "NoiseCumulativeOutput.h"
 
 namespace GRAPE {
+    NoiseSingleEventEnergy::NoiseSingleEventEnergy(const NoiseSingleEventOutput& NsOut) {
+        Maximum.reserve(NsOut.size());
+        Exposure.reserve(NsOut.size());
+        for (const auto& [lamax, sel] : NsOut)
+        {
+            Maximum.emplace_back(std::pow(10.0, lamax / 10.0));
+            Exposure.emplace_back(std::pow(10.0, sel / 10.0));
+        }
+    }
+
     NoiseCumulativeOutput::NoiseCumulativeOutput(std::size_t Size, std::size_t NumberAboveCount) : Count(Size, 0.0), CountWeighted(Size, 0.0), MaximumAbsolute(Size, 0.0), MaximumAverage(Size, 0.0), Exposure(Size, 0.0) {
         for (std::size_t i = 0; i < NumberAboveCount; ++i)
             NumberAboveThresholds.emplace_back(Size, 0.0);
     }
 
-    void NoiseCumulativeOutput::accumulateSingleEventOutput(const NoiseSingleEventOutput& NsOut, double OpCount, double OpWeight, double Threshold, const std::vector<double>& NaThresholds) {
+    void NoiseCumulativeOutput::accumulateSingleEventOutput(const NoiseSingleEventOutput& NsOut, const NoiseSingleEventEnergy& NsEnergy, double OpCount, double OpWeight, double Threshold, const std::vector<double>& NaThresholds) {
         GRAPE_ASSERT(NsOut.size() == Count.size());
+        GRAPE_ASSERT(NsEnergy.Maximum.size() == Count.size() && NsEnergy.Exposure.size() == Count.size());
         GRAPE_ASSERT(NaThresholds.size() == NumberAboveThresholds.size());
 
         const double weightedCount = OpCount * OpWeight;
@@ -21,13 +32,15 @@ namespace GRAPE {
         std::ranges::transform(Count, NsOut.lamax(), Count.begin(), [&](double CurrentNumber, double NewLaMax) { return NewLaMax >= Threshold ? CurrentNumber + OpCount : CurrentNumber; });
         std::ranges::transform(CountWeighted, NsOut.lamax(), CountWeighted.begin(), [&](double CurrentWeight, double NewLaMax) { return NewLaMax >= Threshold ? CurrentWeight + weightedCount : CurrentWeight; });
 
-        std::ranges::transform(MaximumAbsolute, NsOut.lamax(), MaximumAbsolute.begin(), [&](double Current, double New) { return New >= Threshold ? std::max(Current, New) : Current; });
-        std::ranges::transform(MaximumAverage, NsOut.lamax(), MaximumAverage.begin(), [&](double Current, double New) { return New >= Threshold ? Current + weightedCount * std::pow(10.0, New / 10.0) : Current; });
+        accumulateMaximumAbsolute(NsOut, OpCount, OpWeight, Threshold);
+        for (std::size_t i = 0; i < Count.size(); ++i)
+        {
+            if (NsOut.values(i).first < Threshold)
+                continue;
 
-        std::ranges::transform(Exposure, NsOut, Exposure.begin(), [&](double Current, const std::pair<double, double>& NsVals) {
-            const auto& [lamax, sel] = NsVals;
-            return lamax >= Threshold ? Current + weightedCount * std::pow(10.0, sel / 10.0) : Current;
-            });
+            MaximumAverage.at(i) += weightedCount * NsEnergy.Maximum.at(i);
+            Exposure.at(i) += weightedCount * NsEnergy.Exposure.at(i);
+        }
 
         for (std::size_t i = 0; i < NaThresholds.size(); ++i)
         {
@@ -39,9 +52,146 @@ namespace GRAPE {
         }
     }
 
+    void NoiseCumulativeOutput::removeSingleEventOutput(const NoiseSingleEventOutput& NsOut, const NoiseSingleEventEnergy& NsEnergy, double OpCount, double OpWeight, double Threshold, const std::vector<double>& NaThresholds) {
+        GRAPE_ASSERT(NsOut.size() == Count.size());
+        GRAPE_ASSERT(NsEnergy.Maximum.size() == Count.size() && NsEnergy.Exposure.size() == Count.size());
+        GRAPE_ASSERT(NaThresholds.size() == NumberAboveThresholds.size());
+
+        const double weightedCount = OpCount * OpWeight;
+        if (weightedCount <= Constants::Precision)
+            return;
+
+        // Sums are clamped at 0 to absorb rounding errors
+        for (std::size_t i = 0; i < Count.size(); ++i)
+        {
+            if (NsOut.values(i).first < Threshold)
+                continue;
+
+            Count.at(i) = std::max(Count.at(i) - OpCount, 0.0);
+            CountWeighted.at(i) = std::max(CountWeighted.at(i) - weightedCount, 0.0);
+            MaximumAverage.at(i) = std::max(MaximumAverage.at(i) - weightedCount * NsEnergy.Maximum.at(i), 0.0);
+            Exposure.at(i) = std::max(Exposure.at(i) - weightedCount * NsEnergy.Exposure.at(i), 0.0);
+        }
+
+        for (std::size_t i = 0; i < NaThresholds.size(); ++i)
+        {
+            const double threshold = NaThresholds.at(i);
+            auto& outNat = NumberAboveThresholds.at(i);
+            std::ranges::transform(outNat, NsOut.lamax(), outNat.begin(), [&](double CurrentCount, double LaMax) {
+                return LaMax >= threshold && LaMax > Threshold ? std::max(CurrentCount - OpCount, 0.0) : CurrentCount;
+                });
+        }
+    }
+
+    void NoiseCumulativeOutput::accumulateMaximumAbsolute(const NoiseSingleEventOutput& NsOut, double OpCount, double OpWeight, double Threshold) {
+        GRAPE_ASSERT(NsOut.size() == MaximumAbsolute.size());
+
+        if (OpCount * OpWeight <= Constants::Precision)
+            return;
+
+        std::ranges::transform(MaximumAbsolute, NsOut.lamax(), MaximumAbsolute.begin(), [&](double Current, double New) { return New >= Threshold ? std::max(Current, New) : Current; });
+    }
+
+    void NoiseCumulativeOutput::merge(const NoiseCumulativeOutput& Other) {
+        GRAPE_ASSERT(Other.Count.size() == Count.size());
+        GRAPE_ASSERT(Other.NumberAboveThresholds.size() == NumberAboveThresholds.size());
+
+        std::ranges::transform(Count, Other.Count, Count.begin(), std::plus());
+        std::ranges::transform(CountWeighted, Other.CountWeighted, CountWeighted.begin(), std::plus());
+        std::ranges::transform(MaximumAbsolute, Other.MaximumAbsolute, MaximumAbsolute.begin(), [](double Current, double New) { return std::max(Current, New); });
+        std::ranges::transform(MaximumAverage, Other.MaximumAverage, MaximumAverage.begin(), std::plus());
+        std::ranges::transform(Exposure, Other.Exposure, Exposure.begin(), std::plus());
+
+        for (std::size_t i = 0; i < NumberAboveThresholds.size(); ++i)
+            std::ranges::transform(NumberAboveThresholds.at(i), Other.NumberAboveThresholds.at(i), NumberAboveThresholds.at(i).begin(), std::plus());
+    }
+
     void NoiseCumulativeOutput::finishAccumulation(double AveragingTimeConstant) {
         std::ranges::transform(MaximumAverage, Count, MaximumAverage.begin(), [&](double Value, double Count) { return Value < Constants::Precision ? 0.0 : 10.0 * (std::log10(Value) - std::log10(Count)); });
 
         std::ranges::transform(Exposure, Exposure.begin(), [&](double Value) { return Value < Constants::Precision ? 0.0 : 10.0 * std::log10(Value) - AveragingTimeConstant; });
     }
+
+    TEST_CASE("Noise Cumulative Output Merge") {
+        NoiseSingleEventOutput ns1;
+        ns1.addValues(60.0, 70.0);
+        ns1.addValues(40.0, 50.0);
+        ns1.addValues(80.0, 90.0);
+
+        NoiseSingleEventOutput ns2;
+        ns2.addValues(70.0, 75.0);
+        ns2.addValues(65.0, 72.0);
+        ns2.addValues(30.0, 45.0);
+
+        const NoiseSingleEventEnergy ns1Energy(ns1);
+        const NoiseSingleEventEnergy ns2Energy(ns2);
+        const std::vector<double> naThresholds{ 55.0, 75.0 };
+
+        NoiseCumulativeOutput full(3, naThresholds.size());
+        full.accumulateSingleEventOutput(ns1, ns1Energy, 2.0, 1.0, 50.0, naThresholds);
+        full.accumulateSingleEventOutput(ns2, ns2Energy, 1.0, 10.0, 50.0, naThresholds);
+
+        NoiseCumulativeOutput shard1(3, naThresholds.size());
+        shard1.accumulateSingleEventOutput(ns1, ns1Energy, 2.0, 1.0, 50.0, naThresholds);
+        NoiseCumulativeOutput shard2(3, naThresholds.size());
+        shard2.accumulateSingleEventOutput(ns2, ns2Energy, 1.0, 10.0, 50.0, naThresholds);
+        shard1.merge(shard2);
+
+        full.finishAccumulation(0.0);
+        shard1.finishAccumulation(0.0);
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            CHECK_EQ(shard1.Count.at(i), doctest::Approx(full.Count.at(i)));
+            CHECK_EQ(shard1.CountWeighted.at(i), doctest::Approx(full.CountWeighted.at(i)));
+            CHECK_EQ(shard1.MaximumAbsolute.at(i), doctest::Approx(full.MaximumAbsolute.at(i)));
+            CHECK_EQ(shard1.MaximumAverage.at(i), doctest::Approx(full.MaximumAverage.at(i)));
+            CHECK_EQ(shard1.Exposure.at(i), doctest::Approx(full.Exposure.at(i)));
+            for (std::size_t j = 0; j < naThresholds.size(); ++j)
+                CHECK_EQ(shard1.NumberAboveThresholds.at(j).at(i), doctest::Approx(full.NumberAboveThresholds.at(j).at(i)));
+        }
+
+        CHECK_EQ(full.Count.at(1), doctest::Approx(1.0));
+        CHECK_EQ(full.MaximumAbsolute.at(2), doctest::Approx(80.0));
+    }
+
+    TEST_CASE("Noise Cumulative Output Remove") {
+        NoiseSingleEventOutput ns1;
+        ns1.addValues(60.0, 70.0);
+        ns1.addValues(40.0, 50.0);
+        ns1.addValues(80.0, 90.0);
+
+        NoiseSingleEventOutput ns2;
+        ns2.addValues(70.0, 75.0);
+        ns2.addValues(65.0, 72.0);
+        ns2.addValues(30.0, 45.0);
+
+        const NoiseSingleEventEnergy ns1Energy(ns1);
+        const NoiseSingleEventEnergy ns2Energy(ns2);
+        const std::vector<double> naThresholds{ 55.0, 75.0 };
+
+        NoiseCumulativeOutput only1(3, naThresholds.size());
+        only1.accumulateSingleEventOutput(ns1, ns1Energy, 2.0, 1.0, 50.0, naThresholds);
+
+        NoiseCumulativeOutput removed2(3, naThresholds.size());
+        removed2.accumulateSingleEventOutput(ns1, ns1Energy, 2.0, 1.0, 50.0, naThresholds);
+        removed2.accumulateSingleEventOutput(ns2, ns2Energy, 1.0, 10.0, 50.0, naThresholds);
+        removed2.removeSingleEventOutput(ns2, ns2Energy, 1.0, 10.0, 50.0, naThresholds);
+        std::ranges::fill(removed2.MaximumAbsolute, 0.0);
+        removed2.accumulateMaximumAbsolute(ns1, 2.0, 1.0, 50.0);
+
+        only1.finishAccumulation(0.0);
+        removed2.finishAccumulation(0.0);
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            CHECK_EQ(removed2.Count.at(i), doctest::Approx(only1.Count.at(i)));
+            CHECK_EQ(removed2.CountWeighted.at(i), doctest::Approx(only1.CountWeighted.at(i)));
+            CHECK_EQ(removed2.MaximumAbsolute.at(i), doctest::Approx(only1.MaximumAbsolute.at(i)));
+            CHECK_EQ(removed2.MaximumAverage.at(i), doctest::Approx(only1.MaximumAverage.at(i)));
+            CHECK_EQ(removed2.Exposure.at(i), doctest::Approx(only1.Exposure.at(i)));
+            for (std::size_t j = 0; j < naThresholds.size(); ++j)
+                CHECK_EQ(removed2.NumberAboveThresholds.at(j).at(i), doctest::Approx(only1.NumberAboveThresholds.at(j).at(i)));
+        }
+    }
 }
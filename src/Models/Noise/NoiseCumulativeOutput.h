@@ -5,16 +5,48 @@
 #include "NoiseSingleEventOutput.h"
 
 namespace GRAPE {
+    /**
+    * @brief The single event levels converted to the energy scale (10^(L/10)). Calculated once per single event output and shared by all cumulative metrics.
+    */
+    struct NoiseSingleEventEnergy {
+        explicit NoiseSingleEventEnergy(const NoiseSingleEventOutput& NsOut);
+
+        std::vector<double> Maximum;
+        std::vector<double> Exposure;
+    };
+
     struct NoiseCumulativeOutput {
         // Constructors & Destructor (Copy, move and delete are default)
         explicit NoiseCumulativeOutput(std::size_t Size, std::size_t NumberAboveCount);
 
         /**
         * @brief Accumulates single event output into this cumulative output. The MaximumAverage and Exposure values are not in the decibel scale. Call finishAccumulation() to finalize the cumulative output.
+        * NsEnergy must be constructed from NsOut.
         * ASSERT NsOut.size() == Count.size() (And therefore all other vectors).
         * ASSERT NaThresholds.size() == NumberAboveThresholds.size()
         */
-        void accumulateSingleEventOutput(const NoiseSingleEventOutput& NsOut, double OpCount, double OpWeight, double Threshold, const std::vector<double>& NaThresholds);
+        void accumulateSingleEventOutput(const NoiseSingleEventOutput& NsOut, const NoiseSingleEventEnergy& NsEnergy, double OpCount, double OpWeight, double Threshold, const std::vector<double>& NaThresholds);
+
+        /**
+        * @brief Subtracts a single event output previously accumulated with the same arguments. MaximumAbsolute is not changed, it has to be recalculated with accumulateMaximumAbsolute() from the remaining single event outputs.
+        * Must not be finished.
+        * ASSERT NsOut.size() == Count.size() (And therefore all other vectors).
+        * ASSERT NaThresholds.size() == NumberAboveThresholds.size()
+        */
+        void removeSingleEventOutput(const NoiseSingleEventOutput& NsOut, const NoiseSingleEventEnergy& NsEnergy, double OpCount, double OpWeight, double Threshold, const std::vector<double>& NaThresholds);
+
+        /**
+        * @brief Accumulates only the MaximumAbsolute values of a single event output, with the same conditions as accumulateSingleEventOutput().
+        * ASSERT NsOut.size() == MaximumAbsolute.size()
+        */
+        void accumulateMaximumAbsolute(const NoiseSingleEventOutput& NsOut, double OpCount, double OpWeight, double Threshold);
+
+        /**
+        * @brief Adds the values accumulated in Other to this cumulative output. Both must not be finished.
+        * ASSERT Other.Count.size() == Count.size()
+        * ASSERT Other.NumberAboveThresholds.size() == NumberAboveThresholds.size()
+        */
+        void merge(const NoiseCumulativeOutput& Other);
 
         /**
         * @brief Finishes the accumulation process for MaximumAverage and Exposure metrics. Exposure uses the AveragingTimeConstant.
@@ -0,0 +1,174 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#include "GRAPE_pch.h"
+
+#include "ReceptorGrid.h"
+
+#include "Base/Conversions.h"
+#include "Base/CoordinateSystem.h"
+
+namespace GRAPE {
+    namespace {
+        // WGS84 bounds for the radii of curvature
+        constexpr double g_MinimumMeridianRadius = 6335439.327;
+        constexpr double g_EquatorialRadius = 6378137.0;
+
+        // Safety margin applied to distances when expanding bounding boxes
+        constexpr double g_DistanceMargin = 1.01;
+
+        // Target average number of receptors per grid cell
+        constexpr std::size_t g_ReceptorsPerCell = 4;
+    }
+
+    void ReceptorGrid::BoundingBox::add(double Longitude, double Latitude) {
+        LongitudeMin = std::min(LongitudeMin, Longitude);
+        LongitudeMax = std::max(LongitudeMax, Longitude);
+        LatitudeMin = std::min(LatitudeMin, Latitude);
+        LatitudeMax = std::max(LatitudeMax, Latitude);
+    }
+
+    void ReceptorGrid::BoundingBox::add(const BoundingBox& Other) {
+        LongitudeMin = std::min(LongitudeMin, Other.LongitudeMin);
+        LongitudeMax = std::max(LongitudeMax, Other.LongitudeMax);
+        LatitudeMin = std::min(LatitudeMin, Other.LatitudeMin);
+        LatitudeMax = std::max(LatitudeMax, Other.LatitudeMax);
+    }
+
+    /**
+    * Latitude is expanded with the minimum meridian radius of curvature.
+    * Longitude is expanded with the radius of the parallel at the highest absolute latitude of the expanded box, which is bounded below by the equatorial radius times the cosine of the latitude.
+    * Boxes reaching the poles or crossing the antimeridian are expanded to the full longitude range.
+    */
+    void ReceptorGrid::BoundingBox::expand(double Distance) {
+        if (LongitudeMin > LongitudeMax || LatitudeMin > LatitudeMax)
+            return;
+
+        const double dist = Distance * g_DistanceMargin;
+
+        const double latDelta = fromRadians(dist / g_MinimumMeridianRadius);
+        LatitudeMin = std::max(LatitudeMin - latDelta, -90.0);
+        LatitudeMax = std::min(LatitudeMax + latDelta, 90.0);
+
+        const double maxAbsLat = std::max(std::abs(LatitudeMin), std::abs(LatitudeMax));
+        if (maxAbsLat >= 89.0)
+        {
+            LongitudeMin = -180.0;
+            LongitudeMax = 180.0;
+            return;
+        }
+
+        const double lonDelta = fromRadians(dist / (g_EquatorialRadius * std::cos(toRadians(maxAbsLat))));
+        LongitudeMin -= lonDelta;
+        LongitudeMax += lonDelta;
+        if (LongitudeMin < -180.0 || LongitudeMax > 180.0)
+        {
+            LongitudeMin = -180.0;
+            LongitudeMax = 180.0;
+        }
+    }
+
+    ReceptorGrid::ReceptorGrid(const ReceptorOutput& ReceptOutput) : m_ReceptorOutput(ReceptOutput) {
+        if (m_ReceptorOutput.empty())
+            return;
+
+        for (const auto& recept : m_ReceptorOutput)
+            m_Bounds.add(recept.Longitude, recept.Latitude);
+
+        // Roughly square cells in degrees
+        const std::size_t cellCount = std::max(m_ReceptorOutput.size() / g_ReceptorsPerCell, std::size_t{ 1 });
+        const double lonSpan = std::max(m_Bounds.LongitudeMax - m_Bounds.LongitudeMin, Constants::Precision);
+        const double latSpan = std::max(m_Bounds.LatitudeMax - m_Bounds.LatitudeMin, Constants::Precision);
+        m_Columns = std::clamp(static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(cellCount) * lonSpan / latSpan))), std::size_t{ 1 }, cellCount);
+        m_Rows = std::max((cellCount + m_Columns - 1) / m_Columns, std::size_t{ 1 });
+        m_CellLongitude = lonSpan / static_cast<double>(m_Columns);
+        m_CellLatitude = latSpan / static_cast<double>(m_Rows);
+
+        // Counting sort of the receptors by cell
+        std::vector<std::size_t> receptCells;
+        receptCells.reserve(m_ReceptorOutput.size());
+        m_CellStart.assign(m_Columns * m_Rows + 1, 0);
+        for (const auto& recept : m_ReceptorOutput)
+        {
+            const std::size_t cell = row(recept.Latitude) * m_Columns + column(recept.Longitude);
+            receptCells.emplace_back(cell);
+            ++m_CellStart.at(cell + 1);
+        }
+        std::partial_sum(m_CellStart.begin(), m_CellStart.end(), m_CellStart.begin());
+
+        m_Receptors.resize(m_ReceptorOutput.size());
+        std::vector<std::size_t> cellFill(m_CellStart.begin(), std::prev(m_CellStart.end()));
+        for (std::size_t i = 0; i < receptCells.size(); ++i)
+            m_Receptors.at(cellFill.at(receptCells.at(i))++) = i;
+    }
+
+    std::vector<std::size_t> ReceptorGrid::query(const BoundingBox& Box) const {
+        std::vector<std::size_t> outIndexes;
+
+        if (m_Receptors.empty() || Box.LongitudeMax < m_Bounds.LongitudeMin || Box.LongitudeMin > m_Bounds.LongitudeMax || Box.LatitudeMax < m_Bounds.LatitudeMin || Box.LatitudeMin > m_Bounds.LatitudeMax)
+            return outIndexes;
+
+        const std::size_t colMin = column(Box.LongitudeMin);
+        const std::size_t colMax = column(Box.LongitudeMax);
+        const std::size_t rowMin = row(Box.LatitudeMin);
+        const std::size_t rowMax = row(Box.LatitudeMax);
+
+        for (std::size_t r = rowMin; r <= rowMax; ++r)
+        {
+            for (std::size_t c = colMin; c <= colMax; ++c)
+            {
+                const std::size_t cell = r * m_Columns + c;
+                for (std::size_t i = m_CellStart.at(cell); i < m_CellStart.at(cell + 1); ++i)
+                {
+                    const std::size_t receptIndex = m_Receptors.at(i);
+                    const auto& recept = m_ReceptorOutput(receptIndex);
+                    if (Box.contains(recept.Longitude, recept.Latitude))
+                        outIndexes.emplace_back(receptIndex);
+                }
+            }
+        }
+
+        std::ranges::sort(outIndexes);
+
+        return outIndexes;
+    }
+
+    std::size_t ReceptorGrid::column(double Longitude) const {
+        const double col = std::floor((Longitude - m_Bounds.LongitudeMin) / m_CellLongitude);
+        return static_cast<std::size_t>(std::clamp(col, 0.0, static_cast<double>(m_Columns - 1)));
+    }
+
+    std::size_t ReceptorGrid::row(double Latitude) const {
+        const double r = std::floor((Latitude - m_Bounds.LatitudeMin) / m_CellLatitude);
+        return static_cast<std::size_t>(std::clamp(r, 0.0, static_cast<double>(m_Rows - 1)));
+    }
+
+    TEST_CASE("Receptor Grid") {
+        const Geodesic cs;
+        ReceptorOutput receptOutput;
+        for (int i = 0; i < 41; ++i)
+            for (int j = 0; j < 41; ++j)
+                receptOutput.addReceptor(std::format("{}-{}", i, j), -9.0 + i * 0.02, 38.5 + j * 0.02, 0.0);
+
+        const ReceptorGrid grid(receptOutput);
+
+        constexpr double maxDistance = 15000.0;
+        constexpr std::array<std::pair<double, double>, 3> points{ { { -8.6, 38.9 }, { -9.05, 38.45 }, { -8.21, 39.3 } } };
+        for (const auto& [lon, lat] : points)
+        {
+            ReceptorGrid::BoundingBox box;
+            box.add(lon, lat);
+            box.expand(maxDistance);
+
+            const auto candidates = grid.query(box);
+            CHECK(std::ranges::is_sorted(candidates));
+            CHECK(candidates.size() < receptOutput.size());
+
+            for (std::size_t i = 0; i < receptOutput.size(); ++i)
+            {
+                const auto& recept = receptOutput(i);
+                if (cs.distance(lon, lat, recept.Longitude, recept.Latitude) <= maxDistance)
+                    CHECK(std::ranges::binary_search(candidates, i));
+            }
+        }
+    }
+}
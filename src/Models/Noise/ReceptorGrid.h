@@ -0,0 +1,65 @@
+// Copyright (C) 2023 Goncalo Soares Roque
+
+#pragma once
+
+#include "ReceptorOutput.h"
+
+namespace GRAPE {
+    /**
+    * @brief Uniform longitude latitude grid over the receptors of a ReceptorOutput. Used to find the receptors which may be within a distance of a point or segment without calculating any distances.
+    *
+    * Immutable after construction and can be queried concurrently.
+    */
+    class ReceptorGrid {
+    public:
+        /**
+        * @brief Longitude latitude box, does not wrap around the antimeridian.
+        */
+        struct BoundingBox {
+            double LongitudeMin = Constants::Inf, LongitudeMax = -Constants::Inf;
+            double LatitudeMin = Constants::Inf, LatitudeMax = -Constants::Inf;
+
+            /**
+            * @brief Extends the box to contain the point.
+            */
+            void add(double Longitude, double Latitude);
+
+            /**
+            * @brief Extends the box to contain Other.
+            */
+            void add(const BoundingBox& Other);
+
+            /**
+            * @brief Expands the box so that every point within Distance (WGS84, in meters) of a point in the box is contained in the expanded box.
+            * The expansion is conservative, it assumes the smallest radius of curvature of the ellipsoid plus a 1% margin.
+            */
+            void expand(double Distance);
+
+            /**
+            * @return True if the point is inside or on the boundary of the box.
+            */
+            [[nodiscard]] bool contains(double Longitude, double Latitude) const { return Longitude >= LongitudeMin && Longitude <= LongitudeMax && Latitude >= LatitudeMin && Latitude <= LatitudeMax; }
+        };
+
+        explicit ReceptorGrid(const ReceptorOutput& ReceptOutput);
+
+        /**
+        * @return The indexes of all receptors in Box, sorted in ascending order.
+        */
+        [[nodiscard]] std::vector<std::size_t> query(const BoundingBox& Box) const;
+
+    private:
+        const ReceptorOutput& m_ReceptorOutput;
+
+        BoundingBox m_Bounds;
+        std::size_t m_Columns = 0, m_Rows = 0;
+        double m_CellLongitude = 0.0, m_CellLatitude = 0.0;
+
+        // Receptor indexes sorted by cell, the indexes of cell i are in [m_CellStart[i], m_CellStart[i + 1][
+        std::vector<std::size_t> m_CellStart;
+        std::vector<std::size_t> m_Receptors;
+    private:
+        [[nodiscard]] std::size_t column(double Longitude) const;
+        [[nodiscard]] std::size_t row(double Latitude) const;
+    };
+}
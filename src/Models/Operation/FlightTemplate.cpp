@@ -0,0 +1,64 @@
+// Copyright (C) 2023 Goncalo Soares Roque 
+
+#include "GRAPE_pch.h"
+
+#include "FlightTemplate.h"
+
+namespace GRAPE {
+    FlightTemplate::FlightTemplate(const FlightArrival& FlightArr, const AtmosphereSeries& Atmospheres) : Acft(&FlightArr.aircraft()), Rte(FlightArr.Rte), Doc29Prof(FlightArr.Doc29Prof), Weight(FlightArr.Weight), Atm(&Atmospheres.atmosphere(FlightArr.Time)) {}
+
+    FlightTemplate::FlightTemplate(const FlightDeparture& FlightDep, const AtmosphereSeries& Atmospheres) : Acft(&FlightDep.aircraft()), Rte(FlightDep.Rte), Doc29Prof(FlightDep.Doc29Prof), Weight(FlightDep.Weight), ThrustPercentageTakeoff(FlightDep.ThrustPercentageTakeoff), ThrustPercentageClimb(FlightDep.ThrustPercentageClimb), Atm(&Atmospheres.atmosphere(FlightDep.Time)) {}
+
+    std::optional<FlightTemplate> flightTemplate(const OperationArrival& Op, const AtmosphereSeries& Atmospheres) {
+        if (Op.type() != Operation::Type::Flight)
+            return std::nullopt;
+
+        return FlightTemplate(static_cast<const FlightArrival&>(Op), Atmospheres);
+    }
+
+    std::optional<FlightTemplate> flightTemplate(const OperationDeparture& Op, const AtmosphereSeries& Atmospheres) {
+        if (Op.type() != Operation::Type::Flight)
+            return std::nullopt;
+
+        return FlightTemplate(static_cast<const FlightDeparture&>(Op), Atmospheres);
+    }
+
+    TEST_CASE("Flight Templates") {
+        AtmosphereSeries atmSeries;
+        atmSeries.addAtmosphere(utcStringToTime("2000-01-01 00:00:00").value(), Atmosphere(0.0, 0.0));
+        atmSeries.addAtmosphere(utcStringToTime("2000-01-01 01:00:00").value(), Atmosphere(10.0, 0.0));
+
+        Aircraft acft("Aircraft");
+        Airport apt("Airport");
+        Runway rwy(apt, "Runway");
+        RouteDepartureSimple rte1(rwy, "Route 1");
+        RouteDepartureSimple rte2(rwy, "Route 2");
+
+        const auto time1 = utcStringToTime("2000-01-01 00:00:00").value();
+        const auto time2 = utcStringToTime("2000-01-01 00:20:00").value(); // Same atmosphere as time1
+        const auto time3 = utcStringToTime("2000-01-01 00:50:00").value();
+
+        FlightDeparture dep1("1", rte1, acft, time1, 1.0, 50000.0);
+        FlightDeparture dep2("2", rte1, acft, time2, 3.0, 50000.0); // Same template as dep1
+        FlightDeparture dep3("3", rte1, acft, time3, 1.0, 50000.0); // Different atmosphere
+        FlightDeparture dep4("4", rte2, acft, time1, 1.0, 50000.0); // Different route
+        FlightDeparture dep5("5", rte1, acft, time1, 1.0, 60000.0); // Different weight
+        FlightDeparture dep6("6", rte1, acft, time1, 1.0, 50000.0, 0.9); // Different takeoff thrust
+        FlightDeparture dep7("7", rte1, acft, time2, 2.0, 50000.0); // Same template as dep1
+        Track4dDeparture track1("Track 1", acft);
+        Track4dDeparture track2("Track 2", acft);
+
+        const std::vector<std::reference_wrapper<const OperationDeparture>> ops{ dep1, track1, dep2, dep3, dep4, dep5, dep6, track2, dep7 };
+        const auto groups = groupByFlightTemplate(ops, atmSeries);
+
+        REQUIRE_EQ(groups.size(), 8);
+        REQUIRE_EQ(groups.at(0).size(), 3);
+        CHECK_EQ(&groups.at(0).at(0).get(), &dep1);
+        CHECK_EQ(&groups.at(0).at(1).get(), &dep2);
+        CHECK_EQ(&groups.at(0).at(2).get(), &dep7);
+        CHECK_EQ(&groups.at(1).at(0).get(), &track1);
+        CHECK_EQ(&groups.at(6).at(0).get(), &track2);
+        for (std::size_t i = 1; i < groups.size(); ++i)
+            CHECK_EQ(groups.at(i).size(), 1);
+    }
+}
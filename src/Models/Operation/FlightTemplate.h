@@ -0,0 +1,67 @@
+// Copyright (C) 2023 Goncalo Soares Roque 
+
+#pragma once
+
+#include "Operations.h"
+
+#include "Base/AtmosphereSeries.h"
+
+namespace GRAPE {
+    /**
+    * @brief The inputs which fully determine the performance and single event noise of a flight.
+    *
+    * Flights with equal templates differ only in name, time and count. Their times select the same atmosphere, so their performance and noise outputs are identical.
+    */
+    struct FlightTemplate {
+        const Aircraft* Acft = nullptr;
+        const Route* Rte = nullptr;
+        const Doc29Profile* Doc29Prof = nullptr;
+        double Weight = 0.0;
+        double ThrustPercentageTakeoff = 1.0;
+        double ThrustPercentageClimb = 1.0;
+        const Atmosphere* Atm = nullptr;
+
+        FlightTemplate(const FlightArrival& FlightArr, const AtmosphereSeries& Atmospheres);
+        FlightTemplate(const FlightDeparture& FlightDep, const AtmosphereSeries& Atmospheres);
+
+        auto operator<=>(const FlightTemplate&) const = default;
+    };
+
+    /**
+    * @return The template of Op if it is a flight, empty if it is a track 4D.
+    */
+    [[nodiscard]] std::optional<FlightTemplate> flightTemplate(const OperationArrival& Op, const AtmosphereSeries& Atmospheres);
+
+    /**
+    * @return The template of Op if it is a flight, empty if it is a track 4D.
+    */
+    [[nodiscard]] std::optional<FlightTemplate> flightTemplate(const OperationDeparture& Op, const AtmosphereSeries& Atmospheres);
+
+    /**
+    * @brief Groups Ops by FlightTemplate, groups are ordered by their first operation. Track 4D operations are never grouped.
+    *
+    * Only the first operation of each group has to be calculated, the outputs can then be used for all operations of the group.
+    */
+    template<typename OperationT>
+    [[nodiscard]] std::vector<std::vector<std::reference_wrapper<const OperationT>>> groupByFlightTemplate(const std::vector<std::reference_wrapper<const OperationT>>& Ops, const AtmosphereSeries& Atmospheres) {
+        std::vector<std::vector<std::reference_wrapper<const OperationT>>> outGroups;
+        std::map<FlightTemplate, std::size_t> groupIndexes;
+
+        for (const auto op : Ops)
+        {
+            const auto flTemplate = flightTemplate(op.get(), Atmospheres);
+            if (!flTemplate)
+            {
+                outGroups.emplace_back().emplace_back(op);
+                continue;
+            }
+
+            const auto [it, added] = groupIndexes.try_emplace(flTemplate.value(), outGroups.size());
+            if (added)
+                outGroups.emplace_back();
+            outGroups.at(it->second).emplace_back(op);
+        }
+
+        return outGroups;
+    }
+}
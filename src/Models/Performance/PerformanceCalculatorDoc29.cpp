@@ -5,65 +5,96 @@
 #include "PerformanceCalculatorDoc29.h"
 
 #include "Base/Math.h"
-#include "Aircraft/Doc29/Doc29ProfileCalculator.h"
 
 namespace GRAPE {
     namespace {
         constexpr std::array Doc29DefaultHeights = { 18.9, 41.5, 68.3, 102.1, 147.5, 214.9, 334.9, 609.6, 1289.6 };
     }
 
-    PerformanceCalculatorDoc29::PerformanceCalculatorDoc29(const PerformanceSpecification& Spec) : PerformanceCalculatorFlight(Spec) {}
+    PerformanceCalculatorDoc29::PerformanceCalculatorDoc29(const PerformanceSpecification& Spec) : PerformanceCalculatorFlight(Spec), m_ProfileCache(*Spec.CoordSys) {}
 
-    std::optional<PerformanceOutput> PerformanceCalculatorDoc29::calculate(const FlightArrival& FlightArr, const RouteOutput& RteOutput) const {
-        PerformanceOutput perfOutput;
+    /**
+    * Route and profile points are both sorted by cumulative ground distance, so each output is interpolated at the points of the other in a single pass.
+    * The profile points are then merged with the route points.
+    */
+    void PerformanceCalculatorDoc29::addRouteAndProfilePoints(PerformanceOutput& PerfOutput, const RouteOutput& RteOutput, const ProfileOutput& ProfOutput) const {
+        PerfOutput.reserve(RteOutput.size() + ProfOutput.size());
 
-        Doc29ProfileArrivalCalculator profCalculator(*m_Spec.CoordSys, m_Spec.Atmospheres.atmosphere(FlightArr.Time), *FlightArr.aircraft().Doc29Acft, FlightArr.route().parentRunway(), RteOutput, FlightArr.Weight, FlightArr.aircraft().EngineCount);
-        const auto profOutputOpt = profCalculator.calculate(*FlightArr.Doc29Prof);
-        if (!profOutputOpt)
+        // Add route points, appended in ascending order
         {
-            Log::models()->error("Calculating performance output for arrival flight '{}' with Doc29 profile '{}'. No performance output generated, profile generated no points.", FlightArr.Name, FlightArr.Doc29Prof->Name);
-            return {};
-        }
+            std::vector<double> cumGroundDists;
+            cumGroundDists.reserve(RteOutput.size());
+            for (const auto& cumGroundDist : RteOutput.points() | std::views::keys)
+                if (pointInDistanceLimits(cumGroundDist))
+                    cumGroundDists.emplace_back(cumGroundDist);
+
+            const auto profPts = ProfOutput.interpolate(cumGroundDists);
+            auto profPtIt = profPts.begin();
+            for (const auto& [cumGroundDist, rtePt] : RteOutput)
+            {
+                if (!pointInDistanceLimits(cumGroundDist))
+                    continue;
 
-        const ProfileOutput& profOutput = *profOutputOpt;
+                const auto [altitudeMsl, trueAirspeed, groundspeed, thrust, unusedBankAngle, flPhase] = *profPtIt++;
 
-        // Add route points
-        for (const auto& [cumGroundDist, rtePt] : RteOutput)
-        {
-            if (!pointInDistanceLimits(cumGroundDist))
-                continue;
+                if (!pointInAltitudeLimits(altitudeMsl))
+                    continue;
+
+                // Recalculate bank angle as route output provides exact turn radius, better than interpolated bank angle!
+                double bankAngl = bankAngle(groundspeed, rtePt.Radius);
+                if (rtePt.Dir == RouteOutput::Direction::RightTurn)
+                    bankAngl = -bankAngl;
 
-            const auto [altitudeMsl, trueAirspeed, groundspeed, thrust, unusedBankAngle, flPhase] = profOutput.interpolate(cumGroundDist);
+                PerfOutput.addPoint(PerformanceOutput::PointOrigin::Route, flPhase, cumGroundDist, rtePt.Longitude, rtePt.Latitude, altitudeMsl, trueAirspeed, groundspeed, thrust, bankAngl);
+            }
+        }
 
-            if (!pointInAltitudeLimits(altitudeMsl))
-                continue;
+        // Add profile points, merged with the route points
+        {
+            std::vector<double> cumGroundDists;
+            cumGroundDists.reserve(ProfOutput.size());
+            for (const auto& [cumGroundDist, profPt] : ProfOutput)
+                if (pointInDistanceLimits(cumGroundDist) && pointInAltitudeLimits(profPt.AltitudeMsl))
+                    cumGroundDists.emplace_back(cumGroundDist);
+
+            const auto rtePts = RteOutput.interpolate(*m_Spec.CoordSys, cumGroundDists);
+            auto rtePtIt = rtePts.begin();
+
+            PerformanceOutput::Container::container_type newPoints;
+            newPoints.reserve(cumGroundDists.size());
+            for (const auto& [cumGroundDist, profPt] : ProfOutput)
+            {
+                if (!pointInDistanceLimits(cumGroundDist) || !pointInAltitudeLimits(profPt.AltitudeMsl))
+                    continue;
 
-            // Recalculate bank angle as route output provides exact turn radius, better than interpolated bank angle!
-            double bankAngl = bankAngle(groundspeed, rtePt.Radius);
-            if (rtePt.Dir == RouteOutput::Direction::RightTurn)
-                bankAngl = -bankAngl;
+                const auto& [longitude, latitude, heading, radius, dir] = *rtePtIt++;
+                const double bankAngl = dir == RouteOutput::Direction::RightTurn ? -profPt.BankAngle : profPt.BankAngle;
 
-            perfOutput.addPoint(PerformanceOutput::PointOrigin::Route, flPhase, cumGroundDist, rtePt.Longitude, rtePt.Latitude, altitudeMsl, trueAirspeed, groundspeed, thrust, bankAngl);
+                newPoints.emplace_back(cumGroundDist, PerformanceOutput::Point{ PerformanceOutput::PointOrigin::Profile, profPt.FlPhase, longitude, latitude, profPt.AltitudeMsl, profPt.TrueAirspeed, profPt.Groundspeed, profPt.Thrust, bankAngl, Constants::NaN });
+            }
+            PerfOutput.addPoints(std::move(newPoints), [](PerformanceOutput::Point& PerfPt) { PerfPt.PtOrigin = PerformanceOutput::PointOrigin::RouteAndProfile; });
         }
+    }
 
-        // Add profile points
-        for (const auto& [cumGroundDist, profPt] : profOutput)
+    std::optional<PerformanceOutput> PerformanceCalculatorDoc29::calculate(const FlightArrival& FlightArr, const RouteOutput& RteOutput) const {
+        PerformanceOutput perfOutput;
+
+        const auto profOutputPtr = m_ProfileCache.arrival(*FlightArr.Doc29Prof, m_Spec.Atmospheres.atmosphere(FlightArr.Time), *FlightArr.aircraft().Doc29Acft, FlightArr.route().parentRunway(), RteOutput, FlightArr.Weight, FlightArr.aircraft().EngineCount);
+        if (!profOutputPtr)
         {
-            if (!pointInDistanceLimits(cumGroundDist) || !pointInAltitudeLimits(profPt.AltitudeMsl))
-                continue;
+            Log::models()->error("Calculating performance output for arrival flight '{}' with Doc29 profile '{}'. No performance output generated, profile generated no points.", FlightArr.Name, FlightArr.Doc29Prof->Name);
+            return {};
+        }
 
-            const auto [longitude, latitude, heading, radius, dir] = RteOutput.interpolate(*m_Spec.CoordSys, cumGroundDist);
-            const double bankAngl = dir == RouteOutput::Direction::RightTurn ? -profPt.BankAngle : profPt.BankAngle;
+        const ProfileOutput& profOutput = *profOutputPtr;
 
-            auto [perfPt, added] = perfOutput.addPoint(PerformanceOutput::PointOrigin::Profile, profPt.FlPhase, cumGroundDist, longitude, latitude, profPt.AltitudeMsl, profPt.TrueAirspeed, profPt.Groundspeed, profPt.Thrust, bankAngl);
-            if (!added)
-                perfPt.PtOrigin = PerformanceOutput::PointOrigin::RouteAndProfile;
-        }
+        addRouteAndProfilePoints(perfOutput, RteOutput, profOutput);
 
         // Doc29 Segmentation
         if (m_Spec.FlightsDoc29Segmentation)
         {
             const auto elev = FlightArr.route().parentRunway().Elevation;
+            std::vector<double> segCumDists;
             for (auto it = std::next(profOutput.rbegin()); it != profOutput.rend(); ++it)
             {
                 auto& [p2CumDist, p2] = *it;
@@ -107,22 +138,30 @@ namespace GRAPE {
                     const double newCumDist = (newAltMsl - b) / slope;
                     if (!pointInDistanceLimits(newCumDist))
                         continue;
-                    const auto rtePt = RteOutput.interpolate(*m_Spec.CoordSys, newCumDist);
-                    const auto profPt = profOutput.interpolate(newCumDist);
-                    if (!pointInAltitudeLimits(profPt.AltitudeMsl))
-                        continue;
-
-                    // Recalculate bank angle as route output provides exact turn radius, better than interpolated bank angle!
-                    double bankAngl = bankAngle(profPt.Groundspeed, rtePt.Radius);
-                    if (rtePt.Dir == RouteOutput::Direction::RightTurn)
-                        bankAngl = -bankAngl;
-
-                    perfOutput.addPoint(PerformanceOutput::PointOrigin::Doc29FinalApproachSegmentation, profPt.FlPhase, newCumDist, rtePt.Longitude, rtePt.Latitude, profPt.AltitudeMsl, profPt.TrueAirspeed, profPt.Groundspeed, profPt.Thrust, profPt.BankAngle);
+                    segCumDists.emplace_back(newCumDist);
                 }
 
                 if (end)
                     break;
             }
+
+            // Interpolate route and profile at all segmentation points in a single pass
+            std::ranges::sort(segCumDists);
+            const auto rtePts = RteOutput.interpolate(*m_Spec.CoordSys, segCumDists);
+            const auto profPts = profOutput.interpolate(segCumDists);
+
+            PerformanceOutput::Container::container_type newPoints;
+            newPoints.reserve(segCumDists.size());
+            for (std::size_t i = 0; i < segCumDists.size(); ++i)
+            {
+                const auto& rtePt = rtePts.at(i);
+                const auto& profPt = profPts.at(i);
+                if (!pointInAltitudeLimits(profPt.AltitudeMsl))
+                    continue;
+
+                newPoints.emplace_back(segCumDists.at(i), PerformanceOutput::Point{ PerformanceOutput::PointOrigin::Doc29FinalApproachSegmentation, profPt.FlPhase, rtePt.Longitude, rtePt.Latitude, profPt.AltitudeMsl, profPt.TrueAirspeed, profPt.Groundspeed, profPt.Thrust, profPt.BankAngle, Constants::NaN });
+            }
+            perfOutput.addPoints(std::move(newPoints));
         }
 
         // Fuel Flow
@@ -148,52 +187,21 @@ namespace GRAPE {
     std::optional<PerformanceOutput> PerformanceCalculatorDoc29::calculate(const FlightDeparture& FlightDep, const RouteOutput& RteOutput) const {
         PerformanceOutput perfOutput;
 
-        Doc29ProfileDepartureCalculator profCalculator(*m_Spec.CoordSys, m_Spec.Atmospheres.atmosphere(FlightDep.Time), *FlightDep.aircraft().Doc29Acft, FlightDep.route().parentRunway(), RteOutput, FlightDep.Weight, FlightDep.aircraft().EngineCount, FlightDep.ThrustPercentageTakeoff, FlightDep.ThrustPercentageClimb);
-        const auto profOutputOpt = profCalculator.calculate(*FlightDep.Doc29Prof);
-        if (!profOutputOpt)
+        const auto profOutputPtr = m_ProfileCache.departure(*FlightDep.Doc29Prof, m_Spec.Atmospheres.atmosphere(FlightDep.Time), *FlightDep.aircraft().Doc29Acft, FlightDep.route().parentRunway(), RteOutput, FlightDep.Weight, FlightDep.aircraft().EngineCount, FlightDep.ThrustPercentageTakeoff, FlightDep.ThrustPercentageClimb);
+        if (!profOutputPtr)
         {
             Log::models()->error("Calculating performance output for departure flight '{}' with Doc29 profile '{}'. No performance output generated, profile generated no points.", FlightDep.Name, FlightDep.Doc29Prof->Name);
             return {};
         }
-        const ProfileOutput& profOutput = *profOutputOpt;
-
-        // Add route points
-        for (const auto& [cumGroundDist, rtePt] : RteOutput)
-        {
-            if (!pointInDistanceLimits(cumGroundDist))
-                continue;
-
-            const auto [altitudeMsl, trueAirspeed, groundspeed, thrust, unusedBankAngle, flPhase] = profOutput.interpolate(cumGroundDist);
-
-            if (!pointInAltitudeLimits(altitudeMsl))
-                continue;
-
-            // Recalculate bank angle as route output provides exact turn radius
-            double bankAngl = bankAngle(groundspeed, rtePt.Radius);
-            if (rtePt.Dir == RouteOutput::Direction::RightTurn)
-                bankAngl = -bankAngl;
-
-            perfOutput.addPoint(PerformanceOutput::PointOrigin::Route, flPhase, cumGroundDist, rtePt.Longitude, rtePt.Latitude, altitudeMsl, trueAirspeed, groundspeed, thrust, bankAngl);
-        }
-
-        // Add profile points
-        for (const auto& [cumGroundDist, profPt] : profOutput)
-        {
-            if (!pointInDistanceLimits(cumGroundDist) || !pointInAltitudeLimits(profPt.AltitudeMsl))
-                continue;
-
-            const auto [longitude, latitude, heading, radius, dir] = RteOutput.interpolate(*m_Spec.CoordSys, cumGroundDist);
-            const double bankAngl = dir == RouteOutput::Direction::RightTurn ? -profPt.BankAngle : profPt.BankAngle;
+        const ProfileOutput& profOutput = *profOutputPtr;
 
-            auto [perfPt, added] = perfOutput.addPoint(PerformanceOutput::PointOrigin::Profile, profPt.FlPhase, cumGroundDist, longitude, latitude, profPt.AltitudeMsl, profPt.TrueAirspeed, profPt.Groundspeed, profPt.Thrust, bankAngl);
-            if (!added)
-                perfPt.PtOrigin = PerformanceOutput::PointOrigin::RouteAndProfile;
-        }
+        addRouteAndProfilePoints(perfOutput, RteOutput, profOutput);
 
         // Doc29 Segmentation
         if (m_Spec.FlightsDoc29Segmentation)
         {
             const auto elev = FlightDep.route().parentRunway().Elevation;
+            PerformanceOutput::Container::container_type newPoints;
 
             // Takeoff Roll
             {
@@ -225,6 +233,7 @@ namespace GRAPE {
                 const double segTime = distanceDelta / std::midpoint(p1.Groundspeed, p2.Groundspeed) / segCount;
                 double cumGroundDistanceP1ToP2 = 0.0;
 
+                std::vector<double> segCumDists;
                 for (int i = 1; i <= segCount - 1; i++) // First and last point already in the output
                 {
                     const double segLength = (p1.Groundspeed + speedIncrement * (i - 0.5)) * segTime;
@@ -238,13 +247,23 @@ namespace GRAPE {
                         continue;
                     const double newSpeed = p1.Groundspeed + i * speedIncrement;
                     const double newCorrNetThrustPerEng = p1.CorrNetThrustPerEng + i * thrustIncrement;
-                    const auto rtePt = RteOutput.interpolate(*m_Spec.CoordSys, newCumDist);
-                    perfOutput.addPoint(PerformanceOutput::PointOrigin::Doc29TakeoffRollSegmentation, p1.FlPhase, newCumDist, rtePt.Longitude, rtePt.Latitude, newAltMsl, newSpeed, newSpeed, newCorrNetThrustPerEng, 0.0);
+                    segCumDists.emplace_back(newCumDist);
+                    newPoints.emplace_back(newCumDist, PerformanceOutput::Point{ PerformanceOutput::PointOrigin::Doc29TakeoffRollSegmentation, p1.FlPhase, Constants::NaN, Constants::NaN, newAltMsl, newSpeed, newSpeed, newCorrNetThrustPerEng, 0.0, Constants::NaN });
+                }
+
+                // Coordinates of all takeoff roll points in a single pass, cumulative ground distances are ascending
+                const auto rtePts = RteOutput.interpolate(*m_Spec.CoordSys, segCumDists);
+                for (std::size_t i = 0; i < rtePts.size(); ++i)
+                {
+                    auto& [cumDist, pt] = newPoints.at(i);
+                    pt.Longitude = rtePts.at(i).Longitude;
+                    pt.Latitude = rtePts.at(i).Latitude;
                 }
             }
 
             // Initial Climb
             {
+                std::vector<double> segCumDists;
                 for (auto it = std::next(profOutput.begin()); it != profOutput.end(); ++it)
                 {
                     auto& [p2CumDist, p2] = *it;
@@ -287,26 +306,39 @@ namespace GRAPE {
                         const double newCumDist = (newAltMsl - b) / slope;
                         if (!pointInDistanceLimits(newCumDist))
                             continue;
-                        const auto rtePt = RteOutput.interpolate(*m_Spec.CoordSys, newCumDist);
-                        auto profPt = profOutput.interpolate(newCumDist);
-                        if (!pointInAltitudeLimits(profPt.AltitudeMsl))
-                            continue;
-                        // Recalculate bank angle as route output provides exact turn radius
-                        double bankAngl = bankAngle(profPt.Groundspeed, rtePt.Radius);
-                        if (rtePt.Dir == RouteOutput::Direction::RightTurn)
-                            bankAngl = -bankAngl;
-
-                        // Fix for profiles without airborne point before first interpolation height
-                        if (profPt.FlPhase == FlightPhase::TakeoffRoll)
-                            profPt.FlPhase = FlightPhase::InitialClimb;
-
-                        perfOutput.addPoint(PerformanceOutput::PointOrigin::Doc29InitialClimbSegmentation, profPt.FlPhase, newCumDist, rtePt.Longitude, rtePt.Latitude, profPt.AltitudeMsl, profPt.TrueAirspeed, profPt.Groundspeed, profPt.Thrust, bankAngl);
+                        segCumDists.emplace_back(newCumDist);
                     }
 
                     if (end)
                         break;
                 }
+
+                // Interpolate route and profile at all segmentation points in a single pass
+                std::ranges::sort(segCumDists);
+                const auto rtePts = RteOutput.interpolate(*m_Spec.CoordSys, segCumDists);
+                auto profPts = profOutput.interpolate(segCumDists);
+                for (std::size_t i = 0; i < segCumDists.size(); ++i)
+                {
+                    const auto& rtePt = rtePts.at(i);
+                    auto& profPt = profPts.at(i);
+                    if (!pointInAltitudeLimits(profPt.AltitudeMsl))
+                        continue;
+
+                    // Recalculate bank angle as route output provides exact turn radius
+                    double bankAngl = bankAngle(profPt.Groundspeed, rtePt.Radius);
+                    if (rtePt.Dir == RouteOutput::Direction::RightTurn)
+                        bankAngl = -bankAngl;
+
+                    // Fix for profiles without airborne point before first interpolation height
+                    if (profPt.FlPhase == FlightPhase::TakeoffRoll)
+                        profPt.FlPhase = FlightPhase::InitialClimb;
+
+                    newPoints.emplace_back(segCumDists.at(i), PerformanceOutput::Point{ PerformanceOutput::PointOrigin::Doc29InitialClimbSegmentation, profPt.FlPhase, rtePt.Longitude, rtePt.Latitude, profPt.AltitudeMsl, profPt.TrueAirspeed, profPt.Groundspeed, profPt.Thrust, bankAngl, Constants::NaN });
+                }
             }
+
+            // Segmentation points are collected first, the takeoff roll points refer to points in the output
+            perfOutput.addPoints(std::move(newPoints));
         }
 
         // Fuel Flow
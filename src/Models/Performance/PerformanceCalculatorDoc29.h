@@ -4,6 +4,8 @@
 
 #include "Performance/PerformanceCalculatorFlight.h"
 
+#include "Aircraft/Doc29/Doc29ProfileCache.h"
+
 namespace GRAPE {
     /**
     * @brief Calculates the PerformanceOutput of arrival and departure flights with the Doc29 performance model.
@@ -14,5 +16,13 @@ namespace GRAPE {
 
         [[nodiscard]] std::optional<PerformanceOutput> calculate(const FlightArrival& FlightArr, const RouteOutput& RteOutput) const override;
         [[nodiscard]] std::optional<PerformanceOutput> calculate(const FlightDeparture& FlightDep, const RouteOutput& RteOutput) const override;
+    private:
+        // Profile outputs shared by the flights of the performance run
+        mutable Doc29ProfileCache m_ProfileCache;
+    private:
+        /**
+        * @brief Adds the route points with the profile interpolated at them and the profile points with the route interpolated at them to PerfOutput.
+        */
+        void addRouteAndProfilePoints(PerformanceOutput& PerfOutput, const RouteOutput& RteOutput, const ProfileOutput& ProfOutput) const;
     };
 }
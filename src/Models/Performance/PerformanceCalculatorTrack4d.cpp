@@ -19,6 +19,7 @@ namespace GRAPE {
         }
 
         PerformanceOutput perfOutput;
+        perfOutput.reserve(Track4dArr.size());
         const auto& atm = m_Spec.Atmospheres.atmosphere(Track4dArr.Time);
 
 
@@ -97,6 +98,7 @@ namespace GRAPE {
         }
 
         PerformanceOutput perfOutput;
+        perfOutput.reserve(Track4dDep.size());
         const auto& atm = m_Spec.Atmospheres.atmosphere(Track4dDep.Time);
 
 
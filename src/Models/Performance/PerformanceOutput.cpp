@@ -14,17 +14,28 @@ namespace GRAPE {
         return { NewElement->second, emplaced };
     }
 
+    void PerformanceOutput::addPoints(Container::container_type&& Points, const std::function<void(Point&)>& OnExisting) {
+        if (OnExisting)
+            m_Output.merge(std::move(Points), OnExisting);
+        else
+            m_Output.merge(std::move(Points));
+    }
+
     void PerformanceOutput::clear() {
         m_Output.clear();
     }
 
     // If the speed difference between two adjacent points is higher than speed delta minimum, points are added between those two adjacent points with equal speed deltas which are at maximum speed delta minimum
+    // New points are collected and merged into the output at the end
     void PerformanceOutput::speedSegmentation(const CoordinateSystem& Cs, double SpeedDeltaMinimum) {
         GRAPE_ASSERT(SpeedDeltaMinimum > 0);
-        for (auto it = m_Output.begin(); it != std::prev(m_Output.end(), 1);)
+        if (size() < 2)
+            return;
+
+        Container::container_type newPoints;
+        for (auto it = std::next(m_Output.begin()); it != m_Output.end(); ++it)
         {
-            const auto& [CumGroundDist1, P1] = *it;
-            it = std::next(it, 1);
+            const auto& [CumGroundDist1, P1] = *std::prev(it);
             const auto& [CumGroundDist2, P2] = *it;
 
             const double speedDelta = P2.Groundspeed - P1.Groundspeed;
@@ -58,27 +69,72 @@ namespace GRAPE {
 
                     auto [newLon, newLat] = Cs.point(P1.Longitude, P1.Latitude, cumGroundDistanceP1ToP2, hdg);
 
-                    addPoint(PointOrigin::SpeedSegmentation, flPhase, CumGroundDist1 + cumGroundDistanceP1ToP2, newLon, newLat, newAltMsl, newTrueAirspeed, newGroundSpeed, newCorrNetThrustPerEng, newBankAngle, newTotalFuelFlow);
+                    newPoints.emplace_back(CumGroundDist1 + cumGroundDistanceP1ToP2, Point{ PointOrigin::SpeedSegmentation, flPhase, newLon, newLat, newAltMsl, newTrueAirspeed, newGroundSpeed, newCorrNetThrustPerEng, newBankAngle, newTotalFuelFlow });
                 }
             }
         }
+        m_Output.merge(std::move(newPoints));
     }
 
-    // Deletes points that are separated by less than ground distance maximum
+    // Deletes points that are separated by less than ground distance maximum, the point after a deleted point is kept and the next comparison starts there
     // Returns the number of deleted points
     std::size_t PerformanceOutput::groundDistanceFilter(double GroundDistanceMaximum) {
         GRAPE_ASSERT(GroundDistanceMaximum >= 0.0);
 
+        auto points = std::move(m_Output).extract();
+
         std::size_t deletedCount = 0;
-        for (auto it = m_Output.begin(); it != std::prev(m_Output.end(), 1); ++it)
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < points.size(); ++i)
         {
-            if (std::abs(it->first - std::next(it, 1)->first) < GroundDistanceMaximum)
+            if (kept != i)
+                points.at(kept) = std::move(points.at(i));
+            ++kept;
+
+            if (i + 1 < points.size() && std::abs(points.at(kept - 1).first - points.at(i + 1).first) < GroundDistanceMaximum)
             {
                 ++deletedCount;
-                if (m_Output.erase(std::next(it, 1)) == m_Output.end())
-                    break;
+                ++i;
             }
         }
+        points.erase(std::next(points.begin(), static_cast<std::ptrdiff_t>(kept)), points.end());
+
+        m_Output.replace(std::move(points));
         return deletedCount;
     }
+
+    TEST_CASE("Performance Output Merge") {
+        PerformanceOutput perfOutput;
+        perfOutput.addPoint(PerformanceOutput::PointOrigin::Route, FlightPhase::Climb, 0.0, 0.0, 0.0, 100.0, 80.0, 80.0, 50000.0, 0.0);
+        perfOutput.addPoint(PerformanceOutput::PointOrigin::Route, FlightPhase::Climb, 2000.0, 0.0, 0.0, 300.0, 90.0, 90.0, 50000.0, 0.0);
+        perfOutput.addPoint(PerformanceOutput::PointOrigin::Route, FlightPhase::Climb, 1000.0, 0.0, 0.0, 200.0, 85.0, 85.0, 50000.0, 0.0);
+
+        PerformanceOutput::Container::container_type newPoints;
+        newPoints.emplace_back(3000.0, PerformanceOutput::Point{ PerformanceOutput::PointOrigin::Profile, FlightPhase::Climb, 0.0, 0.0, 400.0, 95.0, 95.0, 50000.0, 0.0, Constants::NaN });
+        newPoints.emplace_back(1000.0, PerformanceOutput::Point{ PerformanceOutput::PointOrigin::Profile, FlightPhase::Climb, 0.0, 0.0, 250.0, 85.0, 85.0, 50000.0, 0.0, Constants::NaN });
+        newPoints.emplace_back(500.0, PerformanceOutput::Point{ PerformanceOutput::PointOrigin::Profile, FlightPhase::Climb, 0.0, 0.0, 150.0, 82.0, 82.0, 50000.0, 0.0, Constants::NaN });
+        newPoints.emplace_back(3000.0, PerformanceOutput::Point{ PerformanceOutput::PointOrigin::Profile, FlightPhase::Climb, 0.0, 0.0, 450.0, 95.0, 95.0, 50000.0, 0.0, Constants::NaN });
+
+        perfOutput.addPoints(std::move(newPoints), [](PerformanceOutput::Point& Pt) { Pt.PtOrigin = PerformanceOutput::PointOrigin::RouteAndProfile; });
+        REQUIRE(perfOutput.size() == 5);
+        CHECK(std::ranges::is_sorted(perfOutput, {}, [](const auto& Pt) { return Pt.first; }));
+
+        // Existing points are kept
+        const auto& [cumDist1000, pt1000] = perfOutput.points()[2];
+        CHECK(cumDist1000 == 1000.0);
+        CHECK(pt1000.AltitudeMsl == 200.0);
+        CHECK(pt1000.PtOrigin == PerformanceOutput::PointOrigin::RouteAndProfile);
+
+        // First of repeated new points is kept
+        const auto& [cumDist3000, pt3000] = perfOutput.points()[4];
+        CHECK(cumDist3000 == 3000.0);
+        CHECK(pt3000.AltitudeMsl == 400.0);
+
+        SUBCASE("Ground distance filter") {
+            // 0, 500, 1000, 2000, 3000: 500 deleted, comparison restarts at 1000
+            CHECK(perfOutput.groundDistanceFilter(600.0) == 1);
+            REQUIRE(perfOutput.size() == 4);
+            CHECK(perfOutput.points()[1].first == 1000.0);
+        }
+    }
 }
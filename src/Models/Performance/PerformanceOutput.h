@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "Base/BaseModels.h"
 
 namespace GRAPE {
@@ -11,7 +13,7 @@ namespace GRAPE {
     class Operation;
 
     /**
-    * @brief The performance output is a sequence of points stored on an ordered map. The key is the cumulative ground distance.
+    * @brief The performance output is a sequence of points stored contiguously and ordered by the key, the cumulative ground distance.
     */
     class PerformanceOutput {
     public:
@@ -52,6 +54,8 @@ namespace GRAPE {
         PerformanceOutput& operator=(PerformanceOutput&&) = default;
         ~PerformanceOutput() = default;
 
+        typedef FlatMap<double, Point> Container;
+
         [[nodiscard]] const auto& points() const { return m_Output; }
         [[nodiscard]] auto begin() const { return m_Output.begin(); }
         [[nodiscard]] auto end() const { return m_Output.end(); }
@@ -71,10 +75,21 @@ namespace GRAPE {
 
         /**
         * @brief Adds a point to the container.
-        * @return The newly created Point and true or the already existing Point and false.
+        * @return The newly created Point and true or the already existing Point and false. The reference is invalidated by adding further points.
         */
         std::pair<Point&, bool> addPoint(PointOrigin PtOrigin, FlightPhase FlPhase, double CumulativeGroundDistance, double Longitude, double Latitude, double AltitudeMsl, double TrueAirspeed, double Groundspeed, double Thrust, double BankAngle, double FuelFlowPerEng = Constants::NaN);
 
+        /**
+        * @brief Adds all Points to the container with a single merge, cheaper than adding them one by one. Points don't need to be sorted.
+        * For points with a cumulative ground distance already in the container, the existing point is kept and passed to OnExisting.
+        */
+        void addPoints(Container::container_type&& Points, const std::function<void(Point&)>& OnExisting = nullptr);
+
+        /**
+        * @brief Reserve space for Count points.
+        */
+        void reserve(std::size_t Count) { m_Output.reserve(Count); }
+
         /**
         * @brief Delete all points from the container.
         */
@@ -90,6 +105,6 @@ namespace GRAPE {
         */
         std::size_t groundDistanceFilter(double GroundDistanceMaximum);
     private:
-        std::map<double, Point> m_Output;
+        Container m_Output;
     };
 }
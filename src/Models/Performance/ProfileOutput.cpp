@@ -20,43 +20,63 @@ namespace GRAPE {
     ProfileOutput::Point ProfileOutput::interpolate(double CumulativeGroundDistance) const {
         GRAPE_ASSERT(!empty());
 
-        const auto nextNode = m_Profile.lower_bound(CumulativeGroundDistance);
+        return interpolate(m_Profile.lower_bound(CumulativeGroundDistance), CumulativeGroundDistance);
+    }
+
+    std::vector<ProfileOutput::Point> ProfileOutput::interpolate(std::span<const double> CumulativeGroundDistances) const {
+        GRAPE_ASSERT(!empty());
+        GRAPE_ASSERT(std::ranges::is_sorted(CumulativeGroundDistances));
+
+        std::vector<Point> outPoints;
+        outPoints.reserve(CumulativeGroundDistances.size());
+
+        auto nextNode = m_Profile.begin();
+        for (const double cumGroundDist : CumulativeGroundDistances)
+        {
+            while (nextNode != m_Profile.end() && nextNode->first < cumGroundDist)
+                ++nextNode;
+            outPoints.emplace_back(interpolate(nextNode, cumGroundDist));
+        }
 
+        return outPoints;
+    }
+
+    ProfileOutput::Point ProfileOutput::interpolate(FlatMap<double, Point>::const_iterator NextNode, double CumulativeGroundDistance) const {
         // Point is after profile end
-        if (nextNode == m_Profile.end())
+        if (NextNode == m_Profile.end())
         {
             if (size() == 1)
                 return m_Profile.begin()->second; // Return single point in the container
 
             // Extrapolate altitude from two last points, keep all other variables equal to the last point
-            const auto& [p1CumDist, p1] = *std::prev(nextNode, 2);
-            const auto& [p2CumDist, p2] = *std::prev(nextNode, 1);
+            const auto& [p1CumDist, p1] = *std::prev(NextNode, 2);
+            const auto& [p2CumDist, p2] = *std::prev(NextNode, 1);
             const double iFactor = (CumulativeGroundDistance - p1CumDist) / (p2CumDist - p1CumDist);
             const double altMsl = distanceInterpolation(p1.AltitudeMsl, p2.AltitudeMsl, iFactor);
             return Point{ altMsl, p2.TrueAirspeed, p2.Groundspeed, p2.Thrust, p2.BankAngle, p2.FlPhase };
         }
 
         // Point already in the container
-        const auto& [NextCumGroundDist, NextPt] = *nextNode;
+        const auto& [NextCumGroundDist, NextPt] = *NextNode;
         if (std::abs(NextCumGroundDist - CumulativeGroundDistance) < Constants::Precision)
             return NextPt;
 
         // Point before profile start
-        if (nextNode == m_Profile.begin())
+        if (NextNode == m_Profile.begin())
         {
             if (size() == 1)
                 return m_Profile.begin()->second; // Return single point in the container
 
             // Extrapolate altitude from first two points, keep all other variables equal to the first point
-            const auto& [p1CumDist, p1] = *nextNode;
-            const auto& [p2CumDist, p2] = *std::next(nextNode);
+            const auto& [p1CumDist, p1] = *NextNode;
+            const auto& [p2CumDist, p2] = *std::next(NextNode);
             const double iFactor = (CumulativeGroundDistance - p1CumDist) / (p2CumDist - p1CumDist);
             const double altMsl = distanceInterpolation(p1.AltitudeMsl, p2.AltitudeMsl, iFactor);
             return Point{ altMsl, p1.TrueAirspeed, p1.Groundspeed, p1.Thrust, p1.BankAngle, p1.FlPhase };
         }
 
         // Point between defined route
-        const auto& [PrevCumGroundDist, PrevPt] = *std::prev(nextNode);
+        const auto& [PrevCumGroundDist, PrevPt] = *std::prev(NextNode);
         const double iFactor = (CumulativeGroundDistance - PrevCumGroundDist) / (NextCumGroundDist - PrevCumGroundDist);
         const double altMsl = distanceInterpolation(PrevPt.AltitudeMsl, NextPt.AltitudeMsl, iFactor);
         const double trueAirspeed = timeInterpolation(PrevPt.TrueAirspeed, NextPt.TrueAirspeed, iFactor);
@@ -65,4 +85,23 @@ namespace GRAPE {
         const double bankAngl = distanceInterpolation(PrevPt.BankAngle, NextPt.BankAngle, iFactor);
         return Point{ altMsl, trueAirspeed, groundSpeed, thrust, bankAngl, PrevPt.FlPhase };
     }
+
+    TEST_CASE("Profile Output Batch Interpolation") {
+        ProfileOutput prof;
+        prof.addPoint(0.0, 100.0, 80.0, 80.0, 60000.0, 0.0, FlightPhase::TakeoffRoll);
+        prof.addPoint(1500.0, 100.0, 85.0, 85.0, 60000.0, 0.0, FlightPhase::InitialClimb);
+        prof.addPoint(5000.0, 600.0, 90.0, 90.0, 55000.0, 0.0, FlightPhase::Climb);
+
+        constexpr std::array distances{ -500.0, 0.0, 750.0, 1500.0, 1500.0, 3000.0, 5000.0, 7000.0 };
+        const auto points = prof.interpolate(distances);
+        REQUIRE(points.size() == distances.size());
+        for (std::size_t i = 0; i < distances.size(); ++i)
+        {
+            const auto pt = prof.interpolate(distances.at(i));
+            CHECK(points.at(i).AltitudeMsl == doctest::Approx(pt.AltitudeMsl));
+            CHECK(points.at(i).TrueAirspeed == doctest::Approx(pt.TrueAirspeed));
+            CHECK(points.at(i).Thrust == doctest::Approx(pt.Thrust));
+            CHECK(points.at(i).FlPhase == pt.FlPhase);
+        }
+    }
 }
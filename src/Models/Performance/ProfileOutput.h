@@ -2,13 +2,15 @@
 
 #pragma once
 
+#include <span>
+
 #include "Base/BaseModels.h"
 
 namespace GRAPE {
     class RouteOutput;
 
     /**
-    * @brief: Output class of profile calculations. Implemented as an ordered map with cumulative ground distance as key.
+    * @brief: Output class of profile calculations. Implemented as a flat map with cumulative ground distance as key, points are stored contiguously.
     *
     * Departures: 0 cumulative distance at departure threshold and positive cumulative distance afterwards
     * Arrivals: 0 cumulative distance at arrival threshold, negative cumulative distance before and positive afterwards
@@ -73,7 +75,20 @@ namespace GRAPE {
         * ASSERT !empty()
         */
         [[nodiscard]] Point interpolate(double CumulativeGroundDistance) const;
+
+        /**
+        * @brief Same as interpolate(double) for each of the CumulativeGroundDistances, which must be sorted in ascending order.
+        * The points are walked once instead of searched for each distance.
+        *
+        * ASSERT !empty()
+        */
+        [[nodiscard]] std::vector<Point> interpolate(std::span<const double> CumulativeGroundDistances) const;
+    private:
+        /**
+        * @brief Interpolate a new point at CumulativeGroundDistance, NextNode being the first point not before CumulativeGroundDistance.
+        */
+        [[nodiscard]] Point interpolate(FlatMap<double, Point>::const_iterator NextNode, double CumulativeGroundDistance) const;
     private:
-        std::map<double, Point> m_Profile;
+        FlatMap<double, Point> m_Profile;
     };
 }
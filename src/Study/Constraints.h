@@ -99,6 +99,15 @@ namespace GRAPE {
         void noiseRunBlock(const NoiseRun& NsRun);
         void noiseRunUnblock(const NoiseRun& NsRun);
 
+        // Operations added to or removed from a scenario with run outputs
+        void performanceRunBlock(const Flight& Op, const PerformanceRun& PerfRun);
+        void performanceRunUnblock(const Flight& Op, const PerformanceRun& PerfRun);
+        void performanceRunBlock(const Track4d& Op, const PerformanceRun& PerfRun);
+        void performanceRunUnblock(const Track4d& Op, const PerformanceRun& PerfRun);
+
+        void noiseRunBlock(const Operation& Op, const NoiseRun& NsRun);
+        void noiseRunUnblock(const Operation& Op, const NoiseRun& NsRun);
+
     private:
         // Not Removable
         BlockMap<const Doc29Aircraft*, const Aircraft*> m_NrDoc29Aircraft;
@@ -127,13 +136,5 @@ namespace GRAPE {
 
         BlockMap<const Doc29Noise*, const NoiseRun*> m_NeDoc29Noises;
 
-    private:
-        void performanceRunBlock(const Flight& Op, const PerformanceRun& PerfRun);
-        void performanceRunUnblock(const Flight& Op, const PerformanceRun& PerfRun);
-        void performanceRunBlock(const Track4d& Op, const PerformanceRun& PerfRun);
-        void performanceRunUnblock(const Track4d& Op, const PerformanceRun& PerfRun);
-
-        void noiseRunBlock(const Operation& Op, const NoiseRun& NsRun);
-        void noiseRunUnblock(const Operation& Op, const NoiseRun& NsRun);
     };
 }
@@ -5,6 +5,10 @@
 #include "Elevator.h"
 
 #include "Elevator11.h"
+#include "Elevator12.h"
+#include "Elevator13.h"
+#include "Elevator14.h"
+#include "Elevator15.h"
 
 namespace GRAPE::Schema {
     Elevator::Elevator() {
@@ -17,6 +21,28 @@ namespace GRAPE::Schema {
                 Elevator11::g_emissions_run_output_operations,
                 Elevator11::g_emissions_run_output_segments,
             });
+
+        m_ElevatorQueries.try_emplace(12, ElevatorQueries{
+                Elevator12::g_noise_run_output_single_event,
+            });
+        m_ElevatorRoutines.try_emplace(12, Elevator12::convertSingleEventOutputs);
+
+        m_ElevatorQueries.try_emplace(13, ElevatorQueries{
+                Elevator13::g_performance_run_output,
+                Elevator13::g_noise_run_output,
+                Elevator13::g_emissions_run_output,
+                Elevator13::g_replace_tables,
+            });
+
+        m_ElevatorQueries.try_emplace(14, ElevatorQueries{
+                Elevator14::g_enum_tables,
+                Elevator14::g_performance_run_output,
+                Elevator14::g_operations_tracks_4d_points,
+            });
+
+        m_ElevatorQueries.try_emplace(15, ElevatorQueries{
+                Elevator15::g_move_outputs,
+            });
     }
 
     void Elevator::elevate(const Database& Db, int CurrentVersion) const {
@@ -29,6 +55,8 @@ namespace GRAPE::Schema {
         {
             for (const auto& query : queries)
                 Db.execute(std::string(query));
+            if (const auto it = m_ElevatorRoutines.find(version); it != m_ElevatorRoutines.end())
+                it->second(Db);
             Db.execute(std::format("PRAGMA user_version={}", version));
         }
 
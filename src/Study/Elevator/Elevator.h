@@ -10,5 +10,9 @@ namespace GRAPE::Schema {
     private:
         typedef std::vector<std::string_view> ElevatorQueries;
         std::map<int, ElevatorQueries> m_ElevatorQueries;
+
+        // Conversions which can't be written in SQL, executed after the queries of the same version
+        typedef std::function<void(const Database&)> ElevatorRoutine;
+        std::map<int, ElevatorRoutine> m_ElevatorRoutines;
     };
 }
@@ -0,0 +1,103 @@
+#pragma once
+
+namespace GRAPE::Schema::Elevator12 {
+    // Single event outputs are stored as one row per operation with the values of all receptors in a blob
+    // The blobs can't be built in SQL, the row based outputs are converted by convertSingleEventOutputs() before the old table is replaced
+    constexpr std::string_view g_noise_run_output_single_event = R"(
+CREATE TABLE noise_run_output_single_event_new (
+    scenario_id        TEXT NOT NULL,
+    performance_run_id TEXT NOT NULL,
+    noise_run_id       TEXT NOT NULL,
+    operation_id       TEXT NOT NULL,
+    operation          TEXT NOT NULL,
+    operation_type     TEXT NOT NULL,
+    maximum_db         BLOB NOT NULL,
+    exposure_db        BLOB NOT NULL,
+    PRIMARY KEY (
+        scenario_id,
+        performance_run_id,
+        noise_run_id,
+        operation_id,
+        operation,
+        operation_type
+    ),
+    CONSTRAINT fk_noise_run FOREIGN KEY (
+        scenario_id,
+        performance_run_id,
+        noise_run_id
+    )
+    REFERENCES noise_run (scenario_id,
+    performance_run_id,
+    id) ON DELETE CASCADE
+        ON UPDATE CASCADE,
+    CONSTRAINT fk_operation FOREIGN KEY (
+        scenario_id,
+        performance_run_id,
+        operation_id,
+        operation,
+        operation_type
+    )
+    REFERENCES performance_run_output (scenario_id,
+    performance_run_id,
+    operation_id,
+    operation,
+    operation_type) ON DELETE CASCADE
+                    ON UPDATE CASCADE
+);
+)";
+
+    constexpr std::string_view g_replace_single_event = R"(
+DROP TABLE noise_run_output_single_event;
+
+ALTER TABLE noise_run_output_single_event_new RENAME TO noise_run_output_single_event;
+)";
+
+    /**
+    * @brief Converts the row based single event outputs into one row per operation with float32 blobs sorted by receptor ID, then replaces the old table.
+    */
+    inline void convertSingleEventOutputs(const Database& Db) {
+        Db.beginTransaction();
+
+        Statement select(Db, R"(
+SELECT scenario_id, performance_run_id, noise_run_id, operation_id, operation, operation_type, maximum_db, exposure_db
+FROM noise_run_output_single_event
+ORDER BY scenario_id, performance_run_id, noise_run_id, operation_id, operation, operation_type, receptor_id
+)");
+        Statement insert(Db, "INSERT INTO noise_run_output_single_event_new VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+
+        std::array<std::string, 6> key;
+        Blob lamaxBlob, selBlob;
+        const auto flush = [&] {
+            if (lamaxBlob.empty())
+                return;
+
+            insert.bindValues(key.at(0), key.at(1), key.at(2), key.at(3), key.at(4), key.at(5), lamaxBlob, selBlob);
+            insert.step();
+            insert.reset();
+            lamaxBlob = Blob();
+            selBlob = Blob();
+        };
+
+        select.step();
+        while (select.hasRow())
+        {
+            std::array<std::string, 6> rowKey;
+            for (std::size_t i = 0; i < rowKey.size(); ++i)
+                rowKey.at(i) = select.getColumn(static_cast<int>(i)).getString();
+
+            if (rowKey != key)
+            {
+                flush();
+                key = std::move(rowKey);
+            }
+
+            lamaxBlob.add(static_cast<float>(select.getColumn(6).getDouble()));
+            selBlob.add(static_cast<float>(select.getColumn(7).getDouble()));
+            select.step();
+        }
+        flush();
+
+        Db.execute(std::string(g_replace_single_event));
+        Db.commitTransaction();
+    }
+}
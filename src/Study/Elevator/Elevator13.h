@@ -0,0 +1,227 @@
+#pragma once
+
+namespace GRAPE::Schema::Elevator13 {
+    // Output rows of each operation are identified by the integer id of their performance run output
+    constexpr std::string_view g_performance_run_output = R"(
+CREATE TABLE performance_run_output_new (
+    id                 INTEGER PRIMARY KEY,
+    scenario_id        TEXT    NOT NULL,
+    performance_run_id TEXT    NOT NULL,
+    operation_id       TEXT    NOT NULL,
+    operation          TEXT    NOT NULL
+                               CHECK (operation IN ('Arrival', 'Departure') ),
+    operation_type     TEXT    NOT NULL
+                               CHECK (operation_type IN ('Flight', 'Track 4D') ),
+    UNIQUE (
+        scenario_id,
+        performance_run_id,
+        operation_id,
+        operation,
+        operation_type
+    ),
+    CONSTRAINT fk_performance_run FOREIGN KEY (
+        scenario_id,
+        performance_run_id
+    )
+    REFERENCES performance_run (scenario_id,
+    id) ON DELETE CASCADE
+        ON UPDATE CASCADE
+);
+
+INSERT INTO performance_run_output_new (scenario_id, performance_run_id, operation_id, operation, operation_type)
+SELECT scenario_id, performance_run_id, operation_id, operation, operation_type FROM performance_run_output;
+
+CREATE TABLE performance_run_output_points_new (
+    performance_run_output_id       INTEGER NOT NULL,
+    point_number                    INTEGER NOT NULL,
+    point_origin                    TEXT    NOT NULL
+                                            CHECK (point_origin IN ('Route', 'Profile', 'Route & Profile', 'Track 4D', 'Speed Segmentation', 'Doc29 Takeoff Roll Segmentation', 'Doc29 Final Approach Segmentation', 'Doc29 Initial Climb Segmentation') ),
+    flight_phase                    TEXT    NOT NULL
+                                            CHECK (flight_phase IN ('Approach', 'Landing Roll', 'Takeoff Roll', 'Initial Climb', 'Climb') ),
+    cumulative_ground_distance      REAL    NOT NULL,
+    longitude                       REAL    NOT NULL,
+    latitude                        REAL    NOT NULL,
+    altitude_msl                    REAL    NOT NULL,
+    true_airspeed                   REAL    NOT NULL,
+    ground_speed                    REAL    NOT NULL,
+    corrected_net_thrust_per_engine REAL    NOT NULL,
+    bank_angle                      REAL    NOT NULL,
+    fuel_flow_per_engine            REAL    NOT NULL,
+    PRIMARY KEY (
+        performance_run_output_id,
+        point_number
+    ),
+    CONSTRAINT fk_performance_run_output FOREIGN KEY (
+        performance_run_output_id
+    )
+    REFERENCES performance_run_output (id) ON DELETE CASCADE
+)
+WITHOUT ROWID;
+
+INSERT INTO performance_run_output_points_new
+SELECT perfOut.id, pts.point_number, pts.point_origin, pts.flight_phase, pts.cumulative_ground_distance, pts.longitude, pts.latitude, pts.altitude_msl, pts.true_airspeed, pts.ground_speed, pts.corrected_net_thrust_per_engine, pts.bank_angle, pts.fuel_flow_per_engine
+FROM performance_run_output_points AS pts
+JOIN performance_run_output_new AS perfOut USING (scenario_id, performance_run_id, operation_id, operation, operation_type);
+)";
+
+    // Noise runs with outputs are identified by an integer id, single event outputs reference the run and the performance run output by id
+    constexpr std::string_view g_noise_run_output = R"(
+CREATE TABLE noise_run_output (
+    id                 INTEGER PRIMARY KEY,
+    scenario_id        TEXT    NOT NULL,
+    performance_run_id TEXT    NOT NULL,
+    noise_run_id       TEXT    NOT NULL,
+    UNIQUE (
+        scenario_id,
+        performance_run_id,
+        noise_run_id
+    ),
+    CONSTRAINT fk_noise_run FOREIGN KEY (
+        scenario_id,
+        performance_run_id,
+        noise_run_id
+    )
+    REFERENCES noise_run (scenario_id,
+    performance_run_id,
+    id) ON DELETE CASCADE
+        ON UPDATE CASCADE
+);
+
+INSERT INTO noise_run_output (scenario_id, performance_run_id, noise_run_id)
+SELECT DISTINCT scenario_id, performance_run_id, noise_run_id FROM noise_run_output_receptors;
+
+CREATE TABLE noise_run_output_single_event_new (
+    noise_run_output_id       INTEGER NOT NULL,
+    performance_run_output_id INTEGER NOT NULL,
+    maximum_db                BLOB    NOT NULL,
+    exposure_db               BLOB    NOT NULL,
+    PRIMARY KEY (
+        noise_run_output_id,
+        performance_run_output_id
+    ),
+    CONSTRAINT fk_noise_run_output FOREIGN KEY (
+        noise_run_output_id
+    )
+    REFERENCES noise_run_output (id) ON DELETE CASCADE,
+    CONSTRAINT fk_performance_run_output FOREIGN KEY (
+        performance_run_output_id
+    )
+    REFERENCES performance_run_output (id) ON DELETE CASCADE
+);
+
+INSERT INTO noise_run_output_single_event_new
+SELECT nsOut.id, perfOut.id, singleEvt.maximum_db, singleEvt.exposure_db
+FROM noise_run_output_single_event AS singleEvt
+JOIN noise_run_output AS nsOut USING (scenario_id, performance_run_id, noise_run_id)
+JOIN performance_run_output_new AS perfOut USING (scenario_id, performance_run_id, operation_id, operation, operation_type);
+)";
+
+    constexpr std::string_view g_emissions_run_output = R"(
+CREATE TABLE emissions_run_output_new (
+    id                 INTEGER PRIMARY KEY,
+    scenario_id        TEXT    NOT NULL,
+    performance_run_id TEXT    NOT NULL,
+    emissions_run_id   TEXT    NOT NULL,
+    fuel               REAL    NOT NULL,
+    hc                 REAL    NOT NULL,
+    co                 REAL    NOT NULL,
+    nox                REAL    NOT NULL,
+    nvpm               REAL    NOT NULL,
+    nvpm_number        REAL    NOT NULL,
+    UNIQUE (
+        scenario_id,
+        performance_run_id,
+        emissions_run_id
+    ),
+    CONSTRAINT fk_emissions_run FOREIGN KEY (
+        scenario_id,
+        performance_run_id,
+        emissions_run_id
+    )
+    REFERENCES emissions_run (scenario_id,
+    performance_run_id,
+    id) ON DELETE CASCADE
+        ON UPDATE CASCADE
+);
+
+INSERT INTO emissions_run_output_new (scenario_id, performance_run_id, emissions_run_id, fuel, hc, co, nox, nvpm, nvpm_number)
+SELECT scenario_id, performance_run_id, emissions_run_id, fuel, hc, co, nox, nvpm, nvpm_number FROM emissions_run_output;
+
+CREATE TABLE emissions_run_output_operations_new (
+    emissions_run_output_id   INTEGER NOT NULL,
+    performance_run_output_id INTEGER NOT NULL,
+    fuel                      REAL    NOT NULL,
+    hc                        REAL    NOT NULL,
+    co                        REAL    NOT NULL,
+    nox                       REAL    NOT NULL,
+    nvpm                      REAL    NOT NULL,
+    nvpm_number               REAL    NOT NULL,
+    PRIMARY KEY (
+        emissions_run_output_id,
+        performance_run_output_id
+    ),
+    CONSTRAINT fk_emissions_run_output FOREIGN KEY (
+        emissions_run_output_id
+    )
+    REFERENCES emissions_run_output (id) ON DELETE CASCADE,
+    CONSTRAINT fk_performance_run_output FOREIGN KEY (
+        performance_run_output_id
+    )
+    REFERENCES performance_run_output (id)
+)
+WITHOUT ROWID;
+
+INSERT INTO emissions_run_output_operations_new
+SELECT emiOut.id, perfOut.id, emiOpOut.fuel, emiOpOut.hc, emiOpOut.co, emiOpOut.nox, emiOpOut.nvpm, emiOpOut.nvpm_number
+FROM emissions_run_output_operations AS emiOpOut
+JOIN emissions_run_output_new AS emiOut USING (scenario_id, performance_run_id, emissions_run_id)
+JOIN performance_run_output_new AS perfOut USING (scenario_id, performance_run_id, operation_id, operation, operation_type);
+
+CREATE TABLE emissions_run_output_segments_new (
+    emissions_run_output_id   INTEGER NOT NULL,
+    performance_run_output_id INTEGER NOT NULL,
+    segment_number            INTEGER NOT NULL,
+    fuel                      REAL    NOT NULL,
+    hc                        REAL    NOT NULL,
+    co                        REAL    NOT NULL,
+    nox                       REAL    NOT NULL,
+    nvpm                      REAL    NOT NULL,
+    nvpm_number               REAL    NOT NULL,
+    PRIMARY KEY (
+        emissions_run_output_id,
+        performance_run_output_id,
+        segment_number
+    ),
+    CONSTRAINT fk_emissions_run_output_operations FOREIGN KEY (
+        emissions_run_output_id,
+        performance_run_output_id
+    )
+    REFERENCES emissions_run_output_operations (emissions_run_output_id,
+    performance_run_output_id) ON DELETE CASCADE
+)
+WITHOUT ROWID;
+
+INSERT INTO emissions_run_output_segments_new
+SELECT emiOut.id, perfOut.id, segOut.segment_number, segOut.fuel, segOut.hc, segOut.co, segOut.nox, segOut.nvpm, segOut.nvpm_number
+FROM emissions_run_output_segments AS segOut
+JOIN emissions_run_output_new AS emiOut USING (scenario_id, performance_run_id, emissions_run_id)
+JOIN performance_run_output_new AS perfOut USING (scenario_id, performance_run_id, operation_id, operation, operation_type);
+)";
+
+    // The old tables are dropped after all outputs were copied, the new tables take their names
+    constexpr std::string_view g_replace_tables = R"(
+DROP TABLE emissions_run_output_segments;
+DROP TABLE emissions_run_output_operations;
+DROP TABLE emissions_run_output;
+DROP TABLE noise_run_output_single_event;
+DROP TABLE performance_run_output_points;
+DROP TABLE performance_run_output;
+
+ALTER TABLE performance_run_output_new RENAME TO performance_run_output;
+ALTER TABLE performance_run_output_points_new RENAME TO performance_run_output_points;
+ALTER TABLE noise_run_output_single_event_new RENAME TO noise_run_output_single_event;
+ALTER TABLE emissions_run_output_new RENAME TO emissions_run_output;
+ALTER TABLE emissions_run_output_operations_new RENAME TO emissions_run_output_operations;
+ALTER TABLE emissions_run_output_segments_new RENAME TO emissions_run_output_segments;
+)";
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+namespace GRAPE::Schema::Elevator14 {
+    // Reference tables for the enums stored as integer codes, the id of each value is its position in the corresponding EnumStrings
+    constexpr std::string_view g_enum_tables = R"(
+CREATE TABLE enum_operation (
+    id   INTEGER PRIMARY KEY,
+    name TEXT    NOT NULL
+                 UNIQUE
+);
+
+INSERT INTO enum_operation VALUES (0, 'Arrival'), (1, 'Departure');
+
+CREATE TABLE enum_operation_type (
+    id   INTEGER PRIMARY KEY,
+    name TEXT    NOT NULL
+                 UNIQUE
+);
+
+INSERT INTO enum_operation_type VALUES (0, 'Flight'), (1, 'Track 4D');
+
+CREATE TABLE enum_flight_phase (
+    id   INTEGER PRIMARY KEY,
+    name TEXT    NOT NULL
+                 UNIQUE
+);
+
+INSERT INTO enum_flight_phase VALUES (0, 'Approach'), (1, 'Landing Roll'), (2, 'Takeoff Roll'), (3, 'Initial Climb'), (4, 'Climb');
+
+CREATE TABLE enum_point_origin (
+    id   INTEGER PRIMARY KEY,
+    name TEXT    NOT NULL
+                 UNIQUE
+);
+
+INSERT INTO enum_point_origin VALUES (0, 'Route'), (1, 'Profile'), (2, 'Route & Profile'), (3, 'Track 4D'), (4, 'Speed Segmentation'), (5, 'Doc29 Takeoff Roll Segmentation'), (6, 'Doc29 Final Approach Segmentation'), (7, 'Doc29 Initial Climb Segmentation');
+)";
+
+    // Ids are kept, the noise and emissions outputs reference them
+    constexpr std::string_view g_performance_run_output = R"(
+CREATE TABLE performance_run_output_new (
+    id                 INTEGER PRIMARY KEY,
+    scenario_id        TEXT    NOT NULL,
+    performance_run_id TEXT    NOT NULL,
+    operation_id       TEXT    NOT NULL,
+    operation          INTEGER NOT NULL
+                               CHECK (operation BETWEEN 0 AND 1),
+    operation_type     INTEGER NOT NULL
+                               CHECK (operation_type BETWEEN 0 AND 1),
+    UNIQUE (
+        scenario_id,
+        performance_run_id,
+        operation_id,
+        operation,
+        operation_type
+    ),
+    CONSTRAINT fk_performance_run FOREIGN KEY (
+        scenario_id,
+        performance_run_id
+    )
+    REFERENCES performance_run (scenario_id,
+    id) ON DELETE CASCADE
+        ON UPDATE CASCADE
+);
+
+INSERT INTO performance_run_output_new
+SELECT perfOut.id, perfOut.scenario_id, perfOut.performance_run_id, perfOut.operation_id, op.id, opType.id
+FROM performance_run_output AS perfOut
+JOIN enum_operation AS op ON op.name = perfOut.operation
+JOIN enum_operation_type AS opType ON opType.name = perfOut.operation_type;
+
+CREATE TABLE performance_run_output_points_new (
+    performance_run_output_id       INTEGER NOT NULL,
+    point_number                    INTEGER NOT NULL,
+    point_origin                    INTEGER NOT NULL
+                                            CHECK (point_origin BETWEEN 0 AND 7),
+    flight_phase                    INTEGER NOT NULL
+                                            CHECK (flight_phase BETWEEN 0 AND 4),
+    cumulative_ground_distance      REAL    NOT NULL,
+    longitude                       REAL    NOT NULL,
+    latitude                        REAL    NOT NULL,
+    altitude_msl                    REAL    NOT NULL,
+    true_airspeed                   REAL    NOT NULL,
+    ground_speed                    REAL    NOT NULL,
+    corrected_net_thrust_per_engine REAL    NOT NULL,
+    bank_angle                      REAL    NOT NULL,
+    fuel_flow_per_engine            REAL    NOT NULL,
+    PRIMARY KEY (
+        performance_run_output_id,
+        point_number
+    ),
+    CONSTRAINT fk_performance_run_output FOREIGN KEY (
+        performance_run_output_id
+    )
+    REFERENCES performance_run_output (id) ON DELETE CASCADE
+)
+WITHOUT ROWID;
+
+INSERT INTO performance_run_output_points_new
+SELECT pts.performance_run_output_id, pts.point_number, ptOrigin.id, flPhase.id, pts.cumulative_ground_distance, pts.longitude, pts.latitude, pts.altitude_msl, pts.true_airspeed, pts.ground_speed, pts.corrected_net_thrust_per_engine, pts.bank_angle, pts.fuel_flow_per_engine
+FROM performance_run_output_points AS pts
+JOIN enum_point_origin AS ptOrigin ON ptOrigin.name = pts.point_origin
+JOIN enum_flight_phase AS flPhase ON flPhase.name = pts.flight_phase;
+
+DROP TABLE performance_run_output_points;
+DROP TABLE performance_run_output;
+
+ALTER TABLE performance_run_output_new RENAME TO performance_run_output;
+ALTER TABLE performance_run_output_points_new RENAME TO performance_run_output_points;
+)";
+
+    // The operation column is kept as text, it references the operations tables
+    constexpr std::string_view g_operations_tracks_4d_points = R"(
+CREATE TABLE operations_tracks_4d_points_new (
+    operation_id                    TEXT    NOT NULL,
+    operation                       TEXT    NOT NULL
+                                            CHECK (operation IN ('Arrival', 'Departure') ),
+    point_number                    INTEGER NOT NULL
+                                            CHECK (point_number >= 1),
+    flight_phase                    INTEGER NOT NULL
+                                            CHECK (flight_phase BETWEEN 0 AND 4),
+    cumulative_ground_distance      REAL    NOT NULL,
+    longitude                       REAL    NOT NULL
+                                            CHECK (longitude BETWEEN -180.0 AND 180.0),
+    latitude                        REAL    NOT NULL
+                                            CHECK (latitude BETWEEN -90.0 AND 90.0),
+    altitude_msl                    REAL    NOT NULL,
+    true_airspeed                   REAL    NOT NULL
+                                            CHECK (true_airspeed >= 0.0),
+    groundspeed                     REAL    NOT NULL
+                                            CHECK (groundspeed >= 0.0),
+    corrected_net_thrust_per_engine REAL    NOT NULL,
+    bank_angle                      REAL    NOT NULL
+                                            CHECK (bank_angle BETWEEN -90.0 AND 90.0)
+                                            DEFAULT (0.0),
+    fuel_flow_per_engine            REAL    NOT NULL
+                                            CHECK (fuel_flow_per_engine >= 0.0)
+                                            DEFAULT (0.0),
+    PRIMARY KEY (
+        operation_id,
+        operation,
+        point_number
+    ),
+    CONSTRAINT fk_track_4d FOREIGN KEY (
+        operation_id,
+        operation
+    )
+    REFERENCES operations_tracks_4d (id,
+    operation) ON DELETE CASCADE
+        ON UPDATE CASCADE
+);
+
+INSERT INTO operations_tracks_4d_points_new
+SELECT pts.operation_id, pts.operation, pts.point_number, flPhase.id, pts.cumulative_ground_distance, pts.longitude, pts.latitude, pts.altitude_msl, pts.true_airspeed, pts.groundspeed, pts.corrected_net_thrust_per_engine, pts.bank_angle, pts.fuel_flow_per_engine
+FROM operations_tracks_4d_points AS pts
+JOIN enum_flight_phase AS flPhase ON flPhase.name = pts.flight_phase;
+
+DROP TABLE operations_tracks_4d_points;
+
+ALTER TABLE operations_tracks_4d_points_new RENAME TO operations_tracks_4d_points;
+)";
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace GRAPE::Schema::Elevator15 {
+    // Outputs are moved to the output database, which must be attached before elevating. Parent tables are copied first and dropped last.
+    constexpr std::string_view g_move_outputs = R"(
+INSERT INTO output.performance_run_output SELECT * FROM main.performance_run_output;
+INSERT INTO output.performance_run_output_points SELECT * FROM main.performance_run_output_points;
+INSERT INTO output.noise_run_output SELECT * FROM main.noise_run_output;
+INSERT INTO output.noise_run_output_receptors SELECT * FROM main.noise_run_output_receptors;
+INSERT INTO output.noise_run_output_single_event SELECT * FROM main.noise_run_output_single_event;
+INSERT INTO output.noise_run_output_cumulative SELECT * FROM main.noise_run_output_cumulative;
+INSERT INTO output.noise_run_output_cumulative_number_above SELECT * FROM main.noise_run_output_cumulative_number_above;
+INSERT INTO output.emissions_run_output SELECT * FROM main.emissions_run_output;
+INSERT INTO output.emissions_run_output_operations SELECT * FROM main.emissions_run_output_operations;
+INSERT INTO output.emissions_run_output_segments SELECT * FROM main.emissions_run_output_segments;
+
+DROP TABLE main.emissions_run_output_segments;
+DROP TABLE main.emissions_run_output_operations;
+DROP TABLE main.emissions_run_output;
+DROP TABLE main.noise_run_output_cumulative_number_above;
+DROP TABLE main.noise_run_output_cumulative;
+DROP TABLE main.noise_run_output_single_event;
+DROP TABLE main.noise_run_output_receptors;
+DROP TABLE main.noise_run_output;
+DROP TABLE main.performance_run_output_points;
+DROP TABLE main.performance_run_output;
+)";
+}
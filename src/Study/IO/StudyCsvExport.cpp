@@ -0,0 +1,559 @@
+// Copyright (C) 2023 Goncalo Soares Roque 
+
+#include "GRAPE_pch.h"
+
+#include "StudyCsvExport.h"
+
+#include "Csv.h"
+#include "Study.h"
+
+namespace GRAPE::IO::CSV {
+    void exportDoc29Noise(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting Doc29 Noise to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "ID",
+            "Lateral Directivity",
+            "Start of Roll Correction"
+        );
+
+        std::size_t row = 0;
+        for (const auto& doc29Ns : Stdy.Doc29Noises)
+        {
+            csv.setCell(row, 0, doc29Ns.Name);
+            csv.setCell(row, 1, Doc29Noise::LateralDirectivities.toString(doc29Ns.LateralDir));
+            csv.setCell(row, 2, Doc29Noise::SORCorrections.toString(doc29Ns.SOR));
+            ++row;
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported Doc29 Noise to '{}'.", CsvPath);
+        }
+    }
+
+    void exportDoc29NoiseSpectrum(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting Doc29 Noise spectrum to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "Doc29 Noise ID",
+            "Operation"
+        );
+        {
+            std::size_t col = 1;
+            for (const auto& freq : OneThirdOctaveCenterFrequencies)
+                csv.setColumnName(++col, std::format("Level {:.0} ft", freq));
+        }
+
+        std::size_t row = 0;
+        const auto addSpectrum = [&](OperationType OpType, const Doc29Spectrum& Doc29Spec) {
+            csv.setCell(row, 0, Doc29Spec.parentDoc29Noise().Name);
+            csv.setCell(row, 1, OperationTypes.toString(OpType));
+
+            std::size_t col = 1;
+            for (const auto& lvl : Doc29Spec)
+                csv.setCell(row, ++col, lvl);
+            ++row;
+
+            };
+
+        for (const auto& doc29Ns : Stdy.Doc29Noises)
+        {
+            addSpectrum(OperationType::Arrival, doc29Ns.ArrivalSpectrum);
+            addSpectrum(OperationType::Departure, doc29Ns.DepartureSpectrum);
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported Doc29 Noise spectrum to '{}'.", CsvPath);
+        }
+    }
+
+    void exportFleet(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting fleet to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "ID",
+            "Number of Engines",
+            "Doc29 Aircraft ID",
+            "SFI ID",
+            "LTO ID",
+            "Doc29 Noise ID",
+            "Doc29 Noise Delta Arrival",
+            "Doc29 Noise Delta Departure"
+        );
+
+        std::size_t row = 0;
+        for (const auto& acft : Stdy.Aircrafts)
+        {
+            csv.setCell(row, 0, acft.Name);
+            csv.setCell(row, 1, acft.EngineCount);
+            if (acft.validDoc29Performance())
+                csv.setCell(row, 2, acft.Doc29Acft->Name);
+            if (acft.validSFI())
+                csv.setCell(row, 3, acft.SFIFuel->Name);
+            if (acft.validLTOEngine())
+                csv.setCell(row, 4, acft.LTOEng->Name);
+            if (acft.validDoc29Noise())
+                csv.setCell(row, 5, acft.Doc29Ns->Name);
+            csv.setCell(row, 6, acft.Doc29NoiseDeltaArrivals);
+            csv.setCell(row, 7, acft.Doc29NoiseDeltaDepartures);
+            ++row;
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported fleet to '{}'.", CsvPath);
+        }
+    }
+
+    void exportRoutesSimple(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting simple routes to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "Airport ID",
+            "Runway ID",
+            "Operation",
+            "Route ID",
+            "Longitude",
+            "Latitude"
+        );
+
+        std::size_t row = 0;
+        for (const auto& apt : Stdy.Airports)
+        {
+            for (const auto& rwy : apt.Runways | std::views::values)
+            {
+                for (const auto& rte : rwy.ArrivalRoutes | std::views::values)
+                {
+                    if (rte->type() == Route::Type::Simple)
+                        RouteExporter(csv, row, *rte);
+                }
+
+                for (const auto& rte : rwy.DepartureRoutes | std::views::values)
+                {
+                    if (rte->type() == Route::Type::Simple)
+                        RouteExporter(csv, row, *rte);
+                }
+            }
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported simple routes to '{}'.", CsvPath);
+        }
+    }
+
+    void exportRoutesRnp(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting RNP routes to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "Airport ID",
+            "Runway ID",
+            "Operation",
+            "Route ID",
+            "RNP Step Type",
+            "Longitude",
+            "Latitude",
+            "Center Longitude",
+            "Center Latitude"
+        );
+
+        std::size_t row = 0;
+        for (const auto& apt : Stdy.Airports)
+        {
+            for (const auto& rwy : apt.Runways | std::views::values)
+            {
+                for (const auto& rte : rwy.ArrivalRoutes | std::views::values)
+                {
+                    if (rte->type() == Route::Type::Rnp)
+                        RouteExporter(csv, row, *rte);
+                }
+
+                for (const auto& rte : rwy.DepartureRoutes | std::views::values)
+                {
+                    if (rte->type() == Route::Type::Rnp)
+                        RouteExporter(csv, row, *rte);
+                }
+            }
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported RNP routes to '{}'.", CsvPath);
+        }
+    }
+
+    void exportTracks4d(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting tracks 4D to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "ID",
+            "Operation",
+            "Time",
+            "Count",
+            "Fleet ID"
+        );
+
+        std::size_t row = 0;
+
+        for (const auto& arrTrack4d : Stdy.Operations.track4dArrivals() | std::views::values)
+        {
+            csv.setCell(row, 0, arrTrack4d.Name);
+            csv.setCell(row, 1, OperationTypes.toString(arrTrack4d.operationType()));
+            csv.setCell(row, 2, timeToUtcString(arrTrack4d.Time));
+            csv.setCell(row, 3, arrTrack4d.Count);
+            csv.setCell(row, 4, arrTrack4d.aircraft().Name);
+            ++row;
+        }
+
+        for (const auto& depTrack4d : Stdy.Operations.track4dDepartures() | std::views::values)
+        {
+            csv.setCell(row, 0, depTrack4d.Name);
+            csv.setCell(row, 1, OperationTypes.toString(depTrack4d.operationType()));
+            csv.setCell(row, 2, timeToUtcString(depTrack4d.Time));
+            csv.setCell(row, 3, depTrack4d.Count);
+            csv.setCell(row, 4, depTrack4d.aircraft().Name);
+            ++row;
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported 4D tracks to '{}'.", CsvPath);
+        }
+    }
+
+    void exportScenarios(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting scenarios to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "ID",
+            "# Operations",
+            "# Arrivals",
+            "# Departures",
+            "# Flights",
+            "# Tracks 4D",
+            "# Arrival Flights",
+            "# Departure Flights",
+            "# Arrival Tracks 4D",
+            "# Departure Tracks 4D",
+            "Start Time",
+            "End Time"
+        );
+
+        std::size_t row = 0;
+        for (const auto& scen : Stdy.Scenarios)
+        {
+            csv.setCell(row, 0, scen.Name);
+            csv.setCell(row, 1, static_cast<int>(scen.size()));
+            csv.setCell(row, 2, static_cast<int>(scen.arrivalsSize()));
+            csv.setCell(row, 3, static_cast<int>(scen.departuresSize()));
+            csv.setCell(row, 4, static_cast<int>(scen.flightsSize()));
+            csv.setCell(row, 5, static_cast<int>(scen.tracks4dSize()));
+            csv.setCell(row, 6, static_cast<int>(scen.FlightArrivals.size()));
+            csv.setCell(row, 7, static_cast<int>(scen.FlightDepartures.size()));
+            csv.setCell(row, 8, static_cast<int>(scen.Track4dArrivals.size()));
+            csv.setCell(row, 9, static_cast<int>(scen.Track4dDepartures.size()));
+            const auto [startTime, endTime] = scen.timeSpan();
+            if (startTime != std::chrono::tai_seconds::max())
+                csv.setCell(row, 10, timeToUtcString(startTime));
+            if (endTime != std::chrono::tai_seconds::min())
+                csv.setCell(row, 11, timeToUtcString(endTime));
+
+            ++row;
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported scenarios to '{}'.", CsvPath);
+        }
+    }
+
+    void exportScenariosOperations(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting scenarios operations to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "Scenario ID",
+            "ID",
+            "Operation",
+            "Type"
+        );
+
+        std::size_t row = 0;
+
+        for (const auto& scen : Stdy.Scenarios)
+        {
+            for (const auto& opRef : scen.FlightArrivals)
+            {
+                const auto& op = opRef.get();
+                csv.setCell(row, 0, scen.Name);
+                csv.setCell(row, 1, op.Name);
+                csv.setCell(row, 2, OperationTypes.toString(op.operationType()));
+                csv.setCell(row, 3, Operation::Types.toString(op.type()));
+                ++row;
+            }
+
+            for (const auto& opRef : scen.FlightDepartures)
+            {
+                const auto& op = opRef.get();
+                csv.setCell(row, 0, scen.Name);
+                csv.setCell(row, 1, op.Name);
+                csv.setCell(row, 2, OperationTypes.toString(op.operationType()));
+                csv.setCell(row, 3, Operation::Types.toString(op.type()));
+                ++row;
+            }
+
+            for (const auto& opRef : scen.Track4dArrivals)
+            {
+                const auto& op = opRef.get();
+                csv.setCell(row, 0, scen.Name);
+                csv.setCell(row, 1, op.Name);
+                csv.setCell(row, 2, OperationTypes.toString(op.operationType()));
+                csv.setCell(row, 3, Operation::Types.toString(op.type()));
+                ++row;
+            }
+
+            for (const auto& opRef : scen.Track4dDepartures)
+            {
+                const auto& op = opRef.get();
+                csv.setCell(row, 0, scen.Name);
+                csv.setCell(row, 1, op.Name);
+                csv.setCell(row, 2, OperationTypes.toString(op.operationType()));
+                csv.setCell(row, 3, Operation::Types.toString(op.type()));
+                ++row;
+            }
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported scenarios operations to '{}'.", CsvPath);
+        }
+    }
+
+    void exportNoiseRuns(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting noise runs to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "Scenario ID",
+            "Performance Run ID",
+            "ID",
+            "Noise Model",
+            "Atmospheric Absorption",
+            "Receptor Set Type",
+            "Save Single Event Metrics"
+        );
+
+        std::size_t row = 0;
+        for (const auto& scen : Stdy.Scenarios)
+        {
+            for (const auto& perfRun : scen.PerformanceRuns | std::views::values)
+            {
+                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+                {
+                    const auto& spec = nsRun.NsRunSpec;
+                    csv.setCell(row, 0, scen.Name);
+                    csv.setCell(row, 1, perfRun.Name);
+                    csv.setCell(row, 2, nsRun.Name);
+                    csv.setCell(row, 3, NoiseModelTypes.toString(spec.NoiseMdl));
+                    csv.setCell(row, 4, AtmosphericAbsorption::Types.toString(spec.AtmAbsorptionType));
+                    csv.setCell(row, 5, ReceptorSet::Types.toString(spec.ReceptSet->type()));
+                    csv.setCell(row, 6, static_cast<int>(spec.SaveSingleMetrics));
+
+                    ++row;
+                }
+            }
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported noise runs to '{}'.", CsvPath);
+        }
+    }
+
+    void exportNoiseRunsCumulativeMetrics(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting noise runs cumulative metrics to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "Scenario ID",
+            "Performance Run ID",
+            "Noise Run ID",
+            "ID",
+            "Threshold (dB)",
+            "Averaging Time Constant (dB)",
+            "Start Time",
+            "End Time",
+            "Number Above Thresholds (dB)"
+        );
+
+        std::size_t row = 0;
+        for (const auto& scen : Stdy.Scenarios)
+        {
+            for (const auto& perfRun : scen.PerformanceRuns | std::views::values)
+            {
+                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+                {
+                    for (const auto& cumMetric : nsRun.CumulativeMetrics | std::views::values)
+                    {
+                        csv.setCell(row, 0, scen.Name);
+                        csv.setCell(row, 1, perfRun.Name);
+                        csv.setCell(row, 2, nsRun.Name);
+                        csv.setCell(row, 3, cumMetric.Name);
+                        csv.setCell(row, 4, cumMetric.Threshold);
+                        csv.setCell(row, 5, cumMetric.AveragingTimeConstant);
+                        csv.setCell(row, 6, timeToUtcString(cumMetric.StartTimePoint));
+                        csv.setCell(row, 7, timeToUtcString(cumMetric.EndTimePoint));
+
+                        if (!cumMetric.numberAboveThresholds().empty())
+                        {
+                            std::stringstream naThrSs;
+                            for (const auto& naThr : cumMetric.numberAboveThresholds())
+                                naThrSs << naThr << " ";
+                            std::string naThrStr = naThrSs.str();
+                            naThrStr.pop_back();
+                            csv.setCell(row, 8, naThrStr);
+                        }
+                        ++row;
+                    }
+                }
+            }
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported noise runs cumulative metrics to '{}'.", CsvPath);
+        }
+    }
+
+    void exportNoiseRunsCumulativeMetricsWeights(const Study& Stdy, const std::string& CsvPath) {
+        Csv csv;
+        try { csv.setExport(CsvPath); }
+        catch (const std::exception& err)
+        {
+            Log::io()->error("Exporting noise runs cumulative metrics weights to '{}'. {}", CsvPath, err.what());
+            return;
+        }
+
+        csv.setColumnNames(
+            "Scenario ID",
+            "Performance Run ID",
+            "Noise Run ID",
+            "Noise Run Cumulative Metric ID",
+            "Time of Day",
+            "Weight"
+        );
+
+        std::size_t row = 0;
+        for (const auto& scen : Stdy.Scenarios)
+        {
+            for (const auto& perfRun : scen.PerformanceRuns | std::views::values)
+            {
+                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+                {
+                    for (const auto& cumMetric : nsRun.CumulativeMetrics | std::views::values)
+                    {
+                        for (const auto& [time, weight] : cumMetric.weights())
+                        {
+                            csv.setCell(row, 0, scen.Name);
+                            csv.setCell(row, 1, perfRun.Name);
+                            csv.setCell(row, 2, nsRun.Name);
+                            csv.setCell(row, 3, cumMetric.Name);
+                            csv.setCell(row, 4, durationToString(time));
+                            csv.setCell(row, 5, weight);
+                            ++row;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (row)
+        {
+            csv.write();
+            Log::io()->info("Exported noise runs cumulative metrics weights to '{}'.", CsvPath);
+        }
+    }
+
+    void exportStudyFiles(const Study& Stdy, const std::string& FolderPath) {
+        exportDoc29Noise(Stdy, std::format("{}/Doc29 Noise.csv", FolderPath));
+        exportDoc29NoiseSpectrum(Stdy, std::format("{}/Doc29 Noise Spectrum.csv", FolderPath));
+        exportFleet(Stdy, std::format("{}/Fleet.csv", FolderPath));
+        exportRoutesSimple(Stdy, std::format("{}/Routes Simple.csv", FolderPath));
+        exportRoutesRnp(Stdy, std::format("{}/Routes RNP.csv", FolderPath));
+        exportTracks4d(Stdy, std::format("{}/Tracks 4D.csv", FolderPath));
+        exportScenarios(Stdy, std::format("{}/Scenarios.csv", FolderPath));
+        exportScenariosOperations(Stdy, std::format("{}/Scenarios Operations.csv", FolderPath));
+        exportNoiseRuns(Stdy, std::format("{}/Noise Runs.csv", FolderPath));
+        exportNoiseRunsCumulativeMetrics(Stdy, std::format("{}/Noise Runs Cumulative Metrics.csv", FolderPath));
+        exportNoiseRunsCumulativeMetricsWeights(Stdy, std::format("{}/Noise Runs Cumulative Metrics Weights.csv", FolderPath));
+    }
+}
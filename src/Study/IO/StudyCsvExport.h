@@ -0,0 +1,35 @@
+// Copyright (C) 2023 Goncalo Soares Roque 
+
+#pragma once
+
+namespace GRAPE {
+    class Study;
+
+    /**
+    * Exports of the study tables which don't depend on the unit settings of the graphical application.
+    * Available to the graphical application and to the command line interface.
+    */
+    namespace IO::CSV {
+        void exportDoc29Noise(const Study& Stdy, const std::string& CsvPath);
+        void exportDoc29NoiseSpectrum(const Study& Stdy, const std::string& CsvPath);
+
+        void exportFleet(const Study& Stdy, const std::string& CsvPath);
+
+        void exportRoutesSimple(const Study& Stdy, const std::string& CsvPath);
+        void exportRoutesRnp(const Study& Stdy, const std::string& CsvPath);
+
+        void exportTracks4d(const Study& Stdy, const std::string& CsvPath);
+
+        void exportScenarios(const Study& Stdy, const std::string& CsvPath);
+        void exportScenariosOperations(const Study& Stdy, const std::string& CsvPath);
+
+        void exportNoiseRuns(const Study& Stdy, const std::string& CsvPath);
+        void exportNoiseRunsCumulativeMetrics(const Study& Stdy, const std::string& CsvPath);
+        void exportNoiseRunsCumulativeMetricsWeights(const Study& Stdy, const std::string& CsvPath);
+
+        /**
+        * @brief Exports all the tables above to FolderPath, with the same file names as the folder exports of the graphical application.
+        */
+        void exportStudyFiles(const Study& Stdy, const std::string& FolderPath);
+    }
+}
@@ -14,7 +14,7 @@
 
 namespace GRAPE {
 
-    EmissionsRunJob::EmissionsRunJob(Constraints& Blocks, EmissionsRun& EmissionsRn, std::size_t ThreadCount) : m_Blocks(Blocks), m_EmissionsRun(EmissionsRn), m_ThreadCount(ThreadCount) {
+    EmissionsRunJob::EmissionsRunJob(Constraints& Blocks, EmissionsRun& EmissionsRn) : m_Blocks(Blocks), m_EmissionsRun(EmissionsRn) {
         m_Status.store(Status::Ready);
     }
 
@@ -49,51 +49,68 @@ namespace GRAPE {
         default: GRAPE_ASSERT(false) break;
         }
 
-        const auto& perfRunOutput = m_EmissionsRun.parentPerformanceRun().output();
-        m_TotalCount = perfRunOutput.size();
+        auto& perfRunOutput = m_EmissionsRun.parentPerformanceRun().output();
+
+        // Performance run still running, outputs are consumed as they are saved
+        const auto stream = perfRunOutput.subscribe();
 
         // Initialize Fuel & Emissions Run Output
         m_EmissionsRun.output().createOutput();
 
         // Prepare BFFM2 4 points interpolation
-        for (auto op : perfRunOutput.arrivalOutputs())
-            m_EmissionsCalculator->addLTOEngine(op.get().aircraft().LTOEng);
-
-        for (auto op : perfRunOutput.departureOutputs())
-            m_EmissionsCalculator->addLTOEngine(op.get().aircraft().LTOEng);
+        if (stream)
+        {
+            const Scenario& scen = m_EmissionsRun.parentScenario();
+            m_TotalCount = scen.size();
+            for (const Operation& op : scen.FlightArrivals)
+                m_EmissionsCalculator->addLTOEngine(op.aircraft().LTOEng);
+            for (const Operation& op : scen.FlightDepartures)
+                m_EmissionsCalculator->addLTOEngine(op.aircraft().LTOEng);
+            for (const Operation& op : scen.Track4dArrivals)
+                m_EmissionsCalculator->addLTOEngine(op.aircraft().LTOEng);
+            for (const Operation& op : scen.Track4dDepartures)
+                m_EmissionsCalculator->addLTOEngine(op.aircraft().LTOEng);
+        }
+        else if (!perfRunOutput.pointsSaved())
+        {
+            // Subscription refused, outputs published before this run started are no longer in memory
+            m_Status.store(Status::Stopped);
+            Log::study()->error("Emissions run '{}' of performance run '{}' of scenario '{}' stopped. Performance output points were not saved and some outputs were evicted from memory before the emissions run started.", m_EmissionsRun.Name, m_EmissionsRun.parentPerformanceRun().Name, m_EmissionsRun.parentScenario().Name);
+        }
+        else
+        {
+            m_TotalCount = perfRunOutput.size();
+            for (auto op : perfRunOutput.arrivalOutputs())
+                m_EmissionsCalculator->addLTOEngine(op.get().aircraft().LTOEng);
 
-        // Initialize Job Threads
-        for (std::size_t i = 0; i < m_ThreadCount; i++)
-            m_JobThreads.emplace_back(std::make_unique<JobThread>(m_Tasks));
+            for (auto op : perfRunOutput.departureOutputs())
+                m_EmissionsCalculator->addLTOEngine(op.get().aircraft().LTOEng);
+        }
 
         // Queue Operations
-        for (const auto opArr : perfRunOutput.arrivalOutputs())
+        bool complete = true;
+        if (stream)
         {
-            m_Tasks.pushTask([&, opArr] {
-                const auto out = m_EmissionsCalculator->calculateEmissions(opArr, perfRunOutput.arrivalOutput(opArr));
-                m_EmissionsRun.output().addOperationOutput(opArr, out, m_EmissionsRun.EmissionsRunSpec.SaveSegmentResults);
-                ++m_CalculatedCount;
-                });
+            complete = calculateStream(*stream);
         }
-
-        for (const auto opDep : perfRunOutput.departureOutputs())
+        else if (running())
         {
-            m_Tasks.pushTask([&, opDep] {
-                const auto out = m_EmissionsCalculator->calculateEmissions(opDep, perfRunOutput.departureOutput(opDep));
-                m_EmissionsRun.output().addOperationOutput(opDep, out, m_EmissionsRun.EmissionsRunSpec.SaveSegmentResults);
-                ++m_CalculatedCount;
-                });
-        }
+            for (const auto opArr : perfRunOutput.arrivalOutputs())
+                m_Tasks.run([&, opArr] { calculate(opArr, *perfRunOutput.arrivalOutput(opArr)); });
+
+            for (const auto opDep : perfRunOutput.departureOutputs())
+                m_Tasks.run([&, opDep] { calculate(opDep, *perfRunOutput.departureOutput(opDep)); });
 
-        // Run
-        if (running())
-            for (const auto& jobThread : m_JobThreads)
-                jobThread->run();
+            // Synchronization
+            m_Tasks.wait();
+        }
 
-        // Synchronization
-        for (const auto& jobThread : m_JobThreads)
-            jobThread->join();
-        m_JobThreads.clear();
+        // Performance run stopped before adding all outputs
+        if (!complete && m_Status.load() == Status::Running)
+        {
+            m_Status.store(Status::Stopped);
+            Log::study()->error("Emissions run '{}' of performance run '{}' of scenario '{}' stopped. The performance run was stopped before finishing.", m_EmissionsRun.Name, m_EmissionsRun.parentPerformanceRun().Name, m_EmissionsRun.parentScenario().Name);
+        }
 
         if (m_Status.load() == Status::Running)
         {
@@ -103,9 +120,50 @@ namespace GRAPE {
         }
     }
 
+    /**
+    * Each batch of items is calculated before popping the next one, the stream holds the outputs not yet consumed.
+    */
+    bool EmissionsRunJob::calculateStream(PerformanceRunOutput::Stream& Strm) {
+        const auto& perfRunOutput = m_EmissionsRun.parentPerformanceRun().output();
+
+        while (running())
+        {
+            auto items = Strm.pop();
+            if (items.empty())
+                break;
+
+            // Outputs saved before subscribing are published without value
+            for (auto& [op, perfOutput] : items)
+            {
+                m_Tasks.run([&, op, perfOutput = std::move(perfOutput)] {
+                    const auto out = perfOutput ? perfOutput : perfRunOutput.output(*op);
+                    calculate(*op, *out);
+                    });
+            }
+
+            // Synchronization
+            m_Tasks.wait();
+        }
+
+        // Stopped while the performance run is running
+        if (!running())
+        {
+            Strm.cancel();
+            return true;
+        }
+
+        return Strm.complete();
+    }
+
+    void EmissionsRunJob::calculate(const Operation& Op, const PerformanceOutput& PerfOutput) {
+        const auto out = m_EmissionsCalculator->calculateEmissions(Op, PerfOutput);
+        m_EmissionsRun.output().addOperationOutput(Op, out, m_EmissionsRun.EmissionsRunSpec.SaveSegmentResults);
+        ++m_CalculatedCount;
+    }
+
     void EmissionsRunJob::stop() {
         m_Status.store(Status::Stopped);
-        m_Tasks.clear();
+        m_Tasks.cancel();
     }
 
     void EmissionsRunJob::reset() {
@@ -114,6 +172,7 @@ namespace GRAPE {
         m_EmissionsRun.output().clear();
 
         m_EmissionsCalculator.reset();
+        m_Tasks.reset();
 
         m_TotalCount = 0;
         m_CalculatedCount = 0;
@@ -5,6 +5,7 @@
 #include "Job.h"
 
 #include "Emissions/EmissionsCalculator.h"
+#include "Scenario/PerformanceRunOutput.h"
 
 namespace GRAPE {
     class Constraints;
@@ -13,7 +14,7 @@ namespace GRAPE {
     class EmissionsRunJob : public Job {
     public:
         // Constructors & Destructor
-        EmissionsRunJob(Constraints& Blocks, EmissionsRun& EmissionsRn, std::size_t ThreadCount);
+        EmissionsRunJob(Constraints& Blocks, EmissionsRun& EmissionsRn);
         EmissionsRunJob(const EmissionsRunJob&) = delete;
         EmissionsRunJob(EmissionsRunJob&&) = delete;
         EmissionsRunJob& operator=(const EmissionsRunJob&) = delete;
@@ -27,6 +28,7 @@ namespace GRAPE {
 
         // Main thread
         float progress() const override { return static_cast<float>(m_CalculatedCount) / static_cast<float>(m_TotalCount); }
+        bool streams() const override { return true; }
     private:
         Constraints& m_Blocks;
 
@@ -37,9 +39,14 @@ namespace GRAPE {
         std::size_t m_TotalCount = 0;
         std::atomic_size_t m_CalculatedCount = 0;
 
-        std::size_t m_ThreadCount;
-        std::vector<std::unique_ptr<JobThread>> m_JobThreads{};
+        TaskGroup m_Tasks;
+    private:
+        /**
+        * @brief Calculates the operations as their performance outputs are published to Strm. Returns once the stream is closed or the job is stopped.
+        * @return False if the performance run was stopped before publishing all outputs.
+        */
+        bool calculateStream(PerformanceRunOutput::Stream& Strm);
 
-        MtQueue m_Tasks;
+        void calculate(const Operation& Op, const PerformanceOutput& PerfOutput);
     };
 }
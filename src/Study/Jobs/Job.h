@@ -18,13 +18,27 @@ namespace GRAPE {
 
         virtual float progress() const { return 0.5f; }
 
+        /**
+        * @brief If true, the job can be started while its dependencies are running and consumes their outputs as they are produced.
+        */
+        [[nodiscard]] virtual bool streams() const { return false; }
+
         [[nodiscard]] bool ready() const { return m_Status.load() == Status::Ready; }
         [[nodiscard]] bool waiting() const { return m_Status.load() == Status::Waiting; }
         [[nodiscard]] bool running() const { return m_Status.load() == Status::Running; }
         [[nodiscard]] bool finished() const { return m_Status.load() == Status::Finished; }
         [[nodiscard]] bool stopped() const { return m_Status.load() == Status::Stopped; }
+        [[nodiscard]] bool outdated() const { return m_Status.load() == Status::Outdated; }
 
         void setFinished() { m_Status.store(Status::Finished); }
+
+        /**
+        * @brief Marks a finished job as outdated, its outputs are updated incrementally when queued again.
+        */
+        void setOutdated() {
+            auto finished = Status::Finished;
+            m_Status.compare_exchange_strong(finished, Status::Outdated);
+        }
     protected:
         enum class Status {
             Ready = 0,
@@ -32,6 +46,7 @@ namespace GRAPE {
             Running,
             Finished,
             Stopped,
+            Outdated,
         };
         std::atomic<Status> m_Status;
     };
@@ -81,31 +96,4 @@ namespace GRAPE {
         mutable std::mutex m_TasksMutex;
     };
 
-    class JobThread {
-    public:
-        explicit JobThread(MtQueue& Queue) : m_Queue(Queue) {}
-        JobThread(const JobThread&) = delete;
-        JobThread(JobThread&&) = delete;
-        JobThread& operator=(const JobThread&) = delete;
-        JobThread& operator=(JobThread&&) = delete;
-        ~JobThread() {
-            if (m_Thread.joinable())
-                m_Thread.join();
-        }
-
-        void run() { m_Thread = std::thread([&] { job(); }); }
-        void join() {
-            if (m_Thread.joinable())
-                m_Thread.join();
-        }
-    private:
-        std::thread m_Thread;
-
-        MtQueue& m_Queue;
-    private:
-        void job() const {
-            while (auto task = m_Queue.popTask())
-                task();
-        }
-    };
 }
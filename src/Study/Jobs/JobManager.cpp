@@ -5,79 +5,132 @@
 #include "JobManager.h"
 
 namespace GRAPE {
-    JobManager::JobManager() : m_RunSemaphore(1), m_WaitSemaphore(1), m_Thread([&] { threadLoop(); }) {}
+    JobManager::JobManager() {
+        for (std::size_t i = 0; i < std::max(s_ConcurrentJobs, std::size_t{ 1 }); ++i)
+            m_Threads.emplace_back([&] { threadLoop(); });
+    }
 
     JobManager::~JobManager() {}
 
-    void JobManager::queueJob(const std::shared_ptr<Job>& Jb) {
+    void JobManager::queueJob(const std::shared_ptr<Job>& Jb, const std::vector<std::shared_ptr<Job>>& Dependencies) {
         if (!Jb->queue())
             return;
         std::scoped_lock lck(m_Mutex);
         ++m_QueuedAndRunning;
-        ++m_TotalCount;
-        m_Jobs.push_back(Jb);
+        m_Jobs.push_back({ Jb, Dependencies });
         m_JobAvailableCv.notify_all();
     }
 
     void JobManager::waitForJobs() {
-        if (m_QueuedAndRunning == 0)
+        std::unique_lock lck(m_Mutex);
+        m_JobDoneCv.wait(lck, [this] { return m_QueuedAndRunning == 0; });
+    }
+
+    bool JobManager::isAnyRunning() const {
+        std::scoped_lock lck(m_Mutex);
+        return !m_Running.empty();
+    }
+
+    bool JobManager::isRunning(const std::shared_ptr<Job>& Jb) const {
+        std::scoped_lock lck(m_Mutex);
+        return std::ranges::find(m_Running, Jb) != m_Running.end();
+    }
+
+    /**
+    * A queued job is removed from the queue, a running job is stopped and this function returns once its run returns.
+    * Stopping before the job leaves the manager ensures that queued dependents see an unfinished dependency and are reset as well.
+    */
+    void JobManager::stopJob(const std::shared_ptr<Job>& Jb) {
+        if (!Jb)
             return;
 
         std::unique_lock lck(m_Mutex);
-        m_JobDoneCv.wait(lck, [this] { return m_QueuedAndRunning == 0; });
+        if (const auto it = std::ranges::find(m_Jobs, Jb, &QueuedJob::Jb); it != m_Jobs.end())
+        {
+            m_Jobs.erase(it);
+            --m_QueuedAndRunning;
+        }
+        Jb->stop();
+        m_JobDoneCv.wait(lck, [&] { return std::ranges::find(m_Running, Jb) == m_Running.end(); });
+        lck.unlock();
+
+        m_JobAvailableCv.notify_all();
+        m_JobDoneCv.notify_all();
     }
 
     void JobManager::resetJob(const std::shared_ptr<Job>& Jb) {
         if (!Jb)
             return;
 
-        const bool running = m_Running.load() == Jb;
-        m_WaitSemaphore.acquire();
-        Jb->stop();
-        if (running)
-            m_RunSemaphore.acquire();
+        stopJob(Jb);
         Jb->reset();
-        if (running)
-            m_RunSemaphore.release();
-        m_WaitSemaphore.release();
     }
 
     void JobManager::shutdown() {
         std::unique_lock lck(m_Mutex);
         m_Jobs.clear();
-        m_Stop.store(true);
+        m_Stop = true;
         m_JobAvailableCv.notify_all();
+        const auto running = m_Running;
         lck.unlock();
 
-        resetJob(m_Running);
-        m_Thread.join();
+        for (const auto& runJob : running)
+            resetJob(runJob);
+
+        for (auto& thread : m_Threads)
+            thread.join();
+        m_Threads.clear();
+    }
+
+    /**
+    * Streaming jobs are started as soon as their dependencies are running, never while they are queued as they would hold a thread which the dependencies need.
+    */
+    bool JobManager::startable(const QueuedJob& Queued) const {
+        return std::ranges::none_of(Queued.Dependencies, [&](const std::shared_ptr<Job>& Dependency) {
+            return std::ranges::find(m_Jobs, Dependency, &QueuedJob::Jb) != m_Jobs.end() || (!Queued.Jb->streams() && std::ranges::find(m_Running, Dependency) != m_Running.end());
+            });
     }
 
     void JobManager::threadLoop() {
         while (true)
         {
             std::unique_lock lck(m_Mutex);
-            m_JobAvailableCv.wait(lck, [this] { return m_Stop.load() || !m_Jobs.empty(); });
+            auto next = m_Jobs.end();
+            m_JobAvailableCv.wait(lck, [&] {
+                next = std::ranges::find_if(m_Jobs, [&](const QueuedJob& Queued) { return startable(Queued); });
+                return m_Stop || next != m_Jobs.end();
+                });
 
-            if (m_Stop.load())
+            if (m_Stop)
                 break;
 
-            if (!m_Jobs.empty())
+            const QueuedJob queued = std::move(*next);
+            m_Jobs.erase(next);
+            const bool dependenciesFinished = std::ranges::all_of(queued.Dependencies, [&](const std::shared_ptr<Job>& Dependency) {
+                return Dependency->finished() || (queued.Jb->streams() && !Dependency->stopped() && std::ranges::find(m_Running, Dependency) != m_Running.end());
+                });
+            const auto& runJob = queued.Jb;
+            m_Running.push_back(runJob);
+            lck.unlock();
+
+            if (!dependenciesFinished)
             {
-                m_Running.store(m_Jobs.front());
-                m_Jobs.pop_front();
-                lck.unlock();
-                m_RunSemaphore.acquire();
-                const auto runJob = m_Running.load();
-                if (runJob->waiting())
-                    runJob->run();
-                m_Running.store(nullptr);
-                --m_QueuedAndRunning;
-                m_RunSemaphore.release();
-                m_WaitSemaphore.acquire();
-                m_WaitSemaphore.release();
-                m_JobDoneCv.notify_all();
+                runJob->stop();
+                runJob->reset();
             }
+            else if (runJob->waiting())
+            {
+                runJob->run();
+            }
+
+            lck.lock();
+            std::erase(m_Running, runJob);
+            --m_QueuedAndRunning;
+            lck.unlock();
+
+            // Dependents of the job may now be started
+            m_JobAvailableCv.notify_all();
+            m_JobDoneCv.notify_all();
         }
     }
 }
@@ -2,16 +2,29 @@
 
 #pragma once
 
-#include <deque>
+#include <condition_variable>
+#include <list>
 #include <mutex>
-#include <semaphore>
 #include <thread>
+#include <vector>
 
 #include "Job.h"
 
 namespace GRAPE {
+    /**
+    * @brief Runs queued jobs on a fixed number of runner threads.
+    *
+    * Each job may depend on other jobs (e.g. a noise run on its performance run). A job is started once none of its dependencies is queued or running.
+    * If a dependency did not finish, the dependent job is reset instead of run.
+    * Independent jobs run concurrently, their tasks share the cores of the process wide ThreadPool.
+    */
     class JobManager {
     public:
+        /**
+        * @brief Maximum number of jobs running at the same time. Read when the JobManager is constructed.
+        */
+        inline static std::size_t s_ConcurrentJobs = 4;
+
         JobManager();
         JobManager(const JobManager&) = delete;
         JobManager(JobManager&&) = delete;
@@ -20,30 +33,38 @@ namespace GRAPE {
         ~JobManager();
 
         // Main Thread
-        void queueJob(const std::shared_ptr<Job>& Jb);
+        void queueJob(const std::shared_ptr<Job>& Jb, const std::vector<std::shared_ptr<Job>>& Dependencies = {});
         void waitForJobs();
-        [[nodiscard]] bool isAnyRunning() const { return m_Running.load() != nullptr; }
-        [[nodiscard]] bool isRunning(const std::shared_ptr<Job>& Jb) const { return m_Running.load() == Jb; }
+        [[nodiscard]] bool isAnyRunning() const;
+        [[nodiscard]] bool isRunning(const std::shared_ptr<Job>& Jb) const;
 
+        void stopJob(const std::shared_ptr<Job>& Jb);
         void resetJob(const std::shared_ptr<Job>& Jb);
         void shutdown();
     private:
-        std::deque<std::shared_ptr<Job>> m_Jobs{};
-        std::atomic<std::shared_ptr<Job>> m_Running = nullptr;
+        struct QueuedJob {
+            std::shared_ptr<Job> Jb;
+            std::vector<std::shared_ptr<Job>> Dependencies;
+        };
+
+        std::list<QueuedJob> m_Jobs{};
+        std::vector<std::shared_ptr<Job>> m_Running{};
 
         mutable std::mutex m_Mutex;
         std::condition_variable m_JobAvailableCv;
         std::condition_variable m_JobDoneCv;
-        std::atomic_bool m_Stop = false;
+        bool m_Stop = false;
 
-        std::binary_semaphore m_RunSemaphore;
-        std::binary_semaphore m_WaitSemaphore;
+        std::size_t m_QueuedAndRunning = 0;
 
-        std::atomic_size_t m_TotalCount = 0;
-        std::atomic_size_t m_QueuedAndRunning = 0;
-
-        std::thread m_Thread;
+        std::vector<std::thread> m_Threads;
     private:
+        /**
+        * @brief Must be called with the mutex locked.
+        * @return True if none of the dependencies of Queued is queued or running.
+        */
+        [[nodiscard]] bool startable(const QueuedJob& Queued) const;
+
         void threadLoop();
     };
 }
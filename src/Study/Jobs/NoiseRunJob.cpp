@@ -6,18 +6,50 @@
 
 #include "Constraints.h"
 #include "Aircraft/Aircraft.h"
+#include "Managers/Doc29NoiseManager.h"
 #include "Noise/NoiseCalculatorDoc29.h"
 #include "Noise/ReceptorOutput.h"
+#include "Operation/FlightTemplate.h"
 #include "Scenario/Scenario.h"
 
 namespace GRAPE {
-    NoiseRunJob::NoiseRunJob(Constraints& Blocks, NoiseRun& NsRun, std::size_t ThreadCount) : m_Blocks(Blocks), m_NoiseRun(NsRun), m_ThreadCount(ThreadCount) { m_Status.store(Status::Ready); }
+    NoiseRunJob::NoiseRunJob(Constraints& Blocks, Doc29NoiseManager& Doc29Noises, NoiseRun& NsRun) : m_Blocks(Blocks), m_Doc29Noises(Doc29Noises), m_NoiseRun(NsRun) { m_Status.store(Status::Ready); }
 
     bool NoiseRunJob::queue() {
-        if (!m_NoiseRun.valid())
-            return false;
+        // Blocks kept from the previous run
+        if (m_Status.load() == Status::Outdated)
+        {
+            m_Update = true;
+        }
+        else
+        {
+            if (!m_NoiseRun.valid())
+                return false;
 
-        m_Blocks.noiseRunBlock(m_NoiseRun);
+            m_Blocks.noiseRunBlock(m_NoiseRun);
+        }
+
+        // NPD data of the Doc29 noise entries used is loaded in the background while the job waits, run() waits for it and checks it before calculating
+        if (m_NoiseRun.NsRunSpec.NoiseMdl == NoiseModel::Doc29)
+        {
+            const Scenario& scen = m_NoiseRun.parentScenario();
+            std::unordered_set<const Doc29Noise*> doc29Noises;
+            const auto addDoc29Ns = [&](const Operation& Op) {
+                if (Op.aircraft().Doc29Ns)
+                    doc29Noises.emplace(Op.aircraft().Doc29Ns);
+                };
+            for (const FlightArrival& op : scen.FlightArrivals)
+                addDoc29Ns(op);
+            for (const FlightDeparture& op : scen.FlightDepartures)
+                addDoc29Ns(op);
+            for (const Track4dArrival& op : scen.Track4dArrivals)
+                addDoc29Ns(op);
+            for (const Track4dDeparture& op : scen.Track4dDepartures)
+                addDoc29Ns(op);
+
+            for (const auto doc29Ns : doc29Noises)
+                m_Tasks.run([&, doc29Ns] { m_Doc29Noises.loadNpd(*doc29Ns); });
+        }
 
         m_Status.store(Status::Waiting);
         return true;
@@ -29,26 +61,100 @@ namespace GRAPE {
         Log::study()->info("Started noise run '{}' of performance run '{}' of scenario '{}'.", m_NoiseRun.Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.parentScenario().Name);
         m_Status.store(Status::Running);
 
+        m_Tasks.wait(); // NPD data loaded by queue()
+        if (!running())
+            return;
+
+        if (!m_NoiseRun.validNpd())
+        {
+            m_Status.store(Status::Stopped);
+            m_Update = false;
+            Log::study()->error("Noise run '{}' of performance run '{}' of scenario '{}' stopped. Invalid NPD data.", m_NoiseRun.Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.parentScenario().Name);
+            return;
+        }
+
         // Initialize Run Parameters
-        m_NoiseRun.m_NoiseRunOutput->setReceptorOutput(m_NoiseRun.NsRunSpec.ReceptSet->receptorList(*m_NoiseRun.parentPerformanceRun().PerfRunSpec.CoordSys));
+        if (!m_Update)
+            m_NoiseRun.m_NoiseRunOutput->setReceptorOutput(m_NoiseRun.NsRunSpec.ReceptSet->receptorList(*m_NoiseRun.parentPerformanceRun().PerfRunSpec.CoordSys));
         const ReceptorOutput& receptOutput = m_NoiseRun.m_NoiseRunOutput->receptors();
-        m_NoiseRun.m_NoiseRunOutput->startCumulative();
 
-        const auto& perfRunOutput = m_NoiseRun.parentPerformanceRun().output();
-        m_TotalCount = perfRunOutput.size();
+        auto& perfRunOutput = m_NoiseRun.parentPerformanceRun().output();
+        const auto calculate = [&](const Operation& Op) { return !m_NoiseRun.skipOperation(Op) && !(m_Update && m_NoiseRun.m_NoiseRunOutput->contains(Op)); };
+
+        // Operations in scenario order, independent of the order in which the performance run saved their outputs
+        std::vector<std::reference_wrapper<const OperationArrival>> scenOpArrs;
+        std::vector<std::reference_wrapper<const OperationDeparture>> scenOpDeps;
+        {
+            const Scenario& scen = m_NoiseRun.parentScenario();
+            for (const FlightArrival& op : scen.FlightArrivals)
+                if (calculate(op))
+                    scenOpArrs.emplace_back(op);
+            for (const Track4dArrival& op : scen.Track4dArrivals)
+                if (calculate(op))
+                    scenOpArrs.emplace_back(op);
+            for (const FlightDeparture& op : scen.FlightDepartures)
+                if (calculate(op))
+                    scenOpDeps.emplace_back(op);
+            for (const Track4dDeparture& op : scen.Track4dDepartures)
+                if (calculate(op))
+                    scenOpDeps.emplace_back(op);
+        }
+
+        // Performance run still running, outputs are consumed as they are saved
+        const auto stream = perfRunOutput.subscribe();
+
+        std::vector<std::reference_wrapper<const OperationArrival>> opArrs;
+        std::vector<std::reference_wrapper<const OperationDeparture>> opDeps;
+        if (stream)
+        {
+            opArrs = scenOpArrs;
+            opDeps = scenOpDeps;
+        }
+        else if (!perfRunOutput.pointsSaved())
+        {
+            // Subscription refused, outputs published before this run started are no longer in memory
+            m_Status.store(Status::Stopped);
+            Log::study()->error("Noise run '{}' of performance run '{}' of scenario '{}' stopped. Performance output points were not saved and some outputs were evicted from memory before the noise run started.", m_NoiseRun.Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.parentScenario().Name);
+        }
+        else
+        {
+            std::ranges::copy_if(perfRunOutput.arrivalOutputs(), std::back_inserter(opArrs), calculate);
+            std::ranges::copy_if(perfRunOutput.departureOutputs(), std::back_inserter(opDeps), calculate);
+        }
+        m_TotalCount = opArrs.size() + opDeps.size();
+
+        // Independent of the thread count and of the calculation order, the cumulative outputs are summed in scenario order on every machine
+        // Operations without performance output are only known once a stream is complete, the operations after them are then held until finishCumulative()
+        {
+            std::unordered_set<const Operation*> calculated;
+            calculated.reserve(m_TotalCount);
+            for (const OperationArrival& op : opArrs)
+                calculated.emplace(&op);
+            for (const OperationDeparture& op : opDeps)
+                calculated.emplace(&op);
+
+            std::vector<const Operation*> cumulativeOrder;
+            cumulativeOrder.reserve(m_TotalCount);
+            for (const OperationArrival& op : scenOpArrs)
+                if (calculated.contains(&op))
+                    cumulativeOrder.emplace_back(&op);
+            for (const OperationDeparture& op : scenOpDeps)
+                if (calculated.contains(&op))
+                    cumulativeOrder.emplace_back(&op);
+            m_NoiseRun.m_NoiseRunOutput->startCumulative(cumulativeOrder, s_CumulativeShards);
+        }
 
         switch (m_NoiseRun.NsRunSpec.NoiseMdl)
         {
         case NoiseModel::Doc29:
             {
-                m_ThreadCount = 1;  // Doc29 runs in parallel inside the calculator
-
                 std::unique_ptr<NoiseCalculatorDoc29> doc29NsCalculator = std::make_unique<NoiseCalculatorDoc29>(m_NoiseRun.parentPerformanceRun().PerfRunSpec, m_NoiseRun.NsRunSpec, receptOutput);
 
-                for (auto opArr : perfRunOutput.arrivalOutputs())
-                    doc29NsCalculator->addDoc29NoiseArrival(opArr.get().aircraft().Doc29Ns);
-                for (auto opDep : perfRunOutput.departureOutputs())
-                    doc29NsCalculator->addDoc29NoiseDeparture(opDep.get().aircraft().Doc29Ns);
+                // Generators are created upfront, operations are then calculated concurrently
+                for (auto opArr : opArrs)
+                    doc29NsCalculator->addDoc29NoiseArrival(opArr);
+                for (auto opDep : opDeps)
+                    doc29NsCalculator->addDoc29NoiseDeparture(opDep);
 
                 m_NoiseCalculator = std::move(doc29NsCalculator);
                 break;
@@ -57,49 +163,37 @@ namespace GRAPE {
             break;
         }
 
-        // Initialize Job Threads
-        for (std::size_t i = 0; i < m_ThreadCount; i++)
-            m_JobThreads.emplace_back(std::make_unique<JobThread>(m_Tasks));
-
-        // Queue Operations
-        for (const auto opArr : perfRunOutput.arrivalOutputs())
+        bool complete = true;
+        if (stream)
         {
-            if (m_NoiseRun.skipOperation(opArr))
-                continue;
-            m_Tasks.pushTask([&, opArr] {
-                const auto noiseRes = m_NoiseCalculator->calculateArrivalNoise(opArr, perfRunOutput.arrivalOutput(opArr));
-                if (m_NoiseRun.NsRunSpec.SaveSingleMetrics)
-                    m_NoiseRun.m_NoiseRunOutput->addSingleEvent(opArr, noiseRes);
-                m_NoiseRun.m_NoiseRunOutput->accumulate(opArr, noiseRes);
-                ++m_CalculatedCount;
-                });
+            complete = calculateStream(*stream, opArrs, opDeps);
         }
-
-        for (const auto opDep : perfRunOutput.departureOutputs())
+        else
         {
-            if (m_NoiseRun.skipOperation(opDep))
-                continue;
+            // Flights with the same template have the same single event output, which is calculated once and accumulated for each flight
+            const auto& atmospheres = m_NoiseRun.parentPerformanceRun().PerfRunSpec.Atmospheres;
+            for (auto& opArrGroup : groupByFlightTemplate(opArrs, atmospheres))
+                m_Tasks.run([&, opArrGroup = std::move(opArrGroup)] { calculateArrivals(opArrGroup, *perfRunOutput.arrivalOutput(opArrGroup.front())); });
 
-            m_Tasks.pushTask([&, opDep] {
-                const auto noiseRes = m_NoiseCalculator->calculateDepartureNoise(opDep, perfRunOutput.departureOutput(opDep));
-                if (m_NoiseRun.NsRunSpec.SaveSingleMetrics)
-                    m_NoiseRun.m_NoiseRunOutput->addSingleEvent(opDep, noiseRes);
-                m_NoiseRun.m_NoiseRunOutput->accumulate(opDep, noiseRes);
-                ++m_CalculatedCount;
-                });
+            for (auto& opDepGroup : groupByFlightTemplate(opDeps, atmospheres))
+                m_Tasks.run([&, opDepGroup = std::move(opDepGroup)] { calculateDepartures(opDepGroup, *perfRunOutput.departureOutput(opDepGroup.front())); });
+
+            // Synchronization
+            m_Tasks.wait();
         }
 
-        // Run
-        if (running())
-            for (const auto& jobThread : m_JobThreads)
-                jobThread->run();
+        // Performance run stopped before adding all outputs
+        if (!complete && m_Status.load() == Status::Running)
+        {
+            m_Status.store(Status::Stopped);
+            Log::study()->error("Noise run '{}' of performance run '{}' of scenario '{}' stopped. The performance run was stopped before finishing.", m_NoiseRun.Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.parentScenario().Name);
+        }
 
-        // Synchronization
-        for (const auto& jobThread : m_JobThreads)
-            jobThread->join();
-        m_JobThreads.clear();
+        // Also saved if the run was stopped, the cumulative outputs are not
+        m_NoiseRun.m_NoiseRunOutput->saveSingleEvents();
 
         m_NoiseCalculator.reset();
+        m_Update = false;
 
         if (m_Status.load() == Status::Running)
         {
@@ -110,9 +204,107 @@ namespace GRAPE {
         }
     }
 
+    /**
+    * Items are grouped while they are popped, flights sharing the same performance output are published consecutively by the performance run.
+    * Each batch of items is calculated before popping the next one, the stream holds the outputs not yet consumed.
+    */
+    bool NoiseRunJob::calculateStream(PerformanceRunOutput::Stream& Strm, const std::vector<std::reference_wrapper<const OperationArrival>>& OpArrs, const std::vector<std::reference_wrapper<const OperationDeparture>>& OpDeps) {
+        const auto& perfRunOutput = m_NoiseRun.parentPerformanceRun().output();
+
+        std::unordered_map<const Operation*, const OperationArrival*> pendingArrs;
+        for (const OperationArrival& op : OpArrs)
+            pendingArrs.emplace(&op, &op);
+        std::unordered_map<const Operation*, const OperationDeparture*> pendingDeps;
+        for (const OperationDeparture& op : OpDeps)
+            pendingDeps.emplace(&op, &op);
+
+        const auto addToGroup = []<typename OpT>(std::vector<StreamGroup<OpT>>& Groups, const OpT& Op, std::shared_ptr<const PerformanceOutput> PerfOutput) {
+            if (PerfOutput && !Groups.empty() && Groups.back().PerfOutput == PerfOutput)
+                Groups.back().Ops.emplace_back(Op);
+            else
+                Groups.emplace_back(std::move(PerfOutput), std::vector<std::reference_wrapper<const OpT>>{ std::cref(Op) });
+        };
+
+        while (running())
+        {
+            auto items = Strm.pop();
+            if (items.empty())
+                break;
+
+            std::vector<StreamGroup<OperationArrival>> arrGroups;
+            std::vector<StreamGroup<OperationDeparture>> depGroups;
+            for (auto& [op, perfOutput] : items)
+            {
+                if (const auto it = pendingArrs.find(op); it != pendingArrs.end())
+                {
+                    addToGroup(arrGroups, *it->second, std::move(perfOutput));
+                    pendingArrs.erase(it);
+                }
+                else if (const auto itDep = pendingDeps.find(op); itDep != pendingDeps.end())
+                {
+                    addToGroup(depGroups, *itDep->second, std::move(perfOutput));
+                    pendingDeps.erase(itDep);
+                }
+            }
+
+            // Outputs saved before subscribing are published without value
+            for (auto& group : arrGroups)
+            {
+                m_Tasks.run([&, group = std::move(group)] {
+                    const auto perfOutput = group.PerfOutput ? group.PerfOutput : perfRunOutput.arrivalOutput(group.Ops.front());
+                    calculateArrivals(group.Ops, *perfOutput);
+                    });
+            }
+
+            for (auto& group : depGroups)
+            {
+                m_Tasks.run([&, group = std::move(group)] {
+                    const auto perfOutput = group.PerfOutput ? group.PerfOutput : perfRunOutput.departureOutput(group.Ops.front());
+                    calculateDepartures(group.Ops, *perfOutput);
+                    });
+            }
+
+            // Synchronization
+            m_Tasks.wait();
+        }
+
+        // Stopped while the performance run is running
+        if (!running())
+        {
+            Strm.cancel();
+            return true;
+        }
+
+        return Strm.complete();
+    }
+
+    void NoiseRunJob::calculateArrivals(const std::vector<std::reference_wrapper<const OperationArrival>>& OpArrs, const PerformanceOutput& PerfOutput) {
+        const auto noiseRes = std::make_shared<const NoiseSingleEventOutput>(m_NoiseCalculator->calculateArrivalNoise(OpArrs.front(), PerfOutput));
+        const NoiseSingleEventEnergy nsEnergy(*noiseRes);
+        for (const auto op : OpArrs)
+        {
+            if (m_NoiseRun.NsRunSpec.SaveSingleMetrics)
+                m_NoiseRun.m_NoiseRunOutput->addSingleEvent(op, *noiseRes);
+            m_NoiseRun.m_NoiseRunOutput->accumulate(op, noiseRes, nsEnergy);
+        }
+        m_CalculatedCount += OpArrs.size();
+    }
+
+    void NoiseRunJob::calculateDepartures(const std::vector<std::reference_wrapper<const OperationDeparture>>& OpDeps, const PerformanceOutput& PerfOutput) {
+        const auto noiseRes = std::make_shared<const NoiseSingleEventOutput>(m_NoiseCalculator->calculateDepartureNoise(OpDeps.front(), PerfOutput));
+        const NoiseSingleEventEnergy nsEnergy(*noiseRes);
+        for (const auto op : OpDeps)
+        {
+            if (m_NoiseRun.NsRunSpec.SaveSingleMetrics)
+                m_NoiseRun.m_NoiseRunOutput->addSingleEvent(op, *noiseRes);
+            m_NoiseRun.m_NoiseRunOutput->accumulate(op, noiseRes, nsEnergy);
+        }
+        m_CalculatedCount += OpDeps.size();
+    }
+
     void NoiseRunJob::stop() {
         m_Status.store(Status::Stopped);
-        m_Tasks.clear();
+        m_Tasks.cancel();
     }
 
     void NoiseRunJob::reset() {
@@ -123,6 +315,9 @@ namespace GRAPE {
         m_NoiseRun.m_NoiseRunOutput->clear();
 
         m_NoiseCalculator.reset();
+        m_Update = false;
+        m_Tasks.wait(); // NPD data loaded by queue() if stopped before running
+        m_Tasks.reset();
 
         m_TotalCount = 0;
         m_CalculatedCount = 0;
@@ -6,15 +6,17 @@
 
 #include "Noise/AtmosphericAbsorption.h"
 #include "Noise/NoiseCalculator.h"
+#include "Scenario/PerformanceRunOutput.h"
 
 namespace GRAPE {
     class Constraints;
+    class Doc29NoiseManager;
     class NoiseRun;
 
     class NoiseRunJob : public Job {
     public:
         // Constructors & Destructor
-        NoiseRunJob(Constraints& Blocks, NoiseRun& NsRun, std::size_t ThreadCount);
+        NoiseRunJob(Constraints& Blocks, Doc29NoiseManager& Doc29Noises, NoiseRun& NsRun);
         NoiseRunJob(const NoiseRunJob&) = delete;
         NoiseRunJob(NoiseRunJob&&) = delete;
         NoiseRunJob& operator=(const NoiseRunJob&) = delete;
@@ -28,19 +30,44 @@ namespace GRAPE {
 
         // Main thread
         float progress() const override { return static_cast<float>(m_CalculatedCount) / static_cast<float>(m_TotalCount); }
+        bool streams() const override { return true; }
     private:
         Constraints& m_Blocks;
+        Doc29NoiseManager& m_Doc29Noises;
 
         NoiseRun& m_NoiseRun;
 
         std::unique_ptr<NoiseCalculator> m_NoiseCalculator = nullptr;
 
+        // Only operations without contribution to the cumulative outputs are calculated
+        bool m_Update = false;
+
         std::size_t m_TotalCount = 0;
         std::atomic_size_t m_CalculatedCount = 0;
 
-        std::size_t m_ThreadCount;
-        std::vector<std::unique_ptr<JobThread>> m_JobThreads{};
+        // Shards of the cumulative outputs, enough to make two threads accumulating into the same shard unlikely
+        // Fixed, the operations summed by each shard do not depend on the thread count
+        static constexpr std::size_t s_CumulativeShards = 64;
+
+        TaskGroup m_Tasks;
+    private:
+        // Operations sharing the same performance output, nullptr if it must be fetched from the performance run output
+        template <typename OperationT>
+        struct StreamGroup {
+            std::shared_ptr<const PerformanceOutput> PerfOutput;
+            std::vector<std::reference_wrapper<const OperationT>> Ops;
+        };
+
+        /**
+        * @brief Calculates the operations as their performance outputs are published to Strm. Returns once the stream is closed or the job is stopped.
+        * @return False if the performance run was stopped before publishing all outputs.
+        */
+        bool calculateStream(PerformanceRunOutput::Stream& Strm, const std::vector<std::reference_wrapper<const OperationArrival>>& OpArrs, const std::vector<std::reference_wrapper<const OperationDeparture>>& OpDeps);
 
-        MtQueue m_Tasks;
+        /**
+        * @brief Calculates the single event of the first operation and accumulates it for all operations, which must share the same performance output.
+        */
+        void calculateArrivals(const std::vector<std::reference_wrapper<const OperationArrival>>& OpArrs, const PerformanceOutput& PerfOutput);
+        void calculateDepartures(const std::vector<std::reference_wrapper<const OperationDeparture>>& OpDeps, const PerformanceOutput& PerfOutput);
     };
 }
@@ -6,39 +6,72 @@
 
 #include "Airport/RouteCalculator.h"
 #include "Performance/PerformanceCalculatorDoc29.h"
+#include "Managers/Doc29PerformanceManager.h"
 #include "Managers/OperationsManager.h"
+#include "Operation/FlightTemplate.h"
 #include "Scenario/Scenario.h"
 
 namespace GRAPE {
     // Constructors & Destructor (Copy and Move implicitly deleted)
-    RouteOutputGenerator::RouteOutputGenerator(const CoordinateSystem& Cs) : m_Cs(Cs) { m_RouteOutputs.add(nullptr, RouteOutput()); }
-
-    const RouteOutput& RouteOutputGenerator::getRouteOutput(const Route* Rte) {
-        // Access the container and check if route output was already calculated
-        std::unique_lock lck(m_Mutex);
-        if (Rte == nullptr || m_RouteOutputs.contains(Rte))
-            return m_RouteOutputs(Rte);
-        lck.unlock();
-
-        // Calculate route output
-        RouteCalculator rteCalc(m_Cs);
-        RouteOutput rteOut = rteCalc.calculate(*Rte);
-
-        // Access the container and add the route output if no concurring thread already did
-        lck.lock();
-        auto [RteOutput, added] = m_RouteOutputs.add(Rte, std::move(rteOut));
-        return RteOutput;
+    RouteOutputGenerator::RouteOutputGenerator(const CoordinateSystem& Cs) : m_Cs(Cs) { m_RouteOutputs.try_emplace(nullptr); }
+
+    void RouteOutputGenerator::addRoute(const Route* Rte) { m_RouteOutputs.try_emplace(Rte); }
+
+    void RouteOutputGenerator::queueCalculations(TaskGroup& Tasks) {
+        // The table is not resized while the tasks run, each task writes to its own element
+        for (auto& [rte, rteOutput] : m_RouteOutputs)
+        {
+            if (!rte)
+                continue;
+
+            Tasks.run([&, rte] {
+                RouteCalculator rteCalc(m_Cs);
+                rteOutput = rteCalc.calculate(*rte);
+                });
+        }
+    }
+
+    const RouteOutput& RouteOutputGenerator::getRouteOutput(const Route* Rte) const {
+        GRAPE_ASSERT(m_RouteOutputs.contains(Rte));
+        return m_RouteOutputs.at(Rte);
     }
 
-    PerformanceRunJob::PerformanceRunJob(OperationsManager& Operations, PerformanceRun& PerfRun, std::size_t ThreadCount) : m_Operations(Operations), m_PerfRun(PerfRun), m_ThreadCount(ThreadCount) {
+    PerformanceRunJob::PerformanceRunJob(OperationsManager& Operations, Doc29PerformanceManager& Doc29Aircrafts, PerformanceRun& PerfRun) : m_Operations(Operations), m_Doc29Aircrafts(Doc29Aircrafts), m_PerfRun(PerfRun) {
         m_Status.store(Status::Ready);
     }
 
     bool PerformanceRunJob::queue() {
-        if (!m_PerfRun.valid())
-            return false;
+        // Blocks kept from the previous run
+        if (m_Status.load() == Status::Outdated)
+        {
+            m_Update = true;
+        }
+        else
+        {
+            if (!m_PerfRun.valid())
+                return false;
 
-        m_Operations.constraints().performanceRunBlock(m_PerfRun);
+            m_Operations.constraints().performanceRunBlock(m_PerfRun);
+        }
+
+        // Profiles of the Doc29 aircraft used by the flights are loaded in the background while the job waits, run() waits for them before calculating the flights
+        if (m_PerfRun.PerfRunSpec.FlightsPerformanceMdl == PerformanceModel::Doc29)
+        {
+            const auto& scen = m_PerfRun.parentScenario();
+            std::unordered_set<const Doc29Aircraft*> doc29Acfts;
+            for (const FlightArrival& op : scen.FlightArrivals)
+                if (op.hasDoc29Profile())
+                    doc29Acfts.emplace(&op.Doc29Prof->parentDoc29Performance());
+            for (const FlightDeparture& op : scen.FlightDepartures)
+                if (op.hasDoc29Profile())
+                    doc29Acfts.emplace(&op.Doc29Prof->parentDoc29Performance());
+
+            for (const auto doc29Acft : doc29Acfts)
+                m_Tasks.run([&, doc29Acft] { m_Doc29Aircrafts.loadProfiles(*doc29Acft); });
+        }
+
+        // Started when queued, streaming noise and emissions runs can subscribe as soon as this job starts running
+        m_PerfRun.m_PerfRunOutput->startWriter(); // Calculation threads never write to the database
 
         m_Status.store(Status::Waiting);
         return true;
@@ -50,14 +83,29 @@ namespace GRAPE {
         Log::study()->info("Started performance run '{}' of scenario '{}'.", m_PerfRun.Name, m_PerfRun.parentScenario().Name);
         m_Status.store(Status::Running);
 
-        // Initialize Job Threads
-        for (std::size_t i = 0; i < m_ThreadCount; i++)
-            m_JobThreads.emplace_back(std::make_unique<JobThread>(m_Tasks));
-
         // Initialize Run Parameters
-        m_TotalCount = m_PerfRun.parentScenario().size();
+        const auto& scen = m_PerfRun.parentScenario();
+        const auto& perfRunOutput = m_PerfRun.m_PerfRunOutput;
 
-        m_RouteOutputs = std::make_unique<RouteOutputGenerator>(*m_PerfRun.PerfRunSpec.CoordSys);
+        std::unordered_set<const Operation*> calculated;
+        if (m_Update)
+        {
+            for (const OperationArrival& op : perfRunOutput->arrivalOutputs())
+                calculated.emplace(&op);
+            for (const OperationDeparture& op : perfRunOutput->departureOutputs())
+                calculated.emplace(&op);
+        }
+        const auto calculate = [&](const Operation& Op) { return !calculated.contains(&Op); };
+
+        std::vector<std::reference_wrapper<const FlightArrival>> flightArrs;
+        std::ranges::copy_if(scen.FlightArrivals, std::back_inserter(flightArrs), calculate);
+        std::vector<std::reference_wrapper<const FlightDeparture>> flightDeps;
+        std::ranges::copy_if(scen.FlightDepartures, std::back_inserter(flightDeps), calculate);
+        std::vector<std::reference_wrapper<const Track4dArrival>> track4dArrs;
+        std::ranges::copy_if(scen.Track4dArrivals, std::back_inserter(track4dArrs), calculate);
+        std::vector<std::reference_wrapper<const Track4dDeparture>> track4dDeps;
+        std::ranges::copy_if(scen.Track4dDepartures, std::back_inserter(track4dDeps), calculate);
+        m_TotalCount = flightArrs.size() + flightDeps.size() + track4dArrs.size() + track4dDeps.size();
 
         switch (m_PerfRun.PerfRunSpec.FlightsPerformanceMdl)
         {
@@ -69,69 +117,84 @@ namespace GRAPE {
         m_Tracks4dCalculator = m_PerfRun.PerfRunSpec.Tracks4dCalculatePerformance ? std::make_unique<PerformanceCalculatorTrack4d>(m_PerfRun.PerfRunSpec) : std::make_unique<PerformanceCalculatorTrack4dEmpty>(m_PerfRun.PerfRunSpec);
 
         // Prepare LTO fuel flow calculations
-        for (auto op : m_PerfRun.parentScenario().FlightArrivals)
+        for (auto op : flightArrs)
             m_FlightsCalculator->fuelFlowCalculator().addLTOEngine(op.get().aircraft().LTOEng);
 
-        for (auto op : m_PerfRun.parentScenario().FlightDepartures)
+        for (auto op : flightDeps)
             m_FlightsCalculator->fuelFlowCalculator().addLTOEngine(op.get().aircraft().LTOEng);
 
-        for (auto op : m_PerfRun.parentScenario().Track4dArrivals)
+        for (auto op : track4dArrs)
             m_FlightsCalculator->fuelFlowCalculator().addLTOEngine(op.get().aircraft().LTOEng);
 
-        for (auto op : m_PerfRun.parentScenario().Track4dDepartures)
+        for (auto op : track4dDeps)
             m_FlightsCalculator->fuelFlowCalculator().addLTOEngine(op.get().aircraft().LTOEng);
 
+        // Calculate route outputs upfront, flights then read them without synchronization
+        m_RouteOutputs = std::make_unique<RouteOutputGenerator>(*m_PerfRun.PerfRunSpec.CoordSys);
+        for (const FlightArrival& op : flightArrs)
+            m_RouteOutputs->addRoute(op.Rte);
+        for (const FlightDeparture& op : flightDeps)
+            m_RouteOutputs->addRoute(op.Rte);
+        m_RouteOutputs->queueCalculations(m_Tasks);
+        m_Tasks.wait(); // Also waits for the profiles loaded by queue()
+
         // Queue Operations
-        const auto& perfRunOutput = m_PerfRun.m_PerfRunOutput;
-        for (const auto flightArr : m_PerfRun.parentScenario().FlightArrivals)
+        // Flights with the same template have the same performance output, which is calculated once and shared
+        const auto& atmospheres = m_PerfRun.PerfRunSpec.Atmospheres;
+        for (auto& flightArrs : groupByFlightTemplate(flightArrs, atmospheres))
         {
-            m_Tasks.pushTask([&, flightArr] {
-                if (const auto perfOutputOpt = m_FlightsCalculator->calculate(flightArr, m_RouteOutputs->getRouteOutput(flightArr.get().Rte)))
-                    perfRunOutput->addArrivalOutput(flightArr, perfOutputOpt.value());
-                ++m_CalculatedCount;
+            m_Tasks.run([&, flightArrs = std::move(flightArrs)] {
+                const FlightArrival& flightArr = flightArrs.front();
+                if (auto perfOutputOpt = m_FlightsCalculator->calculate(flightArr, m_RouteOutputs->getRouteOutput(flightArr.Rte)))
+                {
+                    const auto perfOutput = std::make_shared<const PerformanceOutput>(std::move(perfOutputOpt.value()));
+                    for (const auto op : flightArrs)
+                        perfRunOutput->addArrivalOutput(op, perfOutput);
+                }
+                m_CalculatedCount += flightArrs.size();
                 });
         }
 
-        for (const auto flightDep : m_PerfRun.parentScenario().FlightDepartures)
+        for (auto& flightDeps : groupByFlightTemplate(flightDeps, atmospheres))
         {
-            m_Tasks.pushTask([&, flightDep] {
-                if (const auto perfOutputOpt = m_FlightsCalculator->calculate(flightDep, m_RouteOutputs->getRouteOutput(flightDep.get().Rte)))
-                    perfRunOutput->addDepartureOutput(flightDep, perfOutputOpt.value());
-                ++m_CalculatedCount;
+            m_Tasks.run([&, flightDeps = std::move(flightDeps)] {
+                const FlightDeparture& flightDep = flightDeps.front();
+                if (auto perfOutputOpt = m_FlightsCalculator->calculate(flightDep, m_RouteOutputs->getRouteOutput(flightDep.Rte)))
+                {
+                    const auto perfOutput = std::make_shared<const PerformanceOutput>(std::move(perfOutputOpt.value()));
+                    for (const auto op : flightDeps)
+                        perfRunOutput->addDepartureOutput(op, perfOutput);
+                }
+                m_CalculatedCount += flightDeps.size();
                 });
         }
 
-        for (const auto track4dArr : m_PerfRun.parentScenario().Track4dArrivals)
+        for (const auto track4dArr : track4dArrs)
         {
-            m_Tasks.pushTask([&, track4dArr] {
+            m_Tasks.run([&, track4dArr] {
                 m_Operations.loadArr(track4dArr);
-                if (const auto perfOutputOpt = m_Tracks4dCalculator->calculate(track4dArr))
-                    perfRunOutput->addArrivalOutput(track4dArr, perfOutputOpt.value());
+                if (auto perfOutputOpt = m_Tracks4dCalculator->calculate(track4dArr))
+                    perfRunOutput->addArrivalOutput(track4dArr, std::move(perfOutputOpt.value()));
                 m_Operations.unloadArr(track4dArr, true);
                 ++m_CalculatedCount;
                 });
         }
 
-        for (const auto track4dDep : m_PerfRun.parentScenario().Track4dDepartures)
+        for (const auto track4dDep : track4dDeps)
         {
-            m_Tasks.pushTask([&, track4dDep] {
+            m_Tasks.run([&, track4dDep] {
                 m_Operations.loadDep(track4dDep);
-                if (const auto perfOutputOpt = m_Tracks4dCalculator->calculate(track4dDep))
-                    perfRunOutput->addDepartureOutput(track4dDep, perfOutputOpt.value());
+                if (auto perfOutputOpt = m_Tracks4dCalculator->calculate(track4dDep))
+                    perfRunOutput->addDepartureOutput(track4dDep, std::move(perfOutputOpt.value()));
                 m_Operations.unloadDep(track4dDep, true);
                 ++m_CalculatedCount;
                 });
         }
 
-        // Run
-        if (running())
-            for (const auto& jobThread : m_JobThreads)
-                jobThread->run();
-
         // Synchronization
-        for (const auto& jobThread : m_JobThreads)
-            jobThread->join();
-        m_JobThreads.clear();
+        m_Tasks.wait();
+        perfRunOutput->stopWriter(running());
+        m_Update = false;
 
         if (m_Status.load() == Status::Running)
         {
@@ -142,7 +205,7 @@ namespace GRAPE {
 
     void PerformanceRunJob::stop() {
         m_Status.store(Status::Stopped);
-        m_Tasks.clear();
+        m_Tasks.cancel();
     }
 
     void PerformanceRunJob::reset() {
@@ -150,11 +213,15 @@ namespace GRAPE {
         if (m_Status.load() != Status::Ready)
             m_Operations.constraints().performanceRunUnblock(m_PerfRun);
 
+        m_PerfRun.m_PerfRunOutput->stopWriter(); // Reset while waiting
         m_PerfRun.m_PerfRunOutput->clear();
 
         m_FlightsCalculator.reset();
         m_Tracks4dCalculator.reset();
         m_RouteOutputs.reset();
+        m_Update = false;
+        m_Tasks.wait(); // Profiles loaded by queue() if stopped before running
+        m_Tasks.reset();
 
         m_TotalCount = 0;
         m_CalculatedCount = 0;
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "Job.h"
 
 #include "Airport/Airport.h"
@@ -9,27 +11,45 @@
 #include "Performance/PerformanceCalculatorTrack4d.h"
 
 namespace GRAPE {
+    class Doc29PerformanceManager;
     class OperationsManager;
     class PerformanceRun;
 
+    /**
+    * @brief Route outputs of all routes used by a performance run.
+    *
+    * Routes are added and calculated before the flights. The table is then read only and getRouteOutput() can be called concurrently without synchronization.
+    */
     class RouteOutputGenerator {
     public:
         // Constructors & Destructor (Copy and Move implicitly deleted)
         explicit RouteOutputGenerator(const CoordinateSystem& Cs);
         ~RouteOutputGenerator() = default;
 
-        const RouteOutput& getRouteOutput(const Route* Rte);
+        /**
+        * @brief Adds an empty entry for Rte if it doesn't exist. Not thread safe.
+        */
+        void addRoute(const Route* Rte);
+
+        /**
+        * @brief Runs one task per added route in Tasks, each task calculates and writes the output of a single route.
+        * No other method may be called until all tasks have finished.
+        */
+        void queueCalculations(TaskGroup& Tasks);
+
+        /**
+        * ASSERT Rte was added.
+        */
+        [[nodiscard]] const RouteOutput& getRouteOutput(const Route* Rte) const;
     private:
         const CoordinateSystem& m_Cs;
-        GrapeMap<const Route*, const RouteOutput> m_RouteOutputs;
-
-        mutable std::mutex m_Mutex;
+        std::unordered_map<const Route*, RouteOutput> m_RouteOutputs;
     };
 
     class PerformanceRunJob : public Job {
     public:
         // Constructors & Destructor
-        PerformanceRunJob(OperationsManager& Operations, PerformanceRun& PerfRun, std::size_t ThreadCount);
+        PerformanceRunJob(OperationsManager& Operations, Doc29PerformanceManager& Doc29Aircrafts, PerformanceRun& PerfRun);
         PerformanceRunJob(const PerformanceRunJob&) = delete;
         PerformanceRunJob(PerformanceRunJob&&) = delete;
         PerformanceRunJob& operator=(const PerformanceRunJob&) = delete;
@@ -45,6 +65,7 @@ namespace GRAPE {
         float progress() const override { return static_cast<float>(m_CalculatedCount) / static_cast<float>(m_TotalCount); }
     private:
         OperationsManager& m_Operations;
+        Doc29PerformanceManager& m_Doc29Aircrafts;
 
         PerformanceRun& m_PerfRun;
 
@@ -52,12 +73,12 @@ namespace GRAPE {
         std::unique_ptr<PerformanceCalculatorTrack4dEmpty> m_Tracks4dCalculator = nullptr;
         std::unique_ptr<RouteOutputGenerator> m_RouteOutputs = nullptr;
 
+        // Only operations without output are calculated
+        bool m_Update = false;
+
         std::size_t m_TotalCount = 0;
         std::atomic_size_t m_CalculatedCount = 0;
 
-        std::size_t m_ThreadCount;
-        std::vector<std::unique_ptr<JobThread>> m_JobThreads{};
-
-        MtQueue m_Tasks;
+        TaskGroup m_Tasks;
     };
 }
@@ -7,6 +7,23 @@
 #include "Schema/Schema.h"
 
 namespace GRAPE {
+    namespace {
+        void loadNpdData(const Database& Db, const std::string& Doc29NsName, NpdData& Npd, OperationType OpType, NoiseSingleMetric NsMetric) {
+            Statement stmt(Db, Schema::doc29_noise_npd_data.querySelect({ 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 }, { 0, 1, 2 }));
+            stmt.bindValues(Doc29NsName, OperationTypes.toString(OpType), NoiseSingleMetrics.toString(NsMetric));
+            stmt.step();
+            while (stmt.hasRow())
+            {
+                const auto npdThrust = stmt.getColumn(0);
+                NpdData::PowerNoiseLevelsArray nsLevels{};
+                for (std::size_t i = 0; i < nsLevels.size(); ++i)
+                    nsLevels.at(i) = stmt.getColumn(static_cast<int>(i + 1));
+                Npd.addThrust(npdThrust, nsLevels);
+                stmt.step();
+            }
+        }
+    }
+
     Doc29NoiseManager::Doc29NoiseManager(const Database& Db, Constraints& Blocks) : Manager(Db, Blocks) {}
 
     std::pair<Doc29Noise&, bool> Doc29NoiseManager::addNoise(const std::string& Name) {
@@ -19,6 +36,7 @@ namespace GRAPE {
             m_Db.insert(Schema::doc29_noise, {}, std::make_tuple(doc29Ns.Name, Doc29Noise::LateralDirectivities.toString(doc29Ns.LateralDir), Doc29Noise::SORCorrections.toString(doc29Ns.SOR)));
             m_Db.insert(Schema::doc29_noise_spectrum, { 0, 1 }, std::make_tuple(doc29Ns.Name, OperationTypes.toString(OperationType::Arrival)));
             m_Db.insert(Schema::doc29_noise_spectrum, { 0, 1 }, std::make_tuple(doc29Ns.Name, OperationTypes.toString(OperationType::Departure)));
+            m_NpdLoader.setLoaded(doc29Ns);
         }
         else { Log::dataLogic()->error("Adding Doc29 noise '{}'. Doc29 noise already exists in this study.", Name); }
 
@@ -36,6 +54,7 @@ namespace GRAPE {
             m_Db.insert(Schema::doc29_noise, {}, std::make_tuple(doc29Ns.Name, Doc29Noise::LateralDirectivities.toString(doc29Ns.LateralDir), Doc29Noise::SORCorrections.toString(doc29Ns.SOR)));
             m_Db.insert(Schema::doc29_noise_spectrum, { 0, 1 }, std::make_tuple(doc29Ns.Name, OperationTypes.toString(OperationType::Arrival)));
             m_Db.insert(Schema::doc29_noise_spectrum, { 0, 1 }, std::make_tuple(doc29Ns.Name, OperationTypes.toString(OperationType::Departure)));
+            m_NpdLoader.setLoaded(doc29Ns);
         }
         else
         {
@@ -55,6 +74,7 @@ namespace GRAPE {
             }
 
             m_Db.deleteD(Schema::doc29_noise, { 0 }, std::make_tuple(name));
+            m_NpdLoader.erase(ns);
             return true;
             });
     }
@@ -68,6 +88,7 @@ namespace GRAPE {
 
         m_Db.deleteD(Schema::doc29_noise, { 0 }, std::make_tuple(Doc29Ns.Name));
 
+        m_NpdLoader.erase(Doc29Ns);
         c_Doc29Noises.erase(Doc29Ns.Name);
     }
 
@@ -116,6 +137,7 @@ namespace GRAPE {
     }
 
     void Doc29NoiseManager::updateMetric(const Doc29Noise& Doc29Ns, OperationType OpType, NoiseSingleMetric NsMetric) const {
+        GRAPE_ASSERT(npdLoaded(Doc29Ns)); // Updating reinserts the NPD data
         switch (OpType)
         {
         case OperationType::Arrival:
@@ -210,27 +232,18 @@ namespace GRAPE {
                 stmt.step();
             }
 
-            // Doc29 Noise Metrics
-            auto npdLoader = [&](NpdData& NpdData, const OperationType OpType, const NoiseSingleMetric NsMetric) {
-                Statement stmtNpd(m_Db, Schema::doc29_noise_npd_data.querySelect({ 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 }, { 0, 1, 2 }));
-                stmtNpd.bindValues(doc29NsName, OperationTypes.toString(OpType), NoiseSingleMetrics.toString(NsMetric));
-                stmtNpd.step();
-                while (stmtNpd.hasRow())
-                {
-                    const auto npdThrust = stmtNpd.getColumn(0);
-                    NpdData::PowerNoiseLevelsArray nsLevels{};
-                    for (std::size_t i = 0; i < nsLevels.size(); ++i)
-                        nsLevels.at(i) = stmtNpd.getColumn(static_cast<int>(i + 1));
-                    NpdData.addThrust(npdThrust, nsLevels);
-                    stmtNpd.step();
-                }
-                };
-            npdLoader(doc29Ns.ArrivalLamax, OperationType::Arrival, NoiseSingleMetric::Lamax);
-            npdLoader(doc29Ns.ArrivalSel, OperationType::Arrival, NoiseSingleMetric::Sel);
-            npdLoader(doc29Ns.DepartureLamax, OperationType::Departure, NoiseSingleMetric::Lamax);
-            npdLoader(doc29Ns.DepartureSel, OperationType::Departure, NoiseSingleMetric::Sel);
-
             stmtNs.step();
         }
     }
+
+    void Doc29NoiseManager::loadNpd(const Doc29Noise& Doc29Ns) {
+        m_NpdLoader.load(Doc29Ns, [&] {
+            auto& doc29Ns = c_Doc29Noises(Doc29Ns.Name);
+            const auto rd = m_Db.reader();
+            loadNpdData(*rd, doc29Ns.Name, doc29Ns.ArrivalLamax, OperationType::Arrival, NoiseSingleMetric::Lamax);
+            loadNpdData(*rd, doc29Ns.Name, doc29Ns.ArrivalSel, OperationType::Arrival, NoiseSingleMetric::Sel);
+            loadNpdData(*rd, doc29Ns.Name, doc29Ns.DepartureLamax, OperationType::Departure, NoiseSingleMetric::Lamax);
+            loadNpdData(*rd, doc29Ns.Name, doc29Ns.DepartureSel, OperationType::Departure, NoiseSingleMetric::Sel);
+            });
+    }
 }
@@ -28,10 +28,24 @@ namespace GRAPE {
         void updateNoise(const Doc29Noise& Doc29Ns) const;
         void updateMetric(const Doc29Noise& Doc29Ns, OperationType OpType, NoiseSingleMetric NsMetric) const;
 
+        /**
+        * @brief Loads the Doc29 noise entries and their spectra. The NPD data is loaded by loadNpd().
+        */
         void loadFromFile();
 
+        /**
+        * @brief Thread safe. Loads the NPD data of Doc29Ns from the database on the first call, following calls return immediately.
+        */
+        void loadNpd(const Doc29Noise& Doc29Ns);
+
+        /**
+        * @return True if the NPD data of Doc29Ns is in memory.
+        */
+        [[nodiscard]] bool npdLoaded(const Doc29Noise& Doc29Ns) const { return m_NpdLoader.loaded(Doc29Ns); }
+
     private:
         GrapeMap<std::string, Doc29Noise> c_Doc29Noises{};
+        DetailsLoader<Doc29Noise> m_NpdLoader;
 
     private:
         void updateNpdData(const Doc29Noise& Doc29Ns, OperationType OpType, NoiseSingleMetric NsMetric, const NpdData& Npd) const;
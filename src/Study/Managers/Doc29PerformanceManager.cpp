@@ -60,14 +60,19 @@ namespace GRAPE {
         GRAPE_ASSERT(added);
 
         if (added)
+        {
             m_Db.insert(Schema::doc29_performance, {}, std::make_tuple(doc29Acft.Name, doc29Acft.MaximumSeaLevelStaticThrust, Doc29Thrust::Types.toString(doc29Acft.thrust().type()), doc29Acft.EngineBreakpointTemperature));
+            m_ProfilesLoader.setLoaded(doc29Acft);
+        }
         else
             Log::dataLogic()->error("Adding Doc29 aircraft '{}'. Aircraft already exists in this study.", Name);
 
         return { doc29Acft, added };
     }
 
-    bool Doc29PerformanceManager::addProfileArrival(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) const {
+    bool Doc29PerformanceManager::addProfileArrival(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) {
+        loadProfiles(Doc29Acft); // Loading afterwards would add the stored profiles to the new one
+
         const std::string newName = Name.empty() ? uniqueKeyGenerator(Doc29Acft.ArrivalProfiles, "New Doc29 Arrival Profile") : Name;
 
         std::unique_ptr<Doc29ProfileArrival> newProfile;
@@ -97,7 +102,9 @@ namespace GRAPE {
         return added;
     }
 
-    bool Doc29PerformanceManager::addProfileDeparture(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) const {
+    bool Doc29PerformanceManager::addProfileDeparture(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) {
+        loadProfiles(Doc29Acft);
+
         const std::string newName = Name.empty() ? uniqueKeyGenerator(Doc29Acft.DepartureProfiles, "New Doc29 Departure Profile") : Name;
 
         std::unique_ptr<Doc29ProfileDeparture> newProfile;
@@ -149,17 +156,22 @@ namespace GRAPE {
         GRAPE_ASSERT(added);
 
         if (added)
+        {
             m_Db.insert(Schema::doc29_performance, {}, std::make_tuple(doc29Acft.Name, doc29Acft.MaximumSeaLevelStaticThrust, Doc29Thrust::Types.toString(doc29Acft.thrust().type()), doc29Acft.EngineBreakpointTemperature));
+            m_ProfilesLoader.setLoaded(doc29Acft);
+        }
         else
             throw GrapeException(std::format("Aircraft '{}' already exists in this study.", Name));
 
         return doc29Acft;
     }
 
-    Doc29ProfileArrival& Doc29PerformanceManager::addProfileArrivalE(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) const {
+    Doc29ProfileArrival& Doc29PerformanceManager::addProfileArrivalE(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) {
         if (Name.empty())
             throw GrapeException("Empty Doc29 arrival profile name not allowed.");
 
+        loadProfiles(Doc29Acft);
+
         std::unique_ptr<Doc29ProfileArrival> newProfile;
         switch (ProfileType)
         {
@@ -186,7 +198,9 @@ namespace GRAPE {
         return *doc29Prof;
     }
 
-    Doc29ProfileDeparture& Doc29PerformanceManager::addProfileDepartureE(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) const {
+    Doc29ProfileDeparture& Doc29PerformanceManager::addProfileDepartureE(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) {
+        loadProfiles(Doc29Acft);
+
         std::unique_ptr<Doc29ProfileDeparture> newProfile;
         switch (ProfileType)
         {
@@ -229,6 +243,7 @@ namespace GRAPE {
             }
 
             m_Db.deleteD(Schema::doc29_performance, { 0 }, std::make_tuple(name));
+            m_ProfilesLoader.erase(doc29Acft);
             return true;
             });
     }
@@ -242,6 +257,7 @@ namespace GRAPE {
 
         m_Db.deleteD(Schema::doc29_performance, { 0 }, std::make_tuple(Doc29Acft.Name));
 
+        m_ProfilesLoader.erase(Doc29Acft);
         m_Doc29Aircrafts.erase(Doc29Acft.Name);
     }
 
@@ -396,6 +412,8 @@ namespace GRAPE {
     }
 
     void Doc29PerformanceManager::updateProfile(const Doc29Profile& Doc29Prof) const {
+        GRAPE_ASSERT(profilesLoaded(Doc29Prof.parentDoc29Performance()));
+
         // Updating reinserts profile
         m_Db.deleteD(Schema::doc29_performance_profiles, { 0, 1, 2 }, std::make_tuple(Doc29Prof.parentDoc29Performance().Name, OperationTypes.toString(Doc29Prof.operationType()), Doc29Prof.Name));
         m_Db.insert(Schema::doc29_performance_profiles, {}, std::make_tuple(Doc29Prof.parentDoc29Performance().Name, OperationTypes.toString(Doc29Prof.operationType()), Doc29Prof.Name, Doc29Profile::Types.toString(Doc29Prof.type())));
@@ -572,14 +590,12 @@ namespace GRAPE {
                 {
                 case OperationType::Arrival:
                     {
-                        auto [doc29Prof, added] = doc29Acft.addArrivalProfile(doc29ProfName, profType);
-                        ProfileLoader profLoader(m_Db, doc29Prof);
+                        doc29Acft.addArrivalProfile(doc29ProfName, profType);
                         break;
                     }
                 case OperationType::Departure:
                     {
-                        auto [doc29Prof, added] = doc29Acft.addDepartureProfile(doc29ProfName, profType);
-                        ProfileLoader profLoader(m_Db, doc29Prof);
+                        doc29Acft.addDepartureProfile(doc29ProfName, profType);
                         break;
                     }
                 default: GRAPE_ASSERT(false);
@@ -590,6 +606,18 @@ namespace GRAPE {
         }
     }
 
+    void Doc29PerformanceManager::loadProfiles(const Doc29Aircraft& Doc29Acft) {
+        m_ProfilesLoader.load(Doc29Acft, [&] {
+            auto& doc29Acft = m_Doc29Aircrafts(Doc29Acft.Name);
+            const auto rd = m_Db.reader();
+            for (const auto& [doc29ProfId, doc29ProfPtr] : doc29Acft.ArrivalProfiles)
+                ProfileLoader profLoader(*rd, *doc29ProfPtr);
+
+            for (const auto& [doc29ProfId, doc29ProfPtr] : doc29Acft.DepartureProfiles)
+                ProfileLoader profLoader(*rd, *doc29ProfPtr);
+            });
+    }
+
     void ThrustCoefficientsLoader::visitDoc29ThrustRating(Doc29ThrustRating& Doc29Thr) {
         Statement stmt(m_Db, Schema::doc29_performance_thrust_ratings.querySelect({ 1 }, { 0 }));
         stmt.bindValues(m_Doc29Acft.Name);
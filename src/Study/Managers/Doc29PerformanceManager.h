@@ -18,12 +18,12 @@ namespace GRAPE {
         [[nodiscard]] auto end() const { return std::views::values(m_Doc29Aircrafts).end(); }
 
         std::pair<Doc29Aircraft&, bool> addPerformance(const std::string& Name = "");
-        bool addProfileArrival(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name = "") const;
-        bool addProfileDeparture(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name = "") const;
+        bool addProfileArrival(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name = "");
+        bool addProfileDeparture(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name = "");
 
         Doc29Aircraft& addPerformanceE(const std::string& Name);
-        Doc29ProfileArrival& addProfileArrivalE(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) const;
-        Doc29ProfileDeparture& addProfileDepartureE(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name) const;
+        Doc29ProfileArrival& addProfileArrivalE(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name);
+        Doc29ProfileDeparture& addProfileDepartureE(Doc29Aircraft& Doc29Acft, Doc29Profile::Type ProfileType, const std::string& Name);
 
         void erasePerformances();
         void erasePerformance(const Doc29Aircraft& Doc29Acft);
@@ -40,9 +40,24 @@ namespace GRAPE {
         void updateAerodynamicCoefficients(const Doc29Aircraft& Doc29Acft) const;
         void updateProfile(const Doc29Profile& Doc29Prof) const;
 
+        /**
+        * @brief Loads the Doc29 aircraft with their thrust, aerodynamic coefficients and profile names. The points and steps of the profiles are loaded by loadProfiles().
+        */
         void loadFromFile();
 
+        /**
+        * @brief Thread safe. Loads the points and steps of all profiles of Doc29Acft from the database on the first call, following calls return immediately.
+        * All profiles of an aircraft are loaded together, as the procedural steps block the aerodynamic coefficients they use.
+        */
+        void loadProfiles(const Doc29Aircraft& Doc29Acft);
+
+        /**
+        * @return True if the points and steps of the profiles of Doc29Acft are in memory.
+        */
+        [[nodiscard]] bool profilesLoaded(const Doc29Aircraft& Doc29Acft) const { return m_ProfilesLoader.loaded(Doc29Acft); }
+
     private:
         GrapeMap<std::string, Doc29Aircraft> m_Doc29Aircrafts{};
+        DetailsLoader<Doc29Aircraft> m_ProfilesLoader;
     };
 }
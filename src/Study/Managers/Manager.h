@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+
 #include "Constraints.h"
 
 #include "Database/Database.h"
@@ -17,4 +21,76 @@ namespace GRAPE {
         const Database& m_Db;
         Constraints& m_Blocks;
     };
+
+    /**
+    * @brief Tracks which entities had their details loaded from the database.
+    *
+    * Entities are loaded at most once. Different entities can be loaded concurrently, a thread loading an entity which is being loaded by another thread blocks until it is loaded.
+    */
+    template <typename EntityT>
+    class DetailsLoader {
+    public:
+        /**
+        * @brief Calls Load if Entity was not loaded yet. Thread safe.
+        * If Load throws, Entity is not marked as loaded and the next call loads it again.
+        */
+        template <typename LoadFunction>
+        void load(const EntityT& Entity, LoadFunction&& Load) {
+            {
+                std::unique_lock lck(m_Mutex);
+                m_Condition.wait(lck, [&] { return !m_Loading.contains(&Entity); });
+                if (m_Loaded.contains(&Entity))
+                    return;
+                m_Loading.emplace(&Entity);
+            }
+
+            // Releases the threads waiting for Entity on every exit path
+            struct LoadingGuard {
+                DetailsLoader& Loader;
+                const EntityT& Entity;
+                bool Loaded = false;
+
+                ~LoadingGuard() {
+                    {
+                        std::scoped_lock lck(Loader.m_Mutex);
+                        Loader.m_Loading.erase(&Entity);
+                        if (Loaded)
+                            Loader.m_Loaded.emplace(&Entity);
+                    }
+                    Loader.m_Condition.notify_all();
+                }
+            } guard{ *this, Entity };
+
+            Load();
+            guard.Loaded = true;
+        }
+
+        /**
+        * @brief Marks Entity as loaded, for entities which are added after the study was opened.
+        */
+        void setLoaded(const EntityT& Entity) {
+            std::scoped_lock lck(m_Mutex);
+            m_Loaded.emplace(&Entity);
+        }
+
+        /**
+        * @brief Forgets Entity, must be called before it is destroyed.
+        */
+        void erase(const EntityT& Entity) {
+            std::scoped_lock lck(m_Mutex);
+            GRAPE_ASSERT(!m_Loading.contains(&Entity));
+            m_Loaded.erase(&Entity);
+        }
+
+        [[nodiscard]] bool loaded(const EntityT& Entity) const {
+            std::scoped_lock lck(m_Mutex);
+            return m_Loaded.contains(&Entity);
+        }
+
+    private:
+        mutable std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::unordered_set<const EntityT*> m_Loading;
+        std::unordered_set<const EntityT*> m_Loaded;
+    };
 }
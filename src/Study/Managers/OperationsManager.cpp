@@ -61,7 +61,7 @@ namespace GRAPE {
                 const auto i = it - Op.begin();
                 auto& pt = *it;
                 stmt.bind(2, static_cast<int>(i + 1));
-                stmt.bind(3, FlightPhases.toString(pt.FlPhase));
+                stmt.bind(3, pt.FlPhase);
                 stmt.bind(4, pt.CumulativeGroundDistance);
                 stmt.bind(5, pt.Longitude);
                 stmt.bind(6, pt.Latitude);
@@ -97,7 +97,7 @@ namespace GRAPE {
         };
     }
 
-    OperationsManager::OperationsManager(const Database& Db, Constraints& Blocks, AircraftsManager& Aircrafts, AirportsManager& Airports) : Manager(Db, Blocks), Tracks4dLoader(Db), m_Aircrafts(Aircrafts), m_Airports(Airports) {}
+    OperationsManager::OperationsManager(const Database& Db, Constraints& Blocks, AircraftsManager& Aircrafts, AirportsManager& Airports) : Manager(Db, Blocks), m_Aircrafts(Aircrafts), m_Airports(Airports) {}
 
     std::pair<FlightArrival&, bool> OperationsManager::addArrivalFlight(const std::string& Name, const Aircraft& AircraftIn) {
         auto ret = m_FlightArrivals.add(Name, Name, AircraftIn);
@@ -715,24 +715,46 @@ namespace GRAPE {
         }
     }
 
-    void OperationsManager::loadArr(const Track4dArrival& Op) { load(m_Track4dArrivals(Op.Name)); }
+    void OperationsManager::loadArr(const Track4dArrival& Op) { loadShared(m_Track4dArrivals(Op.Name)); }
 
-    void OperationsManager::loadDep(const Track4dDeparture& Op) { load(m_Track4dDepartures(Op.Name)); }
+    void OperationsManager::loadDep(const Track4dDeparture& Op) { loadShared(m_Track4dDepartures(Op.Name)); }
 
-    void OperationsManager::unloadArr(const Track4dArrival& Op, bool Shrink) { m_Track4dArrivals(Op.Name).clear(Shrink); }
+    void OperationsManager::unloadArr(const Track4dArrival& Op, bool Shrink) { unloadShared(m_Track4dArrivals(Op.Name), Shrink); }
 
-    void OperationsManager::unloadDep(const Track4dDeparture& Op, bool Shrink) { m_Track4dDepartures(Op.Name).clear(Shrink); }
+    void OperationsManager::unloadDep(const Track4dDeparture& Op, bool Shrink) { unloadShared(m_Track4dDepartures(Op.Name), Shrink); }
 
     void OperationsManager::load(Track4d& Op) {
         std::scoped_lock lck(Tracks4dLoader.Mutex);
+        loadPoints(Op);
+    }
+
+    void OperationsManager::loadShared(Track4d& Op) {
+        std::scoped_lock lck(Tracks4dLoader.Mutex);
+        if (Tracks4dLoader.Users[&Op]++ == 0)
+            loadPoints(Op);
+    }
+
+    void OperationsManager::unloadShared(Track4d& Op, bool Shrink) {
+        std::scoped_lock lck(Tracks4dLoader.Mutex);
+        const auto it = Tracks4dLoader.Users.find(&Op);
+        if (it == Tracks4dLoader.Users.end())
+            return;
+
+        if (--it->second == 0)
+        {
+            Tracks4dLoader.Users.erase(it);
+            Op.clear(Shrink);
+        }
+    }
 
-        Tracks4dLoader.Db.beginTransaction();
-        Statement stmt(Tracks4dLoader.Db, Schema::operations_tracks_4d_points.querySelect({ 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }, { 0, 1 }, { 2 }));
+    void OperationsManager::loadPoints(Track4d& Op) {
+        const auto rd = m_Db.reader();
+        Statement stmt(*rd, Schema::operations_tracks_4d_points.querySelect({ 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }, { 0, 1 }, { 2 }));
         stmt.bindValues(primaryKey(Op));
         stmt.step();
         while (stmt.hasRow())
         {
-            const FlightPhase flPhase = FlightPhases.fromString(stmt.getColumn(0));
+            const auto flPhase = stmt.getColumn(0).getEnum<FlightPhase>();
             const double cumGroundDist = stmt.getColumn(1);
             const double lon = stmt.getColumn(2);
             const double lat = stmt.getColumn(3);
@@ -746,6 +768,5 @@ namespace GRAPE {
 
             stmt.step();
         }
-        Tracks4dLoader.Db.commitTransaction();
     }
 }
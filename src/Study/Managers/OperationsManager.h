@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "Manager.h"
 
 #include "Aircraft/Aircraft.h"
@@ -78,12 +80,15 @@ namespace GRAPE {
         [[nodiscard]] std::size_t operationsSize() const { return flightsSize() + tracks4dSize(); }
 
         struct Tracks4dLoader {
-            explicit Tracks4dLoader(const Database& DbIn) : Db(DbIn) {}
-            Database Db;
             std::mutex Mutex;
+            std::unordered_map<const Track4d*, std::size_t> Users; // Number of loadArr() or loadDep() calls without a matching unload
         } Tracks4dLoader;
 
         void loadFromFile();
+
+        /**
+        * @brief Thread safe. The points are loaded by the first call and kept until the matching number of unloadArr() calls, concurrent jobs can use the same track.
+        */
         void loadArr(const Track4dArrival& Op);
         void loadDep(const Track4dDeparture& Op);
         void unloadArr(const Track4dArrival& Op, bool Shrink = false);
@@ -91,6 +96,10 @@ namespace GRAPE {
         void load(Track4d& Op);
 
     private:
+        void loadShared(Track4d& Op);
+        void unloadShared(Track4d& Op, bool Shrink);
+        void loadPoints(Track4d& Op);
+
         AircraftsManager& m_Aircrafts;
         AirportsManager& m_Airports;
 
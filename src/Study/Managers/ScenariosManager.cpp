@@ -7,7 +7,10 @@
 #include "Jobs/JobManager.h"
 #include "Noise/ReceptorSets.h"
 #include "OperationsManager.h"
+#include "OutputDatabase.h"
 #include "Schema/Schema.h"
+#include "Schema/SchemaOutput.h"
+#include "Study.h"
 
 namespace GRAPE {
     namespace {
@@ -40,7 +43,7 @@ namespace GRAPE {
         };
     }
 
-    ScenariosManager::ScenariosManager(const Database& Db, Constraints& Blocks, OperationsManager& Ops, JobManager& Jobs) : Manager(Db, Blocks), m_Operations(Ops), m_Jobs(Jobs) {}
+    ScenariosManager::ScenariosManager(const Database& Db, Constraints& Blocks, Doc29PerformanceManager& Doc29Acfts, Doc29NoiseManager& Doc29Ns, OperationsManager& Ops, JobManager& Jobs) : Manager(Db, Blocks), m_Doc29Aircrafts(Doc29Acfts), m_Doc29Noises(Doc29Ns), m_Operations(Ops), m_Jobs(Jobs) {}
 
     std::pair<Scenario&, bool> ScenariosManager::addScenario(const std::string& Name) {
         const std::string newName = Name.empty() ? uniqueKeyGenerator(m_Scenarios, "New Scenario") : Name;
@@ -65,7 +68,7 @@ namespace GRAPE {
         if (added)
         {
             m_Db.insert(Schema::performance_run, { 0, 1 }, std::make_tuple(perfRun.parentScenario().Name, perfRun.Name));
-            perfRun.createJob(m_Db, m_Operations);
+            perfRun.createJob(m_Db, m_Operations, m_Doc29Aircrafts);
         }
         else { Log::dataLogic()->error("Adding performance run '{}'. Performance run already exists in scenario '{}'.", newName, Scen.Name); }
 
@@ -82,7 +85,7 @@ namespace GRAPE {
         {
             m_Db.insert(Schema::noise_run, { 0, 1, 2 }, std::make_tuple(nsRun.parentScenario().Name, nsRun.parentPerformanceRun().Name, nsRun.Name));
             ReceptorSetUpdater up(m_Db, nsRun);
-            nsRun.createJob(m_Db, m_Blocks);
+            nsRun.createJob(m_Db, m_Blocks, m_Doc29Noises);
         }
         else { Log::dataLogic()->error("Adding noise run '{}'. Noise run already exists in performance run '{}' of scenario '{}'.", newName, PerfRun.Name, PerfRun.parentScenario().Name); }
 
@@ -144,7 +147,7 @@ namespace GRAPE {
         if (added)
         {
             m_Db.insert(Schema::performance_run, { 0, 1 }, std::make_tuple(perfRun.parentScenario().Name, perfRun.Name));
-            perfRun.createJob(m_Db, m_Operations);
+            perfRun.createJob(m_Db, m_Operations, m_Doc29Aircrafts);
         }
         else { throw GrapeException(std::format("Performance run '{}' already exists in scenario '{}'.", perfRun.Name, Scen.Name)); }
 
@@ -161,7 +164,7 @@ namespace GRAPE {
         {
             m_Db.insert(Schema::noise_run, { 0, 1, 2 }, std::make_tuple(nsRun.parentScenario().Name, nsRun.parentPerformanceRun().Name, nsRun.Name));
             ReceptorSetUpdater up(m_Db, nsRun);
-            nsRun.createJob(m_Db, m_Blocks);
+            nsRun.createJob(m_Db, m_Blocks, m_Doc29Noises);
         }
         else { throw GrapeException(std::format("Noise run '{}' already exists in performance run '{}' of scenario '{}'.", nsRun.Name, PerfRun.Name, PerfRun.parentScenario().Name)); }
 
@@ -220,22 +223,27 @@ namespace GRAPE {
             });
     }
 
+    /**
+    * All jobs are stopped before the output database is replaced by an empty one, resetting them afterwards only clears the outputs in memory.
+    */
     void ScenariosManager::eraseOutputs() {
-        for (const auto& scen : m_Scenarios | std::views::values)
-        {
-            for (const auto& perfRun : scen.PerformanceRuns | std::views::values)
+        const auto forEachJob = [&](const auto& Func) {
+            for (const auto& scen : m_Scenarios | std::views::values)
             {
-                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
-                    m_Jobs.resetJob(nsRun.job());
-                for (const auto& emiRun : perfRun.EmissionsRuns | std::views::values)
-                    m_Jobs.resetJob(emiRun.job());
-                m_Jobs.resetJob(perfRun.job());
+                for (const auto& perfRun : scen.PerformanceRuns | std::views::values)
+                {
+                    for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+                        Func(nsRun.job());
+                    for (const auto& emiRun : perfRun.EmissionsRuns | std::views::values)
+                        Func(emiRun.job());
+                    Func(perfRun.job());
+                }
             }
-        }
+        };
 
-        m_Db.deleteD(Schema::performance_run_output);
-        m_Db.deleteD(Schema::noise_run_output_receptors);
-        m_Db.deleteD(Schema::emissions_run_output);
+        forEachJob([&](const std::shared_ptr<Job>& Jb) { m_Jobs.stopJob(Jb); });
+        m_Db.recreateAttached(std::string(Schema::Output::g_name));
+        forEachJob([&](const std::shared_ptr<Job>& Jb) { m_Jobs.resetJob(Jb); });
     }
 
     void ScenariosManager::erase(const Scenario& Scen) {
@@ -463,10 +471,117 @@ namespace GRAPE {
         stmt.step();
     }
 
+    /**
+    * Must be called before Op is added to Scen.
+    * Finished performance runs and the noise runs which can be updated are outdated, their outputs are updated for Op when run again.
+    * Emissions runs and all other started runs are reset.
+    */
+    template<typename OpT>
+    void ScenariosManager::addToRuns(const Scenario& Scen, const OpT& Op) const {
+        for (const auto& perfRun : Scen.PerformanceRuns | std::views::values)
+        {
+            const auto& perfJob = perfRun.job();
+            if (perfJob->ready())
+                continue;
+
+            for (const auto& emiRun : perfRun.EmissionsRuns | std::views::values)
+                m_Jobs.resetJob(emiRun.job());
+
+            if (!perfJob->finished() && !perfJob->outdated())
+            {
+                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+                    m_Jobs.resetJob(nsRun.job());
+                m_Jobs.resetJob(perfJob);
+                continue;
+            }
+
+            for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+            {
+                const auto& nsJob = nsRun.job();
+                if (nsJob->ready())
+                    continue;
+
+                if ((!nsJob->finished() && !nsJob->outdated()) || !nsRun.output().updatable())
+                {
+                    m_Jobs.resetJob(nsJob);
+                    continue;
+                }
+
+                m_Blocks.noiseRunBlock(Op, nsRun);
+                nsRun.output().invalidateCumulative();
+                nsJob->setOutdated();
+            }
+
+            m_Blocks.performanceRunBlock(Op, perfRun);
+            perfJob->setOutdated();
+        }
+    }
+
+    /**
+    * Must be called before Op is erased from Scen.
+    * The output of Op is erased from finished performance runs and removed from the noise runs which can be updated, which are outdated to finish their cumulative outputs.
+    * The noise run outputs are changed in memory, saveOperationChanges() must be called once all operations are erased.
+    * Emissions runs and all other started runs are reset.
+    */
+    template<typename OpT>
+    void ScenariosManager::eraseFromRuns(const Scenario& Scen, const OpT& Op) const {
+        for (const auto& perfRun : Scen.PerformanceRuns | std::views::values)
+        {
+            const auto& perfJob = perfRun.job();
+            if (perfJob->ready())
+                continue;
+
+            // Emissions run outputs reference the performance run outputs
+            for (const auto& emiRun : perfRun.EmissionsRuns | std::views::values)
+                m_Jobs.resetJob(emiRun.job());
+
+            if (!perfJob->finished() && !perfJob->outdated())
+            {
+                for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+                    m_Jobs.resetJob(nsRun.job());
+                m_Jobs.resetJob(perfJob);
+                continue;
+            }
+
+            for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+            {
+                const auto& nsJob = nsRun.job();
+                if (nsJob->ready())
+                    continue;
+
+                if ((!nsJob->finished() && !nsJob->outdated()) || !nsRun.output().removeOperation(Op))
+                {
+                    m_Jobs.resetJob(nsJob);
+                    continue;
+                }
+
+                m_Blocks.noiseRunUnblock(Op, nsRun);
+                nsJob->setOutdated();
+            }
+
+            m_Blocks.performanceRunUnblock(Op, perfRun);
+            if constexpr (std::is_base_of_v<OperationArrival, OpT>)
+                perfRun.output().eraseArrivalOutput(Op);
+            else
+                perfRun.output().eraseDepartureOutput(Op);
+        }
+    }
+
+    /**
+    * Saves the changes accumulated in memory by addToRuns() and eraseFromRuns(), a single transaction per noise run.
+    */
+    void ScenariosManager::saveOperationChanges(const Scenario& Scen) const {
+        for (const auto& perfRun : Scen.PerformanceRuns | std::views::values)
+            for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+                nsRun.output().saveOperationChanges();
+    }
+
     bool ScenariosManager::addFlightArrival(Scenario& Scen, const FlightArrival& Op) const {
         if (Scen.contains(Op))
             return false;
 
+        addToRuns(Scen, Op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioBlockOperation(Scen, Op);
         m_Db.insert(Schema::scenarios_flights, {}, std::make_tuple(Scen.Name, Op.Name, OperationTypes.toString(Op.operationType())));
 
@@ -478,6 +593,8 @@ namespace GRAPE {
         if (Scen.contains(Op))
             return false;
 
+        addToRuns(Scen, Op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioBlockOperation(Scen, Op);
         m_Db.insert(Schema::scenarios_flights, {}, std::make_tuple(Scen.Name, Op.Name, OperationTypes.toString(Op.operationType())));
 
@@ -489,6 +606,8 @@ namespace GRAPE {
         if (Scen.contains(Op))
             return false;
 
+        addToRuns(Scen, Op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioBlockOperation(Scen, Op);
         m_Db.insert(Schema::scenarios_tracks_4d, {}, std::make_tuple(Scen.Name, Op.Name, OperationTypes.toString(Op.operationType())));
 
@@ -500,6 +619,8 @@ namespace GRAPE {
         if (Scen.contains(Op))
             return false;
 
+        addToRuns(Scen, Op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioBlockOperation(Scen, Op);
         m_Db.insert(Schema::scenarios_tracks_4d, {}, std::make_tuple(Scen.Name, Op.Name, OperationTypes.toString(Op.operationType())));
 
@@ -515,6 +636,8 @@ namespace GRAPE {
         if (Scen.contains(op))
             throw GrapeException(std::format("Arrival flight '{}' is already in scenario '{}'.", OpName, Scen.Name));
 
+        addToRuns(Scen, op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioBlockOperation(Scen, op);
         m_Db.insert(Schema::scenarios_flights, {}, std::make_tuple(Scen.Name, op.Name, OperationTypes.toString(op.operationType())));
 
@@ -529,6 +652,8 @@ namespace GRAPE {
         if (Scen.contains(op))
             throw GrapeException(std::format("Departure flight '{}' is already in scenario '{}'.", OpName, Scen.Name));
 
+        addToRuns(Scen, op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioBlockOperation(Scen, op);
         m_Db.insert(Schema::scenarios_flights, {}, std::make_tuple(Scen.Name, op.Name, OperationTypes.toString(op.operationType())));
 
@@ -543,6 +668,8 @@ namespace GRAPE {
         if (Scen.contains(op))
             throw GrapeException(std::format("Arrival track 4D '{}' is already in scenario '{}'.", OpName, Scen.Name));
 
+        addToRuns(Scen, op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioBlockOperation(Scen, op);
         m_Db.insert(Schema::scenarios_tracks_4d, {}, std::make_tuple(Scen.Name, op.Name, OperationTypes.toString(op.operationType())));
 
@@ -557,6 +684,8 @@ namespace GRAPE {
         if (Scen.contains(op))
             throw GrapeException(std::format("Departure track 4D '{}' is already in scenario '{}'.", OpName, Scen.Name));
 
+        addToRuns(Scen, op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioBlockOperation(Scen, op);
         m_Db.insert(Schema::scenarios_tracks_4d, {}, std::make_tuple(Scen.Name, op.Name, OperationTypes.toString(op.operationType())));
 
@@ -567,6 +696,8 @@ namespace GRAPE {
         if (!Scen.contains(Op))
             return false;
 
+        eraseFromRuns(Scen, Op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioUnblockOperation(Scen, Op);
         m_Db.deleteD(Schema::scenarios_flights, { 0, 1, 2 }, std::make_tuple(Scen.Name, Op.Name, OperationTypes.toString(Op.operationType())));
 
@@ -578,6 +709,8 @@ namespace GRAPE {
         if (!Scen.contains(Op))
             return false;
 
+        eraseFromRuns(Scen, Op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioUnblockOperation(Scen, Op);
         m_Db.deleteD(Schema::scenarios_flights, { 0, 1, 2 }, std::make_tuple(Scen.Name, Op.Name, OperationTypes.toString(Op.operationType())));
 
@@ -589,6 +722,8 @@ namespace GRAPE {
         if (!Scen.contains(Op))
             return false;
 
+        eraseFromRuns(Scen, Op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioUnblockOperation(Scen, Op);
         m_Db.deleteD(Schema::scenarios_tracks_4d, { 0, 1, 2 }, std::make_tuple(Scen.Name, Op.Name, OperationTypes.toString(Op.operationType())));
 
@@ -600,6 +735,8 @@ namespace GRAPE {
         if (!Scen.contains(Op))
             return false;
 
+        eraseFromRuns(Scen, Op);
+        saveOperationChanges(Scen);
         m_Blocks.scenarioUnblockOperation(Scen, Op);
         m_Db.deleteD(Schema::scenarios_tracks_4d, { 0, 1, 2 }, std::make_tuple(Scen.Name, Op.Name, OperationTypes.toString(Op.operationType())));
 
@@ -608,6 +745,12 @@ namespace GRAPE {
     }
 
     void ScenariosManager::eraseFlights(Scenario& Scen) const {
+        for (const FlightArrival& op : Scen.FlightArrivals)
+            eraseFromRuns(Scen, op);
+        for (const FlightDeparture& op : Scen.FlightDepartures)
+            eraseFromRuns(Scen, op);
+        saveOperationChanges(Scen);
+
         m_Blocks.scenarioUnblockFlights(Scen);
         m_Db.deleteD(Schema::scenarios_flights, { 0 }, std::make_tuple(Scen.Name));
 
@@ -616,6 +759,12 @@ namespace GRAPE {
     }
 
     void ScenariosManager::eraseTracks4d(Scenario& Scen) const {
+        for (const Track4dArrival& op : Scen.Track4dArrivals)
+            eraseFromRuns(Scen, op);
+        for (const Track4dDeparture& op : Scen.Track4dDepartures)
+            eraseFromRuns(Scen, op);
+        saveOperationChanges(Scen);
+
         m_Blocks.scenarioUnblockTracks4d(Scen);
         m_Db.deleteD(Schema::scenarios_tracks_4d, { 0 }, std::make_tuple(Scen.Name));
 
@@ -623,6 +772,23 @@ namespace GRAPE {
         Scen.Track4dDepartures.clear();
     }
 
+    bool ScenariosManager::operationsEditable(const Scenario& Scen) const {
+        const auto editable = [](const auto& Jb) { return Jb->ready() || Jb->finished() || Jb->outdated(); };
+
+        for (const auto& perfRun : Scen.PerformanceRuns | std::views::values)
+        {
+            if (!editable(perfRun.job()))
+                return false;
+            for (const auto& nsRun : perfRun.NoiseRuns | std::views::values)
+                if (!editable(nsRun.job()))
+                    return false;
+            for (const auto& emiRun : perfRun.EmissionsRuns | std::views::values)
+                if (!editable(emiRun.job()))
+                    return false;
+        }
+        return true;
+    }
+
     PerformanceRunUpdater::PerformanceRunUpdater(const Database& Db, const PerformanceRun& PerfRun) : m_Db(Db), m_PerfRun(PerfRun), m_Stmt(Db, Schema::performance_run.queryUpdate({}, { 0, 1 })) {
         const auto& spec = PerfRun.PerfRunSpec;
         m_Stmt.bind(0, PerfRun.parentScenario().Name);
@@ -850,10 +1016,10 @@ namespace GRAPE {
                 }
 
                 // Job
-                perfRun.createJob(m_Db, m_Operations);
+                perfRun.createJob(m_Db, m_Operations, m_Doc29Aircrafts);
 
                 // Performance Outputs
-                Statement stmtPerfOut(m_Db, Schema::performance_run_output.querySelect({ 2, 3, 4 }, { 0, 1 }));
+                Statement stmtPerfOut(m_Db, Schema::performance_run_output.querySelect({ 0, 3, 4, 5 }, { 1, 2 }));
                 stmtPerfOut.bindValues(scenName, perfRunName);
                 stmtPerfOut.step();
 
@@ -861,14 +1027,16 @@ namespace GRAPE {
                 {
                     perfRun.job()->queue();
                     perfRun.job()->setFinished();
+                    perfRun.output().stopWriter(true); // Started by queue(), streams would never be closed
                 }
 
                 bool perfRunReset = false;
                 while (stmtPerfOut.hasRow())
                 {
-                    const std::string opId = stmtPerfOut.getColumn(0);
-                    OperationType op = OperationTypes.fromString(stmtPerfOut.getColumn(1));
-                    Operation::Type opType = Operation::Types.fromString(stmtPerfOut.getColumn(2));
+                    const std::int64_t outId = stmtPerfOut.getColumn(0).getInt64();
+                    const std::string opId = stmtPerfOut.getColumn(1);
+                    const auto op = stmtPerfOut.getColumn(2).getEnum<OperationType>();
+                    const auto opType = stmtPerfOut.getColumn(3).getEnum<Operation::Type>();
 
                     switch (op)
                     {
@@ -885,6 +1053,7 @@ namespace GRAPE {
                                         break;
                                     }
                                     perfRun.output().m_ArrivalOutputs.emplace_back(m_Operations.flightArrivals()(opId));
+                                    perfRun.output().m_OutputIds.emplace(&m_Operations.flightArrivals()(opId), outId);
                                     break;
                                 }
                             case Operation::Type::Track4d:
@@ -896,6 +1065,7 @@ namespace GRAPE {
                                         break;
                                     }
                                     perfRun.output().m_ArrivalOutputs.emplace_back(m_Operations.track4dArrivals()(opId));
+                                    perfRun.output().m_OutputIds.emplace(&m_Operations.track4dArrivals()(opId), outId);
                                     break;
                                 }
                             default: GRAPE_ASSERT(false);
@@ -916,6 +1086,7 @@ namespace GRAPE {
                                         break;
                                     }
                                     perfRun.output().m_DepartureOutputs.emplace_back(m_Operations.flightDepartures()(opId));
+                                    perfRun.output().m_OutputIds.emplace(&m_Operations.flightDepartures()(opId), outId);
                                     break;
                                 }
                             case Operation::Type::Track4d:
@@ -927,6 +1098,7 @@ namespace GRAPE {
                                         break;
                                     }
                                     perfRun.output().m_DepartureOutputs.emplace_back(m_Operations.track4dDepartures()(opId));
+                                    perfRun.output().m_OutputIds.emplace(&m_Operations.track4dDepartures()(opId), outId);
                                     break;
                                 }
                             default: GRAPE_ASSERT(false);
@@ -939,6 +1111,14 @@ namespace GRAPE {
                     stmtPerfOut.step();
                 }
 
+                // Operations added to the scenario after the run finished have no output, they are calculated when the run is updated
+                if (perfRun.job()->finished() && !perfRunReset)
+                {
+                    const auto missing = [&](const Operation& Op) { return !perfRun.output().m_OutputIds.contains(&Op); };
+                    if (std::ranges::any_of(scen.FlightArrivals, missing) || std::ranges::any_of(scen.FlightDepartures, missing) || std::ranges::any_of(scen.Track4dArrivals, missing) || std::ranges::any_of(scen.Track4dDepartures, missing))
+                        perfRun.job()->setOutdated();
+                }
+
                 // Noise Runs
                 Statement stmtNsRuns(m_Db, Schema::noise_run.querySelect({ 2, 3, 4, 5, 6 }, { 0, 1 }));
                 stmtNsRuns.bindValues(scenName, perfRunName);
@@ -1002,20 +1182,27 @@ namespace GRAPE {
                     nsRun.NsRunSpec.SaveSingleMetrics = static_cast<bool>(stmtNsRuns.getColumn(4).getInt());
 
                     // Job
-                    nsRun.createJob(m_Db, m_Blocks);
+                    nsRun.createJob(m_Db, m_Blocks, m_Doc29Noises);
 
                     // Receptor Output
-                    Statement stmtReceptOut(m_Db, Schema::noise_run_output_receptors.querySelect({ 3, 4, 5, 6 }, { 0, 1, 2 }));
+                    Statement stmtReceptOut(m_Db, Schema::noise_run_output_receptors.querySelect({ 3, 4, 5, 6 }, { 0, 1, 2 }, { 3 }));
                     stmtReceptOut.bindValues(scenName, perfRunName, nsRunName);
                     stmtReceptOut.step();
 
                     bool nsRunHasOutput = false;
+                    bool nsRunCumulativeInvalidated = false;
                     if (!perfRunReset && stmtReceptOut.hasRow()) // If performance run reset, nsRunHasOutput will be always false
                     {
                         nsRunHasOutput = true;
                         nsRun.job()->queue();
                         nsRun.job()->setFinished();
 
+                        Statement stmtNsOut(m_Db, Schema::noise_run_output.querySelect({ 0 }, { 1, 2, 3 }));
+                        stmtNsOut.bindValues(scenName, perfRunName, nsRunName);
+                        stmtNsOut.step();
+                        if (stmtNsOut.hasRow())
+                            nsRun.output().m_OutputId = stmtNsOut.getColumn(0).getInt64();
+
                         auto& receptOutput = nsRun.output().m_ReceptorOutput;
                         while (stmtReceptOut.hasRow())
                         {
@@ -1027,6 +1214,7 @@ namespace GRAPE {
 
                             stmtReceptOut.step();
                         }
+                        nsRun.output().updateStorageOrder();
                     }
 
                     // Cumulative Metrics
@@ -1081,7 +1269,7 @@ namespace GRAPE {
                             auto [cumOut, addedMetricOutput] = nsRun.output().m_CumulativeOutputs.add(&cumMetric, nsRun.output().receptors().size(), cumMetric.numberAboveThresholds().size());
                             GRAPE_ASSERT(addedMetricOutput);
 
-                            Statement stmtCumMetricOut(m_Db, Schema::noise_run_output_cumulative.querySelect({ 4, 5, 6, 7, 8, 9 }, { 0, 1, 2, 3 }));
+                            Statement stmtCumMetricOut(m_Db, Schema::noise_run_output_cumulative.querySelect({ 4, 5, 6, 7, 8, 9 }, { 0, 1, 2, 3 }, { 4 }));
                             stmtCumMetricOut.bindValues(scenName, perfRunName, nsRunName, cumMetricName);
                             stmtCumMetricOut.step();
                             std::size_t i = 0;
@@ -1097,6 +1285,9 @@ namespace GRAPE {
                                 ++i;
                                 stmtCumMetricOut.step();
                             }
+
+                            if (i == 0)
+                                nsRunCumulativeInvalidated = true;
                         }
 
                         // Cumulative Metrics Number Above Thresholds
@@ -1115,7 +1306,7 @@ namespace GRAPE {
                                 auto& cumOutNat = cumOut.NumberAboveThresholds.emplace_back();
                                 cumOutNat.reserve(nsRun.output().receptors().size());
 
-                                Statement stmtCumMetricNatOut(m_Db, Schema::noise_run_output_cumulative_number_above.querySelect({ 5, 6 }, { 0, 1, 2, 3, 4 }));
+                                Statement stmtCumMetricNatOut(m_Db, Schema::noise_run_output_cumulative_number_above.querySelect({ 5, 6 }, { 0, 1, 2, 3, 4 }, { 5 }));
                                 stmtCumMetricNatOut.bindValues(scenName, perfRunName, nsRunName, cumMetricName, threshold);
                                 stmtCumMetricNatOut.step();
                                 while (stmtCumMetricNatOut.hasRow())
@@ -1130,10 +1321,21 @@ namespace GRAPE {
                         }
                         stmtCumMetric.step();
                     }
+
+                    // Operations were added or removed after the run finished, the linear sums needed to update it are only kept in memory
+                    if (nsRunHasOutput && nsRunCumulativeInvalidated)
+                    {
+                        Log::database()->warn("Loading noise run '{}' of performance run '{}' of scenario '{}'. The operations of the scenario changed after the run finished, the noise run is reset.", nsRunName, perfRunName, scenName);
+                        m_Jobs.resetJob(nsRun.job());
+                    }
                     stmtNsRuns.step();
                 }
 
                 // Emissions Runs
+                std::unordered_map<std::int64_t, const Operation*> perfOutputOps; // Emissions operation outputs reference the performance outputs by id
+                for (const auto& [studyOp, outId] : perfRun.output().m_OutputIds)
+                    perfOutputOps.emplace(outId, studyOp);
+
                 Statement stmtEmiRuns(m_Db, Schema::emissions_run.querySelect({}, { 0, 1 }));
                 stmtEmiRuns.bindValues(scenName, perfRunName);
                 stmtEmiRuns.step();
@@ -1173,7 +1375,7 @@ namespace GRAPE {
                     emiRun.createJob(m_Db, m_Blocks);
 
                     // Outputs
-                    Statement stmtEmiOut(m_Db, Schema::emissions_run_output.querySelect({}, { 0, 1, 2 }));
+                    Statement stmtEmiOut(m_Db, Schema::emissions_run_output.querySelect({}, { 1, 2, 3 }));
                     stmtEmiOut.bindValues(scenName, perfRunName, emiRunName);
                     stmtEmiOut.step();
                     if (!perfRunReset && stmtEmiOut.hasRow())
@@ -1181,62 +1383,34 @@ namespace GRAPE {
                         emiRun.job()->queue();
                         emiRun.job()->setFinished();
 
-                        emiRun.output().m_TotalFuel = stmtEmiOut.getColumn(3);
-                        emiRun.output().m_TotalEmissions.HC = stmtEmiOut.getColumn(4);
-                        emiRun.output().m_TotalEmissions.CO = stmtEmiOut.getColumn(5);
-                        emiRun.output().m_TotalEmissions.NOx = stmtEmiOut.getColumn(6);
-                        emiRun.output().m_TotalEmissions.nvPM = stmtEmiOut.getColumn(7);
-                        emiRun.output().m_TotalEmissions.nvPMNumber = stmtEmiOut.getColumn(8);
+                        emiRun.output().m_OutputId = stmtEmiOut.getColumn(0).getInt64();
+                        emiRun.output().m_TotalFuel = stmtEmiOut.getColumn(4);
+                        emiRun.output().m_TotalEmissions.HC = stmtEmiOut.getColumn(5);
+                        emiRun.output().m_TotalEmissions.CO = stmtEmiOut.getColumn(6);
+                        emiRun.output().m_TotalEmissions.NOx = stmtEmiOut.getColumn(7);
+                        emiRun.output().m_TotalEmissions.nvPM = stmtEmiOut.getColumn(8);
+                        emiRun.output().m_TotalEmissions.nvPMNumber = stmtEmiOut.getColumn(9);
 
                         // Operation Outputs
-                        Statement stmtEmiOpOut(m_Db, Schema::emissions_run_output_operations.querySelect({}, { 0, 1, 2 }));
-                        stmtEmiOpOut.bindValues(scenName, perfRunName, emiRunName);
+                        Statement stmtEmiOpOut(m_Db, Schema::emissions_run_output_operations.querySelect({ 1, 2, 3, 4, 5, 6, 7 }, { 0 }));
+                        stmtEmiOpOut.bindValues(emiRun.output().m_OutputId);
                         stmtEmiOpOut.step();
                         while (stmtEmiOpOut.hasRow())
                         {
-                            const std::string opId = stmtEmiOpOut.getColumn(3);
-                            OperationType op = OperationTypes.fromString(stmtEmiOpOut.getColumn(4));
-                            Operation::Type opType = Operation::Types.fromString(stmtEmiOpOut.getColumn(5));
+                            const std::int64_t perfOutId = stmtEmiOpOut.getColumn(0).getInt64();
 
-                            const double fuel = stmtEmiOpOut.getColumn(6);
-                            const double hc = stmtEmiOpOut.getColumn(7);
-                            const double co = stmtEmiOpOut.getColumn(8);
-                            const double nox = stmtEmiOpOut.getColumn(9);
-                            const double nvpm = stmtEmiOpOut.getColumn(10);
-                            const double nvpmNumber = stmtEmiOpOut.getColumn(11);
+                            const double fuel = stmtEmiOpOut.getColumn(1);
+                            const double hc = stmtEmiOpOut.getColumn(2);
+                            const double co = stmtEmiOpOut.getColumn(3);
+                            const double nox = stmtEmiOpOut.getColumn(4);
+                            const double nvpm = stmtEmiOpOut.getColumn(5);
+                            const double nvpmNumber = stmtEmiOpOut.getColumn(6);
 
                             EmissionsOperationOutput opOut;
                             opOut.setTotals(fuel, EmissionValues(hc, co, nox, nvpm, nvpmNumber));
 
-                            const Operation* studyOp = nullptr;
-                            switch (op)
-                            {
-                            case OperationType::Arrival:
-                                {
-                                    switch (opType)
-                                    {
-                                    case Operation::Type::Flight: studyOp = &m_Operations.flightArrivals().at(opId);
-                                        break;
-                                    case Operation::Type::Track4d: studyOp = &m_Operations.track4dArrivals().at(opId);
-                                        break;
-                                    default: GRAPE_ASSERT(false);
-                                    }
-                                    break;
-                                }
-                            case OperationType::Departure:
-                                {
-                                    switch (opType)
-                                    {
-                                    case Operation::Type::Flight: studyOp = &m_Operations.flightDepartures().at(opId);
-                                        break;
-                                    case Operation::Type::Track4d: studyOp = &m_Operations.track4dDepartures().at(opId);
-                                        break;
-                                    default: GRAPE_ASSERT(false);
-                                    }
-                                    break;
-                                }
-                            default: GRAPE_ASSERT(false);
-                            }
+                            GRAPE_ASSERT(perfOutputOps.contains(perfOutId));
+                            const Operation* studyOp = perfOutputOps.at(perfOutId);
                             emiRun.output().m_OperationOutputs.add(studyOp, opOut);
 
                             stmtEmiOpOut.step();
@@ -1249,4 +1423,45 @@ namespace GRAPE {
             stmtScen.step();
         }
     }
+
+    TEST_CASE("Erase Operation From Finished Performance Run") {
+        const auto path = std::filesystem::temp_directory_path() / "GRAPE_EraseOperationTest.grp";
+        {
+            Study study;
+            REQUIRE(study.create(path));
+
+            auto& acft = study.Aircrafts.addAircraftE("Aircraft");
+            const auto& arr = study.Operations.addArrivalTrack4dE("Arrival", acft);
+            const auto& dep = study.Operations.addDepartureTrack4dE("Departure", acft);
+            auto& scen = study.Scenarios.addScenarioE("Scenario");
+            study.Scenarios.addTrack4dArrival(scen, arr);
+            study.Scenarios.addTrack4dDeparture(scen, dep);
+            auto& perfRun = study.Scenarios.addPerformanceRunE(scen, "Performance Run");
+
+            // Finished performance run, the outputs are saved directly without the writer thread
+            study.Blocks.performanceRunBlock(perfRun);
+            for (const Operation* op : { static_cast<const Operation*>(&arr), static_cast<const Operation*>(&dep) })
+            {
+                PerformanceOutput perfOut;
+                perfOut.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::Approach, 0.0, 0.0, 0.0, 100.0, 80.0, 80.0, 50000.0, 0.0, 0.0);
+                perfOut.addPoint(PerformanceOutput::PointOrigin::Track4d, FlightPhase::Approach, 1000.0, 0.0, 0.01, 150.0, 80.0, 80.0, 50000.0, 0.0, 0.0);
+                if (op == &arr)
+                    perfRun.output().addArrivalOutput(arr, std::move(perfOut));
+                else
+                    perfRun.output().addDepartureOutput(dep, std::move(perfOut));
+            }
+            perfRun.job()->setFinished();
+            REQUIRE(study.Scenarios.operationsEditable(scen));
+
+            CHECK(study.Scenarios.eraseTrack4dArrival(scen, arr));
+            CHECK_FALSE(perfRun.output().containsArrival(arr));
+            CHECK(perfRun.output().containsDeparture(dep));
+            CHECK(perfRun.output().departureOutput(dep)->size() == 2);
+
+            CHECK(study.Scenarios.eraseTrack4dDeparture(scen, dep));
+            CHECK(perfRun.output().empty());
+        }
+        std::filesystem::remove(path);
+        std::filesystem::remove(std::filesystem::path(path).replace_extension(".grpout"));
+    }
 }
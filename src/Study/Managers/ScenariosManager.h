@@ -7,12 +7,14 @@
 #include "Scenario/Scenario.h"
 
 namespace GRAPE {
+    class Doc29NoiseManager;
+    class Doc29PerformanceManager;
     class JobManager;
     class OperationsManager;
 
     class ScenariosManager : public Manager {
     public:
-        ScenariosManager(const Database& Db, Constraints& Blocks, OperationsManager& Ops, JobManager& Jobs);
+        ScenariosManager(const Database& Db, Constraints& Blocks, Doc29PerformanceManager& Doc29Acfts, Doc29NoiseManager& Doc29Ns, OperationsManager& Ops, JobManager& Jobs);
         auto& scenarios() { return m_Scenarios; }
         auto& operator()() { return m_Scenarios; }
         const Scenario& operator()(const std::string& ScenId) { return m_Scenarios(ScenId); }
@@ -68,9 +70,22 @@ namespace GRAPE {
         void eraseFlights(Scenario& Scen) const;
         void eraseTracks4d(Scenario& Scen) const;
 
+        /**
+        * @return True if operations can be added to or removed from Scen. Finished runs are then outdated instead of reset.
+        */
+        [[nodiscard]] bool operationsEditable(const Scenario& Scen) const;
+
         void loadFromFile();
 
     private:
+        template<typename OpT>
+        void addToRuns(const Scenario& Scen, const OpT& Op) const;
+        template<typename OpT>
+        void eraseFromRuns(const Scenario& Scen, const OpT& Op) const;
+        void saveOperationChanges(const Scenario& Scen) const;
+    private:
+        Doc29PerformanceManager& m_Doc29Aircrafts;
+        Doc29NoiseManager& m_Doc29Noises;
         OperationsManager& m_Operations;
         JobManager& m_Jobs;
 
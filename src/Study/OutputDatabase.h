@@ -0,0 +1,61 @@
+#pragma once
+
+namespace GRAPE::Schema::Output {
+    // Name under which the output database is attached to the study database
+    constexpr std::string_view g_name = "output";
+
+    // Foreign keys can't reference tables in other databases, these triggers delete and rename the outputs with the runs of the study database
+    constexpr std::string_view g_triggers = R"(
+CREATE TEMP TRIGGER IF NOT EXISTS output_performance_run_delete AFTER DELETE ON main.performance_run
+BEGIN
+    DELETE FROM performance_run_output WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.id;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_performance_run_update AFTER UPDATE OF scenario_id, id ON main.performance_run
+BEGIN
+    UPDATE performance_run_output SET scenario_id = NEW.scenario_id, performance_run_id = NEW.id WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.id;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_noise_run_delete AFTER DELETE ON main.noise_run
+BEGIN
+    DELETE FROM noise_run_output WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND noise_run_id = OLD.id;
+    DELETE FROM noise_run_output_receptors WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND noise_run_id = OLD.id;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_noise_run_update AFTER UPDATE OF scenario_id, performance_run_id, id ON main.noise_run
+BEGIN
+    UPDATE noise_run_output SET scenario_id = NEW.scenario_id, performance_run_id = NEW.performance_run_id, noise_run_id = NEW.id WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND noise_run_id = OLD.id;
+    UPDATE noise_run_output_receptors SET scenario_id = NEW.scenario_id, performance_run_id = NEW.performance_run_id, noise_run_id = NEW.id WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND noise_run_id = OLD.id;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_noise_run_cumulative_metrics_delete AFTER DELETE ON main.noise_run_cumulative_metrics
+BEGIN
+    DELETE FROM noise_run_output_cumulative WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND noise_run_id = OLD.noise_run_id AND noise_run_cumulative_metric_id = OLD.id;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_noise_run_cumulative_metrics_update AFTER UPDATE OF scenario_id, performance_run_id, noise_run_id, id ON main.noise_run_cumulative_metrics
+BEGIN
+    UPDATE noise_run_output_cumulative SET scenario_id = NEW.scenario_id, performance_run_id = NEW.performance_run_id, noise_run_id = NEW.noise_run_id, noise_run_cumulative_metric_id = NEW.id WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND noise_run_id = OLD.noise_run_id AND noise_run_cumulative_metric_id = OLD.id;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_noise_run_cumulative_metrics_number_above_thresholds_delete AFTER DELETE ON main.noise_run_cumulative_metrics_number_above_thresholds
+BEGIN
+    DELETE FROM noise_run_output_cumulative_number_above WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND noise_run_id = OLD.noise_run_id AND noise_run_cumulative_metric_id = OLD.noise_run_cumulative_metric_id AND threshold_db = OLD.threshold;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_noise_run_cumulative_metrics_number_above_thresholds_update AFTER UPDATE OF scenario_id, performance_run_id, noise_run_id, noise_run_cumulative_metric_id, threshold ON main.noise_run_cumulative_metrics_number_above_thresholds
+BEGIN
+    UPDATE noise_run_output_cumulative_number_above SET scenario_id = NEW.scenario_id, performance_run_id = NEW.performance_run_id, noise_run_id = NEW.noise_run_id, noise_run_cumulative_metric_id = NEW.noise_run_cumulative_metric_id, threshold_db = NEW.threshold WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND noise_run_id = OLD.noise_run_id AND noise_run_cumulative_metric_id = OLD.noise_run_cumulative_metric_id AND threshold_db = OLD.threshold;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_emissions_run_delete AFTER DELETE ON main.emissions_run
+BEGIN
+    DELETE FROM emissions_run_output WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND emissions_run_id = OLD.id;
+END;
+
+CREATE TEMP TRIGGER IF NOT EXISTS output_emissions_run_update AFTER UPDATE OF scenario_id, performance_run_id, id ON main.emissions_run
+BEGIN
+    UPDATE emissions_run_output SET scenario_id = NEW.scenario_id, performance_run_id = NEW.performance_run_id, emissions_run_id = NEW.id WHERE scenario_id = OLD.scenario_id AND performance_run_id = OLD.performance_run_id AND emissions_run_id = OLD.id;
+END;
+)";
+}
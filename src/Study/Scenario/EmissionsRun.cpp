@@ -30,6 +30,12 @@ namespace GRAPE {
         // Performance output needed for all models except LTO Cycle
         if (EmissionsRunSpec.EmissionsMdl != EmissionsModel::LTOCycle)
         {
+            if (parentPerformanceRun().job()->finished() && !parentPerformanceRun().output().pointsSaved())
+            {
+                log("Performance output points were not saved, start the emissions run while the performance run is running.");
+                valid = false;
+            }
+
             if (parentScenario().flightsSize() != 0 && parentPerformanceRun().PerfRunSpec.FlightsPerformanceMdl == PerformanceModel::None)
             {
                 log(std::format("Emissions model '{}' can't be applied for Flights performance model '{}'.", EmissionsModelTypes.toString(EmissionsRunSpec.EmissionsMdl), PerformanceModelTypes.toString(PerformanceModel::None)));
@@ -243,8 +249,7 @@ namespace GRAPE {
     const std::shared_ptr<EmissionsRunJob>& EmissionsRun::createJob(const Database& Db, Constraints& Blocks) {
         m_EmissionsRunOutput = std::make_unique<EmissionsRunOutput>(*this, Db);
 
-        std::size_t threadCount = static_cast<std::size_t>(std::thread::hardware_concurrency());
-        m_Job = std::make_shared<EmissionsRunJob>(Blocks, *this, threadCount);
+        m_Job = std::make_shared<EmissionsRunJob>(Blocks, *this);
 
         return m_Job;
     }
@@ -5,6 +5,7 @@
 #include "EmissionsRunOutput.h"
 
 #include "Schema/Schema.h"
+#include "Schema/SchemaOutput.h"
 #include "Scenario.h"
 
 namespace GRAPE {
@@ -35,7 +36,7 @@ namespace GRAPE {
     void EmissionsRunOutput::createOutput() const {
         std::scoped_lock lck(m_Mutex);
 
-        m_Db.insert(Schema::emissions_run_output, {}, std::make_tuple(
+        m_Db.insert(Schema::emissions_run_output, { 1, 2, 3, 4, 5, 6, 7, 8, 9 }, std::make_tuple(
             parentScenario().Name,
             parentPerformanceRun().Name,
             parentEmissionsRun().Name,
@@ -46,6 +47,7 @@ namespace GRAPE {
             0.0, // nvpm
             0.0 // nvpm Number
         ));
+        m_OutputId = m_Db.lastInsertRowId();
     }
 
     void EmissionsRunOutput::addOperationOutput(const Operation& Op, const EmissionsOperationOutput& EmissionsOpOut, bool SaveSegments) {
@@ -68,7 +70,7 @@ namespace GRAPE {
         m_TotalEmissions += EmissionsOpOut.totalEmissions();
 
         // Totals in DB
-        m_Db.update(Schema::emissions_run_output, { 3, 4, 5, 6, 7, 8 }, std::make_tuple(m_TotalFuel, m_TotalEmissions.HC, m_TotalEmissions.CO, m_TotalEmissions.NOx, m_TotalEmissions.nvPM, m_TotalEmissions.nvPMNumber), { 0, 1, 2 }, std::make_tuple(parentScenario().Name, parentPerformanceRun().Name, parentEmissionsRun().Name));
+        m_Db.update(Schema::emissions_run_output, { 4, 5, 6, 7, 8, 9 }, std::make_tuple(m_TotalFuel, m_TotalEmissions.HC, m_TotalEmissions.CO, m_TotalEmissions.NOx, m_TotalEmissions.nvPM, m_TotalEmissions.nvPMNumber), { 0 }, std::make_tuple(m_OutputId));
     }
 
     void EmissionsRunOutput::clear() {
@@ -80,20 +82,17 @@ namespace GRAPE {
         m_TotalFuel = 0.0;
         m_TotalEmissions = EmissionValues();
         m_OperationOutputs.clear();
+        m_OutputId = 0;
         m_Db.beginTransaction();
-        m_Db.deleteD(Schema::emissions_run_output, { 0, 1, 2 }, std::make_tuple(parentScenario().Name, parentPerformanceRun().Name, parentEmissionsRun().Name));
+        m_Db.deleteD(Schema::emissions_run_output, { 1, 2, 3 }, std::make_tuple(parentScenario().Name, parentPerformanceRun().Name, parentEmissionsRun().Name));
         m_Db.commitTransaction();
     }
 
     void EmissionsRunOutput::saveOperation(const Operation& Op, const EmissionsOperationOutput& EmissionsOpOut) const {
         m_Db.beginTransaction();
         m_Db.insert(Schema::emissions_run_output_operations, {}, std::make_tuple(
-            parentScenario().Name,
-            parentPerformanceRun().Name,
-            parentEmissionsRun().Name,
-            Op.Name,
-            OperationTypes.toString(Op.operationType()),
-            Operation::Types.toString(Op.type()),
+            m_OutputId,
+            parentPerformanceRun().output().outputId(Op),
             EmissionsOpOut.totalFuel(), // fuel
             EmissionsOpOut.totalEmissions().HC,
             EmissionsOpOut.totalEmissions().CO,
@@ -105,16 +104,14 @@ namespace GRAPE {
     }
 
     void EmissionsRunOutput::saveSegments(const Operation& Op, const EmissionsOperationOutput& EmissionsOpOut) const {
+        const std::int64_t perfOutId = parentPerformanceRun().output().outputId(Op);
+
         m_Db.beginTransaction();
         for (const auto& segOut : EmissionsOpOut.segmentOutput())
         {
             m_Db.insert(Schema::emissions_run_output_segments, {}, std::make_tuple(
-                parentScenario().Name,
-                parentPerformanceRun().Name,
-                parentEmissionsRun().Name,
-                Op.Name,
-                OperationTypes.toString(Op.operationType()),
-                Operation::Types.toString(Op.type()),
+                m_OutputId,
+                perfOutId,
                 static_cast<int>(segOut.Index),
                 segOut.Fuel,
                 segOut.Emissions.HC,
@@ -130,10 +127,10 @@ namespace GRAPE {
     const EmissionsOperationOutput EmissionsRunOutput::loadSegments(const Operation& Op) const {
         EmissionsOperationOutput emiOpOut;
 
-        m_Db.beginTransaction();
+        const auto rd = m_Db.reader();
 
-        Statement stmt(m_Db, Schema::emissions_run_output_segments.querySelect({ 6, 7, 8, 9, 10, 11, 12 }, { 0, 1, 2, 3, 4, 5 }));
-        stmt.bindValues(m_EmissionsRun.parentScenario().Name, m_EmissionsRun.parentPerformanceRun().Name, m_EmissionsRun.Name, Op.Name, OperationTypes.toString(Op.operationType()), Operation::Types.toString(Op.type()));
+        Statement stmt(*rd, Schema::emissions_run_output_segments.querySelect({ 2, 3, 4, 5, 6, 7, 8 }, { 0, 1 }));
+        stmt.bindValues(m_OutputId, parentPerformanceRun().output().outputId(Op));
         stmt.step();
         while (stmt.hasRow())
         {
@@ -144,7 +141,6 @@ namespace GRAPE {
             emiOpOut.addSegmentOutput(segOut);
             stmt.step();
         }
-        m_Db.commitTransaction();
 
         return emiOpOut;
     }
@@ -48,6 +48,9 @@ namespace GRAPE {
         EmissionValues m_TotalEmissions;
         GrapeMap<const Operation*, EmissionsOperationOutput> m_OperationOutputs;
 
+        // Id of the output in the database, referenced by the operation and segment outputs. Set by createOutput() or when loaded.
+        mutable std::int64_t m_OutputId = 0;
+
         Database m_Db;
         mutable std::mutex m_Mutex;
     private:
@@ -199,6 +199,12 @@ namespace GRAPE {
             valid = false;
         }
 
+        if (parentPerformanceRun().job()->finished() && !parentPerformanceRun().output().pointsSaved())
+        {
+            Log::dataLogic()->error("Running noise run '{}' of performance run '{}' of scenario '{}'. Performance output points were not saved, start the noise run while the performance run is running.", Name, parentPerformanceRun().Name, parentScenario().Name);
+            valid = false;
+        }
+
         if (NsRunSpec.ReceptSet->empty())
         {
             Log::dataLogic()->error("Running noise run '{}' of performance run '{}' of scenario '{}'. Receptor set generates no receptors.", Name, parentPerformanceRun().Name, parentScenario().Name);
@@ -210,60 +216,36 @@ namespace GRAPE {
         {
             for (auto flight : parentScenario().FlightArrivals)
             {
-                auto& acft = flight.get().aircraft();
-                if (!acft.Doc29Ns)
+                if (!flight.get().aircraft().Doc29Ns)
                 {
-                    log(std::format("Arrival flight '{}' with aircraft '{}' has no Doc29 noise entry selected.", flight.get().Name, acft.Name));
-                    valid = false;
-                }
-                else if (!acft.Doc29Ns->validArrival())
-                {
-                    log(std::format("Arrival flight '{}' with aircraft '{}' and Doc29 noise entry '{}' has invalid NPD data.", flight.get().Name, acft.Name, acft.Doc29Ns->Name));
+                    log(std::format("Arrival flight '{}' with aircraft '{}' has no Doc29 noise entry selected.", flight.get().Name, flight.get().aircraft().Name));
                     valid = false;
                 }
             }
 
             for (auto flight : parentScenario().FlightDepartures)
             {
-                auto& acft = flight.get().aircraft();
-                if (!acft.Doc29Ns)
+                if (!flight.get().aircraft().Doc29Ns)
                 {
                     log(std::format("Departure flight '{}' with aircraft '{}' has no Doc29 noise entry selected.", flight.get().Name, flight.get().aircraft().Name));
                     valid = false;
                 }
-                else if (!acft.Doc29Ns->validDeparture())
-                {
-                    log(std::format("Departure flight '{}' with aircraft '{}' and Doc29 noise entry '{}' has invalid NPD data.", flight.get().Name, acft.Name, acft.Doc29Ns->Name));
-                    valid = false;
-                }
             }
 
             for (auto track4d : parentScenario().Track4dArrivals)
             {
-                auto& acft = track4d.get().aircraft();
-                if (!acft.Doc29Ns)
-                {
-                    log(std::format("Arrival track 4D '{}' with aircraft '{}' has no Doc29 noise entry selected.", track4d.get().Name, acft.Name));
-                    valid = false;
-                }
-                else if (!acft.Doc29Ns->validArrival())
+                if (!track4d.get().aircraft().Doc29Ns)
                 {
-                    log(std::format("Arrival track 4D '{}' with aircraft '{}' and Doc29 noise entry '{}' has invalid NPD data.", track4d.get().Name, acft.Name, acft.Doc29Ns->Name));
+                    log(std::format("Arrival track 4D '{}' with aircraft '{}' has no Doc29 noise entry selected.", track4d.get().Name, track4d.get().aircraft().Name));
                     valid = false;
                 }
             }
 
-            for (auto track4d : parentScenario().FlightDepartures)
+            for (auto track4d : parentScenario().Track4dDepartures)
             {
-                auto& acft = track4d.get().aircraft();
-                if (!acft.Doc29Ns)
-                {
-                    log(std::format("Departure track 4D '{}' with aircraft '{}' has no Doc29 noise entry selected.", track4d.get().Name, acft.Name));
-                    valid = false;
-                }
-                else if (!acft.Doc29Ns->validDeparture())
+                if (!track4d.get().aircraft().Doc29Ns)
                 {
-                    log(std::format("Departure track 4D '{}' with aircraft '{}' and Doc29 noise entry '{}' has invalid NPD data.", track4d.get().Name, acft.Name, acft.Doc29Ns->Name));
+                    log(std::format("Departure track 4D '{}' with aircraft '{}' has no Doc29 noise entry selected.", track4d.get().Name, track4d.get().aircraft().Name));
                     valid = false;
                 }
             }
@@ -271,6 +253,55 @@ namespace GRAPE {
         return valid;
     }
 
+    bool NoiseRun::validNpd() const {
+        if (NsRunSpec.NoiseMdl != NoiseModel::Doc29)
+            return true;
+
+        bool valid = true;
+        const std::function log = [&](const std::string& Err) { Log::dataLogic()->error("Running noise run '{}' of performance run '{}' of scenario '{}' with Doc29 noise model. {}", Name, parentPerformanceRun().Name, parentScenario().Name, Err); };
+
+        for (auto flight : parentScenario().FlightArrivals)
+        {
+            auto& acft = flight.get().aircraft();
+            if (acft.Doc29Ns && !acft.Doc29Ns->validArrival())
+            {
+                log(std::format("Arrival flight '{}' with aircraft '{}' and Doc29 noise entry '{}' has invalid NPD data.", flight.get().Name, acft.Name, acft.Doc29Ns->Name));
+                valid = false;
+            }
+        }
+
+        for (auto flight : parentScenario().FlightDepartures)
+        {
+            auto& acft = flight.get().aircraft();
+            if (acft.Doc29Ns && !acft.Doc29Ns->validDeparture())
+            {
+                log(std::format("Departure flight '{}' with aircraft '{}' and Doc29 noise entry '{}' has invalid NPD data.", flight.get().Name, acft.Name, acft.Doc29Ns->Name));
+                valid = false;
+            }
+        }
+
+        for (auto track4d : parentScenario().Track4dArrivals)
+        {
+            auto& acft = track4d.get().aircraft();
+            if (acft.Doc29Ns && !acft.Doc29Ns->validArrival())
+            {
+                log(std::format("Arrival track 4D '{}' with aircraft '{}' and Doc29 noise entry '{}' has invalid NPD data.", track4d.get().Name, acft.Name, acft.Doc29Ns->Name));
+                valid = false;
+            }
+        }
+
+        for (auto track4d : parentScenario().Track4dDepartures)
+        {
+            auto& acft = track4d.get().aircraft();
+            if (acft.Doc29Ns && !acft.Doc29Ns->validDeparture())
+            {
+                log(std::format("Departure track 4D '{}' with aircraft '{}' and Doc29 noise entry '{}' has invalid NPD data.", track4d.get().Name, acft.Name, acft.Doc29Ns->Name));
+                valid = false;
+            }
+        }
+        return valid;
+    }
+
     bool NoiseRun::skipOperation(const Operation& Op) const {
         if (Op.Count < Constants::Precision)
             return true;
@@ -279,11 +310,10 @@ namespace GRAPE {
             [&](const NoiseCumulativeMetric& CumMetric) { return Op.Time >= CumMetric.StartTimePoint && Op.Time <= CumMetric.EndTimePoint && CumMetric.weight(Op.timeOfDay()) < Constants::Precision; });
     }
 
-    const std::shared_ptr<NoiseRunJob>& NoiseRun::createJob(const Database& Db, Constraints& Blocks) {
+    const std::shared_ptr<NoiseRunJob>& NoiseRun::createJob(const Database& Db, Constraints& Blocks, Doc29NoiseManager& Doc29Noises) {
         m_NoiseRunOutput = std::make_unique<NoiseRunOutput>(*this, Db);
 
-        std::size_t threadCount = static_cast<std::size_t>(std::thread::hardware_concurrency());
-        m_Job = std::make_shared<NoiseRunJob>(Blocks, *this, threadCount);
+        m_Job = std::make_shared<NoiseRunJob>(Blocks, Doc29Noises, *this);
 
         return m_Job;
     }
@@ -9,6 +9,7 @@
 namespace GRAPE {
     class Constraints;
     class Database;
+    class Doc29NoiseManager;
     class NoiseRun;
     class PerformanceRun;
     class Scenario;
@@ -94,12 +95,17 @@ namespace GRAPE {
 
         // Status Checks
         [[nodiscard]] bool valid() const;
+
+        /**
+        * @return True if the Doc29 noise entries of all operations have valid NPD data. The NPD data must be loaded, checked separately from valid() as it is loaded in the background by the job.
+        */
+        [[nodiscard]] bool validNpd() const;
         [[nodiscard]] bool skipOperation(const Operation& Op) const;
 
         // Job
         friend class NoiseRunJob;
         [[nodiscard]] const auto& job() const { return m_Job; }
-        const std::shared_ptr<NoiseRunJob>& createJob(const Database& Db, Constraints& Blocks);
+        const std::shared_ptr<NoiseRunJob>& createJob(const Database& Db, Constraints& Blocks, Doc29NoiseManager& Doc29Noises);
 
         // Output
         [[nodiscard]] auto& output() const { return *m_NoiseRunOutput; }
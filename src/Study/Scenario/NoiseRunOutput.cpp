@@ -5,9 +5,16 @@
 #include "NoiseRunOutput.h"
 
 #include "Schema/Schema.h"
+#include "Schema/SchemaOutput.h"
 #include "Scenario.h"
 
 namespace GRAPE {
+    namespace {
+        std::size_t memorySize(const NoiseSingleEventOutput& NsOut) {
+            return sizeof(NoiseSingleEventOutput) + NsOut.size() * 2 * sizeof(double);
+        }
+    }
+
     NoiseRunOutput::NoiseRunOutput(const NoiseRun& NsRun, const Database& Db) : m_NoiseRun(NsRun), m_Db(Db) {}
 
     const NoiseRun& NoiseRunOutput::parentNoiseRun() const {
@@ -43,45 +50,203 @@ namespace GRAPE {
     void NoiseRunOutput::setReceptorOutput(ReceptorOutput&& ReceptOutput) {
         std::scoped_lock lck(m_DbMutex);
         m_ReceptorOutput = std::move(ReceptOutput);
+        updateStorageOrder();
         saveReceptorOutput();
     }
 
     void NoiseRunOutput::addSingleEvent(const Operation& Op, const NoiseSingleEventOutput& NsOut) const {
         GRAPE_ASSERT(NsOut.size() == m_ReceptorOutput.size());
+
+        SingleEventRow row;
+        row.PerfOutputId = parentPerformanceRun().output().outputId(Op);
+        row.LamaxBlob.reserve(storageOrder().size() * sizeof(float));
+        row.SelBlob.reserve(storageOrder().size() * sizeof(float));
+        for (const std::size_t i : storageOrder())
+        {
+            auto& [lamax, sel] = NsOut.values(i);
+            row.LamaxBlob.add(static_cast<float>(lamax));
+            row.SelBlob.add(static_cast<float>(sel));
+        }
+
         std::scoped_lock lck(m_DbMutex);
-        saveSingleEvent(Op, NsOut);
+        m_SingleEventQueue.emplace_back(std::move(row));
+        if (m_SingleEventQueue.size() >= s_SingleEventBatchSize)
+            saveSingleEventQueue();
     }
 
-    void NoiseRunOutput::startCumulative() {
-        std::scoped_lock lck(m_CumOutMutex);
-        for (const auto& metric : parentNoiseRun().CumulativeMetrics | std::views::values)
+    void NoiseRunOutput::saveSingleEvents() const {
+        std::scoped_lock lck(m_DbMutex);
+        saveSingleEventQueue();
+    }
+
+    void NoiseRunOutput::startCumulative(const std::vector<const Operation*>& Ops, std::size_t ShardCount) {
+        GRAPE_ASSERT(ShardCount > 0);
+        m_CumulativeIndexes.clear();
+        for (std::size_t i = 0; i < Ops.size(); ++i)
+            m_CumulativeIndexes.emplace(Ops.at(i), i);
+
+        m_CumulativeShards.clear();
+        for (std::size_t i = 0; i < ShardCount; ++i)
         {
-            auto [nsCumOut, added] = m_CumulativeOutputs.add(&metric, m_ReceptorOutput.size(), metric.numberAboveThresholds().size());
-            GRAPE_ASSERT(added);
+            auto& shard = m_CumulativeShards.emplace_back(std::make_unique<CumulativeShard>());
+            shard->NextIndex = i;
+            for (const auto& metric : parentNoiseRun().CumulativeMetrics | std::views::values)
+            {
+                auto [nsCumOut, added] = shard->Outputs.add(&metric, m_ReceptorOutput.size(), metric.numberAboveThresholds().size());
+                GRAPE_ASSERT(added);
+            }
         }
     }
 
-    void NoiseRunOutput::accumulate(const Operation& Op, const NoiseSingleEventOutput& NsOut) {
-        std::scoped_lock lck(m_CumOutMutex);
-        for (const auto& metric : parentNoiseRun().CumulativeMetrics | std::views::values)
+    void NoiseRunOutput::accumulate(const Operation& Op, const std::shared_ptr<const NoiseSingleEventOutput>& NsOut) {
+        GRAPE_ASSERT(!m_CumulativeShards.empty());
+
+        if (parentNoiseRun().skipOperation(Op))
+            return;
+
+        // Energy conversion outside the lock and shared by all metrics
+        accumulate(Op, NsOut, NoiseSingleEventEnergy(*NsOut));
+    }
+
+    void NoiseRunOutput::accumulate(const Operation& Op, const std::shared_ptr<const NoiseSingleEventOutput>& NsOut, const NoiseSingleEventEnergy& NsEnergy) {
+        GRAPE_ASSERT(!m_CumulativeShards.empty());
+
+        if (parentNoiseRun().skipOperation(Op))
+            return;
+
+        keep(Op, NsOut);
+
+        GRAPE_ASSERT(m_CumulativeIndexes.contains(&Op), "Operation '{2}' not passed to startCumulative().", Op.Name);
+        const std::size_t index = m_CumulativeIndexes.at(&Op);
+        auto& shard = *m_CumulativeShards.at(index % m_CumulativeShards.size());
+        std::scoped_lock lck(shard.Mutex);
+
+        // Held until the operations before it in the same shard are accumulated, the energy is converted again when accumulated
+        if (index != shard.NextIndex)
         {
-            if (parentNoiseRun().skipOperation(Op))
-                continue;
+            shard.Pending.emplace(index, std::make_pair(&Op, NsOut));
+            return;
+        }
+
+        accumulateShard(shard, Op, *NsOut, NsEnergy);
+        accumulatePending(shard, false);
+    }
 
-            m_CumulativeOutputs.at(&metric).accumulateSingleEventOutput(NsOut, Op.Count, metric.weight(Op.timeOfDay()), metric.Threshold, metric.numberAboveThresholds());
+    void NoiseRunOutput::accumulateShard(CumulativeShard& Shard, const Operation& Op, const NoiseSingleEventOutput& NsOut, const NoiseSingleEventEnergy& NsEnergy) const {
+        for (const auto& metric : parentNoiseRun().CumulativeMetrics | std::views::values)
+            Shard.Outputs.at(&metric).accumulateSingleEventOutput(NsOut, NsEnergy, Op.Count, metric.weight(Op.timeOfDay()), metric.Threshold, metric.numberAboveThresholds());
+        Shard.NextIndex += m_CumulativeShards.size();
+    }
+
+    /**
+    * If Drain is false, only the pending operations which are next in order are accumulated.
+    * If Drain is true, all pending operations are accumulated in order, skipping the operations which were never accumulated (e.g. their performance output failed).
+    */
+    void NoiseRunOutput::accumulatePending(CumulativeShard& Shard, bool Drain) const {
+        while (!Shard.Pending.empty() && (Drain || Shard.Pending.begin()->first == Shard.NextIndex))
+        {
+            auto node = Shard.Pending.extract(Shard.Pending.begin());
+            const auto& [op, nsOut] = node.mapped();
+            Shard.NextIndex = node.key();
+            accumulateShard(Shard, *op, *nsOut, NoiseSingleEventEnergy(*nsOut));
         }
     }
 
+    /**
+    * The shards are merged into the linear sums, which are kept. The cumulative outputs are finished from a copy of the sums.
+    * If operations were removed, MaximumAbsolute is recalculated from the kept single event outputs before merging the shards.
+    */
     void NoiseRunOutput::finishCumulative() {
+        for (const auto& shard : m_CumulativeShards)
+            accumulatePending(*shard, true);
+
+        m_CumulativeOutputs.clear();
+        for (const auto& metric : parentNoiseRun().CumulativeMetrics | std::views::values)
         {
-            std::scoped_lock lck(m_CumOutMutex);
-            for (const auto& metric : parentNoiseRun().CumulativeMetrics | std::views::values)
-                m_CumulativeOutputs.at(&metric).finishAccumulation(metric.AveragingTimeConstant);
+            auto [cumSums, added] = m_CumulativeSums.add(&metric, m_ReceptorOutput.size(), metric.numberAboveThresholds().size());
+
+            if (m_MaximumAbsoluteOutdated)
+            {
+                std::ranges::fill(cumSums.MaximumAbsolute, 0.0);
+                for (const auto& [op, nsOut] : m_Contributions)
+                    cumSums.accumulateMaximumAbsolute(*nsOut, op->Count, metric.weight(op->timeOfDay()), metric.Threshold);
+            }
+
+            // Fixed reduction order, each shard holds the same operations summed in the same order in every run
+            for (const auto& shard : m_CumulativeShards)
+                cumSums.merge(shard->Outputs.at(&metric));
+
+            auto [cumOut, cumOutAdded] = m_CumulativeOutputs.add(&metric, cumSums);
+            GRAPE_ASSERT(cumOutAdded);
+            cumOut.finishAccumulation(metric.AveragingTimeConstant);
         }
+        m_CumulativeShards.clear();
+        m_CumulativeIndexes.clear();
+        m_MaximumAbsoluteOutdated = false;
+
+        m_Updatable = m_KeepContributions;
+        if (!m_Updatable)
+            releaseContributions();
+
+        std::scoped_lock lck(m_DbMutex);
+        saveCumulative();
+    }
+
+    bool NoiseRunOutput::removeOperation(const Operation& Op) {
+        if (!updatable())
+            return false;
+
+        const auto it = m_Contributions.find(&Op);
+        if (it == m_Contributions.end())
+            return true; // Skipped operation
+
+        const auto nsOut = it->second;
+        const NoiseSingleEventEnergy nsEnergy(*nsOut);
+        for (const auto& metric : parentNoiseRun().CumulativeMetrics | std::views::values)
+            m_CumulativeSums.at(&metric).removeSingleEventOutput(*nsOut, nsEnergy, Op.Count, metric.weight(Op.timeOfDay()), metric.Threshold, metric.numberAboveThresholds());
+        m_MaximumAbsoluteOutdated = true;
+
+        m_Contributions.erase(it);
+        auto& uses = m_ContributionUses.at(nsOut.get());
+        if (--uses == 0)
         {
-            std::scoped_lock lck(m_DbMutex);
-            saveCumulative();
+            m_ContributionUses.erase(nsOut.get());
+            m_ContributionsSize -= memorySize(*nsOut);
         }
+
+        // The output id is read now, the performance run output of Op is erased before the changes are saved
+        m_RemovedOutputIds.emplace_back(parentPerformanceRun().output().outputId(Op));
+        m_CumulativeInvalidated = true;
+
+        return true;
+    }
+
+    void NoiseRunOutput::invalidateCumulative() {
+        m_CumulativeInvalidated = true;
+    }
+
+    void NoiseRunOutput::saveOperationChanges() {
+        if (m_RemovedOutputIds.empty() && !m_CumulativeInvalidated)
+            return;
+
+        std::scoped_lock lck(m_DbMutex);
+        saveSingleEventQueue();
+        m_Db.beginTransaction();
+
+        std::vector<std::tuple<std::int64_t, std::int64_t>> singleEventRows;
+        singleEventRows.reserve(m_RemovedOutputIds.size());
+        for (const auto perfOutId : m_RemovedOutputIds)
+            singleEventRows.emplace_back(m_OutputId, perfOutId);
+        m_Db.deleteBulk(Schema::noise_run_output_single_event, { 0, 1 }, singleEventRows);
+
+        // Deleted once, whatever the number of operations changed
+        if (m_CumulativeInvalidated && m_CumulativeSaved)
+            deleteCumulative();
+
+        m_Db.commitTransaction();
+
+        m_RemovedOutputIds.clear();
+        m_CumulativeInvalidated = false;
     }
 
     void NoiseRunOutput::clear() {
@@ -91,38 +256,91 @@ namespace GRAPE {
             return;
 
         m_ReceptorOutput = ReceptorOutput();
+        m_StorageOrder.clear();
+        m_SingleEventQueue.clear();
         m_CumulativeOutputs.clear();
+        m_CumulativeShards.clear();
+        m_CumulativeIndexes.clear();
+        m_CumulativeSums.clear();
+        m_MaximumAbsoluteOutdated = false;
+        m_Updatable = false;
+        m_RemovedOutputIds.clear();
+        m_CumulativeInvalidated = false;
+        releaseContributions();
+        m_KeepContributions = true;
+
+        m_OutputId = 0;
 
         m_Db.beginTransaction();
-        m_Db.deleteD(Schema::noise_run_output_single_event, { 0, 1, 2 }, std::make_tuple(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name));
-        m_Db.deleteD(Schema::noise_run_output_cumulative, { 0, 1, 2 }, std::make_tuple(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name));
-        m_Db.deleteD(Schema::noise_run_output_cumulative_number_above, { 0, 1, 2 }, std::make_tuple(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name));
+        m_Db.deleteD(Schema::noise_run_output, { 1, 2, 3 }, std::make_tuple(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name)); // Cascades to the single event outputs
+        deleteCumulative();
         m_Db.deleteD(Schema::noise_run_output_receptors, { 0, 1, 2 }, std::make_tuple(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name));
         m_Db.commitTransaction();
     }
 
-    NoiseSingleEventOutput NoiseRunOutput::load(const Operation& Op) const {
-        NoiseSingleEventOutput out(m_ReceptorOutput.size());
+    void NoiseRunOutput::keep(const Operation& Op, const std::shared_ptr<const NoiseSingleEventOutput>& NsOut) {
+        std::scoped_lock lck(m_ContributionsMutex);
+        if (!m_KeepContributions)
+            return;
 
-        m_Db.beginTransaction();
+        const std::size_t budget = static_cast<std::size_t>(std::max(s_MemoryBudget, 0)) * 1024 * 1024;
+        auto& uses = m_ContributionUses[NsOut.get()];
+        if (uses == 0)
+            m_ContributionsSize += memorySize(*NsOut);
+        ++uses;
+        m_Contributions.emplace(&Op, NsOut);
+
+        // The outputs kept so far are still needed by finishCumulative()
+        if (m_ContributionsSize > budget)
+            m_KeepContributions = false;
+    }
+
+    void NoiseRunOutput::releaseContributions() {
+        m_Contributions.clear();
+        m_ContributionUses.clear();
+        m_ContributionsSize = 0;
+    }
+
+    void NoiseRunOutput::updateStorageOrder() {
+        // Binary comparison, same as the SQLite default collation
+        m_StorageOrder.resize(m_ReceptorOutput.size());
+        std::iota(m_StorageOrder.begin(), m_StorageOrder.end(), std::size_t{ 0 });
+        std::ranges::sort(m_StorageOrder, [&](std::size_t I, std::size_t J) { return m_ReceptorOutput(I).Name < m_ReceptorOutput(J).Name; });
+    }
+
+    NoiseSingleEventOutput NoiseRunOutput::load(const Operation& Op) const {
+        NoiseSingleEventOutput out;
 
-        Statement stmt(m_Db, Schema::noise_run_output_single_event.querySelect({ 7, 8 }, { 0, 1, 2, 4, 5, 6 }, { 3 }));
-        stmt.bindValues(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name, Op.Name, OperationTypes.toString(Op.operationType()), Operation::Types.toString(Op.type()));
+        const auto rd = m_Db.reader();
+        Statement stmt(*rd, Schema::noise_run_output_single_event.querySelect({ 2, 3 }, { 0, 1 }));
+        stmt.bindValues(m_OutputId, parentPerformanceRun().output().outputId(Op));
         stmt.step();
-        while (stmt.hasRow())
+        if (!stmt.hasRow())
+            return out;
+
+        // The float32 blobs are decoded in a single pass from the SQLite buffers into the double values of the output
+        const auto lamaxBytes = stmt.getColumn(0).getBlob();
+        const auto selBytes = stmt.getColumn(1).getBlob();
+        const auto& order = storageOrder();
+        GRAPE_ASSERT(lamaxBytes.size() == order.size() * sizeof(float) && selBytes.size() == order.size() * sizeof(float));
+
+        out.fill(order.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
         {
-            const double lamax = stmt.getColumn(0);
-            const double sel = stmt.getColumn(1);
-            out.addValues(lamax, sel);
-            stmt.step();
+            float lamax, sel;
+            std::memcpy(&lamax, lamaxBytes.data() + i * sizeof(float), sizeof(float));
+            std::memcpy(&sel, selBytes.data() + i * sizeof(float), sizeof(float));
+            out.setValues(order.at(i), lamax, sel);
         }
-        m_Db.commitTransaction();
 
         return out;
     }
 
     void NoiseRunOutput::saveReceptorOutput() const {
         m_Db.beginTransaction();
+        m_Db.insert(Schema::noise_run_output, { 1, 2, 3 }, std::make_tuple(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name));
+        m_OutputId = m_Db.lastInsertRowId();
+
         for (const auto& recept : m_ReceptorOutput)
         {
             m_Db.insert(Schema::noise_run_output_receptors, {}, std::make_tuple(
@@ -138,28 +356,30 @@ namespace GRAPE {
         m_Db.commitTransaction();
     }
 
-    void NoiseRunOutput::saveSingleEvent(const Operation& Op, const NoiseSingleEventOutput& NsOutput) const {
+    void NoiseRunOutput::saveSingleEventQueue() const {
+        if (m_SingleEventQueue.empty())
+            return;
+
         m_Db.beginTransaction();
-        for (std::size_t i = 0; i < NsOutput.size(); ++i)
+        for (const auto& row : m_SingleEventQueue)
         {
-            auto& [lamax, sel] = NsOutput.values(i);
             m_Db.insert(Schema::noise_run_output_single_event, {}, std::make_tuple(
-                m_NoiseRun.parentScenario().Name,
-                m_NoiseRun.parentPerformanceRun().Name,
-                m_NoiseRun.Name,
-                m_ReceptorOutput(i).Name,
-                Op.Name,
-                OperationTypes.toString(Op.operationType()),
-                Operation::Types.toString(Op.type()),
-                lamax,
-                sel)
+                m_OutputId,
+                row.PerfOutputId,
+                row.LamaxBlob,
+                row.SelBlob)
             );
         }
         m_Db.commitTransaction();
+        m_SingleEventQueue.clear();
     }
 
     void NoiseRunOutput::saveCumulative() const {
         m_Db.beginTransaction();
+
+        // Outputs of a previous run are replaced
+        deleteCumulative();
+
         for (const auto& [cumMetric, cumOutput] : m_CumulativeOutputs)
         {
             {
@@ -201,5 +421,12 @@ namespace GRAPE {
             }
         }
         m_Db.commitTransaction();
+        m_CumulativeSaved = true;
+    }
+
+    void NoiseRunOutput::deleteCumulative() const {
+        m_Db.deleteD(Schema::noise_run_output_cumulative, { 0, 1, 2 }, std::make_tuple(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name));
+        m_Db.deleteD(Schema::noise_run_output_cumulative_number_above, { 0, 1, 2 }, std::make_tuple(m_NoiseRun.parentScenario().Name, m_NoiseRun.parentPerformanceRun().Name, m_NoiseRun.Name));
+        m_CumulativeSaved = false;
     }
 }
@@ -2,6 +2,12 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #include "Database/Database.h"
 #include "Noise/NoiseCumulativeOutput.h"
 #include "Noise/NoiseSingleEventOutput.h"
@@ -18,6 +24,12 @@ namespace GRAPE {
     public:
         explicit NoiseRunOutput(const NoiseRun& NsRun, const Database& Db);
 
+        /**
+        * @brief Maximum memory in MiB used by each noise run to keep the single event outputs of its operations. The kept outputs allow operations to be removed from the cumulative outputs.
+        * If exceeded, removing an operation from the scenario resets the noise run.
+        */
+        inline static int s_MemoryBudget = 1024;
+
         // Access Data (Not Thread Safe)
         [[nodiscard]] const NoiseRun& parentNoiseRun() const;
         [[nodiscard]] const PerformanceRun& parentPerformanceRun() const;
@@ -34,15 +46,56 @@ namespace GRAPE {
 
         // Status Checks (Not thread Safe)
         [[nodiscard]] bool empty() const { return m_ReceptorOutput.empty(); }
+        [[nodiscard]] bool contains(const Operation& Op) const { return m_Contributions.contains(&Op); }
+
+        /**
+        * @return True if the linear sums and the single event output of every accumulated operation are kept, so that operations can be added to and removed from the cumulative outputs.
+        */
+        [[nodiscard]] bool updatable() const { return m_Updatable; }
 
         // Change Data (Thread Safe)
         void setReceptorOutput(ReceptorOutput&& ReceptOutput);
+
+        /**
+        * @brief Queues the single event output of Op. Queued outputs are saved in a single transaction once s_SingleEventBatchSize are queued, or by saveSingleEvents().
+        */
         void addSingleEvent(const Operation& Op, const NoiseSingleEventOutput& NsOut) const;
-        void startCumulative();
-        void accumulate(const Operation& Op, const NoiseSingleEventOutput& NsOut);
+
+        /**
+        * @brief Saves the single event outputs queued by addSingleEvent().
+        */
+        void saveSingleEvents() const;
+
+        /**
+        * @brief Prepares the accumulation of Ops into ShardCount partial cumulative outputs. The operation at position i of Ops is accumulated into shard i % ShardCount.
+        * Each shard sums its operations in the order of Ops, whatever the order in which accumulate() is called, and the shards are reduced in order. The cumulative outputs are therefore the same in every run with the same Ops.
+        */
+        void startCumulative(const std::vector<const Operation*>& Ops, std::size_t ShardCount = 1);
+        void accumulate(const Operation& Op, const std::shared_ptr<const NoiseSingleEventOutput>& NsOut);
+        void accumulate(const Operation& Op, const std::shared_ptr<const NoiseSingleEventOutput>& NsOut, const NoiseSingleEventEnergy& NsEnergy); // NsEnergy converted from NsOut, NsOut may be shared by operations with the same single event output
         void finishCumulative();
         void clear();
 
+        /**
+        * @brief Subtracts the contribution of Op from the linear sums in memory. The cumulative outputs are updated by the next finishCumulative().
+        * The single event output of Op and the saved cumulative outputs are deleted by the next saveOperationChanges().
+        * Not thread safe.
+        * @return False if not updatable(), the noise run has to be reset.
+        */
+        bool removeOperation(const Operation& Op);
+
+        /**
+        * @brief Marks the saved cumulative outputs, which no longer match the operations of the scenario, to be deleted by the next saveOperationChanges(). They are saved again by the next finishCumulative().
+        * A noise run loaded without its cumulative outputs is reset, as the linear sums needed to update it are not saved.
+        */
+        void invalidateCumulative();
+
+        /**
+        * @brief Deletes the single event outputs of the operations removed and the cumulative outputs invalidated since the last call, in a single transaction.
+        * Called once per change of the scenario operations, however many operations were added or removed.
+        */
+        void saveOperationChanges();
+
         friend class ScenariosManager;
     private:
         // NoiseRunOutput belongs to NoiseRun and can't be reassigned
@@ -52,16 +105,74 @@ namespace GRAPE {
         // Receptor Output
         ReceptorOutput m_ReceptorOutput;
 
+        // Id of the output in the database, referenced by the single event outputs. Set when the receptor output is saved or loaded.
+        mutable std::int64_t m_OutputId = 0;
+
+        // Single event blobs store the receptor values sorted by receptor ID, the same order in which receptors are loaded from the database
+        // Built whenever m_ReceptorOutput is set, read without locking
+        std::vector<std::size_t> m_StorageOrder;
+
         GrapeMap<const NoiseCumulativeMetric*, NoiseCumulativeOutput> m_CumulativeOutputs;
-        mutable std::mutex m_CumOutMutex;
 
+        // Linear sums from which m_CumulativeOutputs are finished, kept to add and remove operations
+        GrapeMap<const NoiseCumulativeMetric*, NoiseCumulativeOutput> m_CumulativeSums;
+        bool m_MaximumAbsoluteOutdated = false;
+        bool m_Updatable = false;
+
+        // Single event output of each accumulated operation, shared by operations with the same single event output
+        // Not kept once they exceed s_MemoryBudget
+        std::unordered_map<const Operation*, std::shared_ptr<const NoiseSingleEventOutput>> m_Contributions;
+        std::unordered_map<const NoiseSingleEventOutput*, std::size_t> m_ContributionUses;
+        std::size_t m_ContributionsSize = 0;
+        bool m_KeepContributions = true;
+        std::mutex m_ContributionsMutex;
+
+        // Partial cumulative outputs, each operation is accumulated into the shard selected by its position in the operations passed to startCumulative()
+        // Operations accumulated before the previous operation of their shard are held in Pending until they are next in order
+        // Reduced into m_CumulativeOutputs in shard order by finishCumulative()
+        struct CumulativeShard {
+            GrapeMap<const NoiseCumulativeMetric*, NoiseCumulativeOutput> Outputs;
+            std::size_t NextIndex = 0;
+            std::map<std::size_t, std::pair<const Operation*, std::shared_ptr<const NoiseSingleEventOutput>>> Pending;
+            std::mutex Mutex;
+        };
+        std::vector<std::unique_ptr<CumulativeShard>> m_CumulativeShards;
+        std::unordered_map<const Operation*, std::size_t> m_CumulativeIndexes; // Set by startCumulative(), read without locking
+
+        // Outputs are written with m_Db under m_DbMutex and loaded with the reader connections, without locking
         Database m_Db;
         mutable std::mutex m_DbMutex;
+
+        // Changes of the scenario operations, saved by saveOperationChanges()
+        std::vector<std::int64_t> m_RemovedOutputIds;
+        bool m_CumulativeInvalidated = false;
+
+        // False once the cumulative outputs are deleted, until they are saved again
+        mutable bool m_CumulativeSaved = true;
+
+        // Single event outputs queued under m_DbMutex, converted to blobs before locking
+        struct SingleEventRow {
+            std::int64_t PerfOutputId = 0;
+            Blob LamaxBlob;
+            Blob SelBlob;
+        };
+        static constexpr std::size_t s_SingleEventBatchSize = 64;
+        mutable std::vector<SingleEventRow> m_SingleEventQueue;
     private:
+        const std::vector<std::size_t>& storageOrder() const { return m_StorageOrder; }
+        void updateStorageOrder();
         NoiseSingleEventOutput load(const Operation& Op) const;
 
+        void keep(const Operation& Op, const std::shared_ptr<const NoiseSingleEventOutput>& NsOut);
+
+        // Must be called with the mutex of Shard held
+        void accumulateShard(CumulativeShard& Shard, const Operation& Op, const NoiseSingleEventOutput& NsOut, const NoiseSingleEventEnergy& NsEnergy) const;
+        void accumulatePending(CumulativeShard& Shard, bool Drain) const;
+        void releaseContributions();
+
         void saveReceptorOutput() const;
-        void saveSingleEvent(const Operation& Op, const NoiseSingleEventOutput& NsOutput) const;
+        void saveSingleEventQueue() const;
         void saveCumulative() const;
+        void deleteCumulative() const;
     };
 }
@@ -147,11 +147,10 @@ namespace GRAPE {
 
     Scenario& PerformanceRun::parentScenario() const { return m_ParentScenario; }
 
-    const std::shared_ptr<PerformanceRunJob>& PerformanceRun::createJob(const Database& Db, OperationsManager& Ops) {
+    const std::shared_ptr<PerformanceRunJob>& PerformanceRun::createJob(const Database& Db, OperationsManager& Ops, Doc29PerformanceManager& Doc29Acfts) {
         m_PerfRunOutput = std::make_unique<PerformanceRunOutput>(*this, Db);
 
-        std::size_t threadCount = static_cast<std::size_t>(std::thread::hardware_concurrency());
-        m_Job = std::make_shared<PerformanceRunJob>(Ops, *this, threadCount);
+        m_Job = std::make_shared<PerformanceRunJob>(Ops, Doc29Acfts, *this);
 
         return m_Job;
     }
@@ -9,6 +9,7 @@
 #include "Performance/PerformanceSpecification.h"
 
 namespace GRAPE {
+    class Doc29PerformanceManager;
     class PerformanceRunJob;
     class OperationsManager;
     class Scenario;
@@ -33,7 +34,7 @@ namespace GRAPE {
         // Job
         friend class PerformanceRunJob;
         [[nodiscard]] const auto& job() const { return m_Job; }
-        const std::shared_ptr<PerformanceRunJob>& createJob(const Database& Db, OperationsManager& Ops);
+        const std::shared_ptr<PerformanceRunJob>& createJob(const Database& Db, OperationsManager& Ops, Doc29PerformanceManager& Doc29Acfts);
 
         // Output
         [[nodiscard]] auto& output() const { return *m_PerfRunOutput; }
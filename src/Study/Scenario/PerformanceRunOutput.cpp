@@ -5,21 +5,37 @@
 #include "PerformanceRunOutput.h"
 
 #include "Schema/Schema.h"
+#include "Schema/SchemaOutput.h"
 #include "Scenario.h"
 
 namespace GRAPE {
+    namespace {
+        // Approximate memory footprint of a performance output, the points are stored contiguously as (cumulative ground distance, point) pairs
+        std::size_t memorySize(const PerformanceOutput& PerfOutput) {
+            return sizeof(PerformanceOutput) + PerfOutput.size() * sizeof(PerformanceOutput::Container::value_type);
+        }
+    }
+
     PerformanceRunOutput::PerformanceRunOutput(const PerformanceRun& PerfRun, const Database& Db) : m_PerfRun(PerfRun), m_Db(Db) {}
 
+    PerformanceRunOutput::~PerformanceRunOutput() { stopWriter(); }
+
     void PerformanceRunOutput::clear() {
-        std::scoped_lock lck(m_Mutex);
+        GRAPE_ASSERT(!m_Writer.joinable());
+        std::scoped_lock lck(m_Mutex, m_DbMutex);
         if (empty())
             return;
         m_ArrivalOutputs.clear();
         m_ArrivalOutputs.shrink_to_fit();
         m_DepartureOutputs.clear();
         m_DepartureOutputs.shrink_to_fit();
+        m_Memory.clear();
+        m_MemoryOrder.clear();
+        m_MemorySize = 0;
+        m_OutputIds.clear();
+        m_PointsSaved = true;
         m_Db.beginTransaction();
-        m_Db.deleteD(Schema::performance_run_output, { 0, 1 }, std::make_tuple(m_PerfRun.parentScenario().Name, m_PerfRun.Name));
+        m_Db.deleteD(Schema::performance_run_output, { 1, 2 }, std::make_tuple(m_PerfRun.parentScenario().Name, m_PerfRun.Name));
         m_Db.commitTransaction();
     }
 
@@ -31,46 +47,350 @@ namespace GRAPE {
         return std::ranges::find_if(m_DepartureOutputs, [&](const OperationDeparture& DepOp) { return &DepOp == &Op; }) != m_DepartureOutputs.end();
     }
 
-    PerformanceOutput PerformanceRunOutput::output(const Operation& Op) const {
+    std::shared_ptr<const PerformanceOutput> PerformanceRunOutput::output(const Operation& Op) const {
+        return get(Op);
+    }
+
+    std::shared_ptr<const PerformanceOutput> PerformanceRunOutput::arrivalOutput(const OperationArrival& Op) const {
+        GRAPE_ASSERT(containsArrival(Op));
+        return get(Op);
+    }
+
+    std::shared_ptr<const PerformanceOutput> PerformanceRunOutput::departureOutput(const OperationDeparture& Op) const {
+        GRAPE_ASSERT(containsDeparture(Op));
+        return get(Op);
+    }
+
+    std::int64_t PerformanceRunOutput::outputId(const Operation& Op) const {
         std::scoped_lock lck(m_Mutex);
-        return load(Op);
+        const auto it = m_OutputIds.find(&Op);
+        GRAPE_ASSERT(it != m_OutputIds.end(), "Output of operation '{2}' not saved.", Op.Name);
+        return it->second;
+    }
+
+    void PerformanceRunOutput::addArrivalOutput(const OperationArrival& Op, PerformanceOutput&& PerfOut) {
+        addArrivalOutput(Op, std::make_shared<const PerformanceOutput>(std::move(PerfOut)));
     }
 
-    PerformanceOutput PerformanceRunOutput::arrivalOutput(const OperationArrival& Op) const {
+    void PerformanceRunOutput::addDepartureOutput(const OperationDeparture& Op, PerformanceOutput&& PerfOut) {
+        addDepartureOutput(Op, std::make_shared<const PerformanceOutput>(std::move(PerfOut)));
+    }
+
+    void PerformanceRunOutput::addArrivalOutput(const OperationArrival& Op, std::shared_ptr<const PerformanceOutput> PerfOut) {
+        {
+            std::scoped_lock lck(m_Mutex);
+            m_ArrivalOutputs.emplace_back(Op);
+            keep(Op, PerfOut);
+        }
+        write(Op, std::move(PerfOut));
+    }
+
+    void PerformanceRunOutput::addDepartureOutput(const OperationDeparture& Op, std::shared_ptr<const PerformanceOutput> PerfOut) {
+        {
+            std::scoped_lock lck(m_Mutex);
+            m_DepartureOutputs.emplace_back(Op);
+            keep(Op, PerfOut);
+        }
+        write(Op, std::move(PerfOut));
+    }
+
+    void PerformanceRunOutput::eraseArrivalOutput(const OperationArrival& Op) {
+        GRAPE_ASSERT(!m_Writer.joinable());
         std::scoped_lock lck(m_Mutex);
-        GRAPE_ASSERT(containsArrival(Op));
-        return load(Op);
+        const auto it = std::ranges::find_if(m_ArrivalOutputs, [&](const OperationArrival& ArrOp) { return &ArrOp == &Op; });
+        if (it == m_ArrivalOutputs.end())
+            return;
+
+        m_ArrivalOutputs.erase(it);
+        erase(Op);
     }
 
-    PerformanceOutput PerformanceRunOutput::departureOutput(const OperationDeparture& Op) const {
+    void PerformanceRunOutput::eraseDepartureOutput(const OperationDeparture& Op) {
+        GRAPE_ASSERT(!m_Writer.joinable());
         std::scoped_lock lck(m_Mutex);
-        GRAPE_ASSERT(containsDeparture(Op));
-        return load(Op);
+        const auto it = std::ranges::find_if(m_DepartureOutputs, [&](const OperationDeparture& DepOp) { return &DepOp == &Op; });
+        if (it == m_DepartureOutputs.end())
+            return;
+
+        m_DepartureOutputs.erase(it);
+        erase(Op);
+    }
+
+    void PerformanceRunOutput::startWriter() {
+        GRAPE_ASSERT(!m_Writer.joinable());
+        m_WriterStop = false;
+
+        m_SavePoints = s_SavePoints;
+        if (!m_SavePoints)
+            m_PointsSaved = false;
+
+        {
+            // Outputs kept from a previous run are published first
+            std::scoped_lock lck(m_Mutex, m_StreamsMutex);
+            m_Streaming = true;
+            m_Published.clear();
+            for (const OperationArrival& op : m_ArrivalOutputs)
+                m_Published.emplace_back(&op);
+            for (const OperationDeparture& op : m_DepartureOutputs)
+                m_Published.emplace_back(&op);
+        }
+
+        m_Writer = std::thread(&PerformanceRunOutput::writerLoop, this);
+    }
+
+    void PerformanceRunOutput::stopWriter(bool Complete) {
+        if (!m_Writer.joinable())
+            return;
+
+        {
+            std::scoped_lock lck(m_WriteMutex);
+            m_WriterStop = true;
+        }
+        m_WriteQueueNotEmpty.notify_one();
+        m_Writer.join();
+
+        std::scoped_lock lck(m_StreamsMutex);
+        m_Streaming = false;
+        for (const auto& stream : m_Streams)
+            stream->close(Complete);
+        m_Streams.clear();
+        m_Published.clear();
+        m_Published.shrink_to_fit();
     }
 
-    void PerformanceRunOutput::addArrivalOutput(const OperationArrival& Op, const PerformanceOutput& PerfOut) {
+    std::shared_ptr<PerformanceRunOutput::Stream> PerformanceRunOutput::subscribe() {
+        std::scoped_lock lck(m_Mutex, m_StreamsMutex);
+        if (!m_Streaming)
+            return nullptr;
+
+        std::vector<Stream::Item> published;
+        published.reserve(m_Published.size());
+        for (const auto op : m_Published)
+        {
+            if (m_SavePoints)
+            {
+                published.emplace_back(op, nullptr);
+                continue;
+            }
+
+            // Points not saved, the stream keeps the outputs alive until consumed
+            const auto it = m_Memory.find(op);
+            if (it == m_Memory.end())
+                return nullptr;
+            published.emplace_back(op, it->second);
+        }
+
+        auto stream = std::make_shared<Stream>();
+        stream->push(published);
+
+        m_Streams.emplace_back(stream);
+        return stream;
+    }
+
+    std::vector<PerformanceRunOutput::Stream::Item> PerformanceRunOutput::Stream::pop() {
+        std::unique_lock lck(m_Mutex);
+        m_ItemsAvailable.wait(lck, [&] { return !m_Items.empty() || m_Closed; });
+        auto items = std::exchange(m_Items, {});
+        lck.unlock();
+        m_ItemsPopped.notify_all();
+        return items;
+    }
+
+    bool PerformanceRunOutput::Stream::complete() const {
         std::scoped_lock lck(m_Mutex);
-        m_ArrivalOutputs.emplace_back(Op);
-        save(Op, PerfOut);
+        return m_Complete;
+    }
+
+    void PerformanceRunOutput::Stream::push(const std::vector<Item>& Items) {
+        if (Items.empty())
+            return;
+
+        {
+            std::scoped_lock lck(m_Mutex);
+            if (m_Closed)
+                return;
+            m_Items.insert(m_Items.end(), Items.begin(), Items.end());
+        }
+        m_ItemsAvailable.notify_all();
+    }
+
+    void PerformanceRunOutput::Stream::throttle() {
+        std::unique_lock lck(m_Mutex);
+        m_ItemsPopped.wait(lck, [&] { return m_Items.size() < s_StreamCapacity || m_Closed; });
+    }
+
+    void PerformanceRunOutput::Stream::close(bool Complete) {
+        {
+            std::scoped_lock lck(m_Mutex);
+            if (m_Closed)
+                return;
+            m_Closed = true;
+            m_Complete = Complete;
+        }
+        m_ItemsAvailable.notify_all();
+        m_ItemsPopped.notify_all();
+    }
+
+    /**
+    * The memory table is read under the lock, outputs can be accessed while a performance run adds outputs, e.g. by a streaming noise run.
+    */
+    std::shared_ptr<const PerformanceOutput> PerformanceRunOutput::get(const Operation& Op) const {
+        {
+            std::scoped_lock lck(m_Mutex);
+            if (const auto it = m_Memory.find(&Op); it != m_Memory.end())
+                return it->second;
+        }
+
+        // Evicted or never kept (e.g. outputs of a study loaded from file)
+        return std::make_shared<const PerformanceOutput>(load(Op));
+    }
+
+    void PerformanceRunOutput::keep(const Operation& Op, const std::shared_ptr<const PerformanceOutput>& PerfOutput) {
+        const std::size_t budget = static_cast<std::size_t>(std::max(s_MemoryBudget, 0)) * 1024 * 1024;
+        const std::size_t size = memorySize(*PerfOutput);
+        if (size > budget)
+            return;
+
+        while (m_MemorySize + size > budget)
+        {
+            const auto evictedIt = m_Memory.find(m_MemoryOrder.front());
+            m_MemorySize -= memorySize(*evictedIt->second);
+            m_Memory.erase(evictedIt);
+            m_MemoryOrder.pop_front();
+        }
+
+        m_Memory.emplace(&Op, PerfOutput);
+        m_MemoryOrder.emplace_back(&Op);
+        m_MemorySize += size;
+    }
+
+    void PerformanceRunOutput::forget(const Operation& Op) {
+        const auto it = m_Memory.find(&Op);
+        if (it == m_Memory.end())
+            return;
+
+        m_MemorySize -= memorySize(*it->second);
+        m_Memory.erase(it);
+        m_MemoryOrder.erase(std::ranges::find(m_MemoryOrder, &Op));
+    }
+
+    /**
+    * Must be called with m_Mutex held, as forget().
+    * Deleting the output row cascades to the points and to the single event outputs of the noise runs. Emissions run outputs must be erased before.
+    */
+    void PerformanceRunOutput::erase(const Operation& Op) {
+        forget(Op);
+
+        const auto it = m_OutputIds.find(&Op);
+        if (it == m_OutputIds.end())
+            return;
+        const std::int64_t id = it->second;
+        m_OutputIds.erase(it);
+
+        std::scoped_lock lck(m_DbMutex);
+        m_Db.deleteD(Schema::performance_run_output, { 0 }, std::make_tuple(id));
+    }
+
+    void PerformanceRunOutput::write(const Operation& Op, std::shared_ptr<const PerformanceOutput> PerfOutput) {
+        // No writer thread, save directly
+        if (!m_Writer.joinable())
+        {
+            const std::vector<WriteItem> outputs{ { &Op, std::move(PerfOutput) } };
+            std::vector<std::int64_t> ids;
+            {
+                std::scoped_lock lck(m_DbMutex);
+                ids = save(outputs);
+            }
+            setOutputIds(outputs, ids);
+            return;
+        }
+
+        {
+            std::unique_lock lck(m_WriteMutex);
+            m_WriteQueueNotFull.wait(lck, [&] { return m_WriteQueue.size() < s_WriteQueueCapacity; });
+            m_WriteQueue.emplace_back(&Op, std::move(PerfOutput));
+        }
+        m_WriteQueueNotEmpty.notify_one();
     }
 
-    void PerformanceRunOutput::addDepartureOutput(const OperationDeparture& Op, const PerformanceOutput& PerfOut) {
+    void PerformanceRunOutput::writerLoop() {
+        std::vector<WriteItem> batch;
+        batch.reserve(s_WriteBatchSize);
+
+        while (true)
+        {
+            {
+                std::unique_lock lck(m_WriteMutex);
+                m_WriteQueueNotEmpty.wait(lck, [&] { return !m_WriteQueue.empty() || m_WriterStop; });
+
+                // Stop requested and all outputs saved
+                if (m_WriteQueue.empty())
+                    return;
+
+                while (!m_WriteQueue.empty() && batch.size() < s_WriteBatchSize)
+                {
+                    batch.emplace_back(std::move(m_WriteQueue.front()));
+                    m_WriteQueue.pop_front();
+                }
+            }
+            m_WriteQueueNotFull.notify_all();
+
+            std::vector<std::int64_t> ids;
+            {
+                std::scoped_lock lck(m_DbMutex);
+                ids = save(batch);
+            }
+            setOutputIds(batch, ids);
+            publish(batch);
+            batch.clear();
+        }
+    }
+
+    void PerformanceRunOutput::setOutputIds(const std::vector<WriteItem>& Outputs, const std::vector<std::int64_t>& Ids) {
+        GRAPE_ASSERT(Outputs.size() == Ids.size());
         std::scoped_lock lck(m_Mutex);
-        m_DepartureOutputs.emplace_back(Op);
-        save(Op, PerfOut);
+        for (std::size_t i = 0; i < Outputs.size(); ++i)
+            m_OutputIds.insert_or_assign(Outputs.at(i).first, Ids.at(i));
+    }
+
+    /**
+    * The streams are throttled after releasing m_StreamsMutex, subscribe() never waits for a slow consumer.
+    */
+    void PerformanceRunOutput::publish(const std::vector<WriteItem>& Outputs) {
+        std::vector<std::shared_ptr<Stream>> streams;
+        {
+            std::scoped_lock lck(m_StreamsMutex);
+            for (const auto& op : Outputs | std::views::keys)
+                m_Published.emplace_back(op);
+            for (const auto& stream : m_Streams)
+                stream->push(Outputs);
+            streams = m_Streams;
+        }
+
+        for (const auto& stream : streams)
+            stream->throttle();
     }
 
     PerformanceOutput PerformanceRunOutput::load(const Operation& Op) const {
         PerformanceOutput perfOutput;
-        m_Db.beginTransaction();
 
-        Statement stmt(m_Db, Schema::performance_run_output_points.querySelect({ 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 }, { 0, 1, 2, 3, 4 }, { 5 }));
-        stmt.bindValues(m_PerfRun.parentScenario().Name, m_PerfRun.Name, Op.Name, OperationTypes.toString(Op.operationType()), Operation::Types.toString(Op.type()));
+        std::int64_t id;
+        {
+            std::scoped_lock lck(m_Mutex);
+            const auto it = m_OutputIds.find(&Op);
+            if (it == m_OutputIds.end())
+                return perfOutput; // Not yet saved by the writer thread
+            id = it->second;
+        }
+
+        const auto rd = m_Db.reader();
+        Statement stmt(*rd, Schema::performance_run_output_points.querySelect({ 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }, { 0 }, { 1 }));
+        stmt.bindValues(id);
         stmt.step();
         while (stmt.hasRow())
         {
-            const PerformanceOutput::PointOrigin origin = PerformanceOutput::Origins.fromString(stmt.getColumn(0));
-            const FlightPhase flPhase = FlightPhases.fromString(stmt.getColumn(1));
+            const auto origin = stmt.getColumn(0).getEnum<PerformanceOutput::PointOrigin>();
+            const auto flPhase = stmt.getColumn(1).getEnum<FlightPhase>();
             const double cumGroundDist = stmt.getColumn(2);
             const double lon = stmt.getColumn(3);
             const double lat = stmt.getColumn(4);
@@ -83,48 +403,55 @@ namespace GRAPE {
             perfOutput.addPoint(origin, flPhase, cumGroundDist, lon, lat, altMsl, trueAirspeed, groundSpeed, corrNetThrustPerEng, bankAngle, fuelFlowPerEng);
             stmt.step();
         }
-        m_Db.commitTransaction();
         return perfOutput;
     }
 
-    void PerformanceRunOutput::save(const Operation& Op, const PerformanceOutput& PerfOutput) const {
+    std::vector<std::int64_t> PerformanceRunOutput::save(const std::vector<WriteItem>& Outputs) const {
+        const std::string& scenName = m_PerfRun.parentScenario().Name;
+        const std::string& perfRunName = m_PerfRun.Name;
+
         m_Db.beginTransaction();
 
-        m_Db.insert(Schema::performance_run_output, {}, std::make_tuple(
-            m_PerfRun.parentScenario().Name,
-            m_PerfRun.Name,
-            Op.Name,
-            OperationTypes.toString(Op.operationType()),
-            Operation::Types.toString(Op.type())
-        ));
+        // Single statement for all operation rows, the id of each output is the rowid returned on insertion
+        std::vector<std::tuple<const std::string&, const std::string&, const std::string&, OperationType, Operation::Type>> opRows;
+        opRows.reserve(Outputs.size());
+        for (const auto& op : Outputs | std::views::keys)
+            opRows.emplace_back(scenName, perfRunName, op->Name, op->operationType(), op->type());
+        const auto outIds = m_Db.insertBulkReturningIds(Schema::performance_run_output, { 1, 2, 3, 4, 5 }, opRows);
 
+        if (!m_SavePoints)
+        {
+            m_Db.commitTransaction();
+            return outIds;
+        }
+
+        // Single statement for all points, the output id is bound once per operation
         Statement stmt(m_Db, Schema::performance_run_output_points.queryInsert());
-        stmt.bindValues(m_PerfRun.parentScenario().Name, m_PerfRun.Name, Op.Name, OperationTypes.toString(Op.operationType()), Operation::Types.toString(Op.type()));
-
-        for (auto it = PerfOutput.begin(); it != PerfOutput.end(); ++it)
-        {
-            auto& [cumGroundDist, pt] = *it;
-            m_Db.insert(Schema::performance_run_output_points, {}, std::make_tuple(
-                m_PerfRun.parentScenario().Name,
-                m_PerfRun.Name,
-                Op.Name,
-                OperationTypes.toString(Op.operationType()),
-                Operation::Types.toString(Op.type()),
-                static_cast<int>(std::distance(PerfOutput.begin(), it)) + 1,
-                PerformanceOutput::Origins.toString(pt.PtOrigin),
-                FlightPhases.toString(pt.FlPhase),
-                cumGroundDist,
-                pt.Longitude,
-                pt.Latitude,
-                pt.AltitudeMsl,
-                pt.TrueAirspeed,
-                pt.Groundspeed,
-                pt.CorrNetThrustPerEng,
-                pt.BankAngle,
-                pt.FuelFlowPerEng
-            ));
+        for (std::size_t i = 0; i < Outputs.size(); ++i)
+        {
+            stmt.bind(0, outIds.at(i));
+
+            int pointNumber = 1;
+            for (const auto& [cumGroundDist, pt] : *Outputs.at(i).second)
+            {
+                stmt.stepValues<1>(std::make_tuple(
+                    pointNumber++,
+                    pt.PtOrigin,
+                    pt.FlPhase,
+                    cumGroundDist,
+                    pt.Longitude,
+                    pt.Latitude,
+                    pt.AltitudeMsl,
+                    pt.TrueAirspeed,
+                    pt.Groundspeed,
+                    pt.CorrNetThrustPerEng,
+                    pt.BankAngle,
+                    pt.FuelFlowPerEng
+                ));
+            }
         }
 
         m_Db.commitTransaction();
+        return outIds;
     }
 }
@@ -2,6 +2,13 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #include "Database/Database.h"
 #include "Operation/Operations.h"
 #include "Performance/PerformanceOutput.h"
@@ -17,7 +24,57 @@ namespace GRAPE {
         PerformanceRunOutput(PerformanceRunOutput&&) = delete;
         PerformanceRunOutput& operator=(const PerformanceRunOutput&) = delete;
         PerformanceRunOutput& operator=(PerformanceRunOutput&&) = delete;
-        ~PerformanceRunOutput() = default;
+        ~PerformanceRunOutput();
+
+        /**
+        * @brief Maximum memory in MiB used by each performance run to keep outputs in memory. Outputs which do not fit are loaded from the database when accessed.
+        */
+        inline static int s_MemoryBudget = 1024;
+
+        /**
+        * @brief If false, only the operations of the outputs are saved to the database and not their points.
+        * The outputs are then only available while kept in memory, noise and emissions runs must consume them through subscribe() while the performance run is running.
+        */
+        inline static bool s_SavePoints = true;
+
+        /**
+        * @brief Outputs published by the writer thread once saved to the database, in the order they were saved.
+        * Publishing never blocks. After publishing, the writer thread waits while a stream holds s_StreamCapacity items or more, the performance run is throttled to its slowest consumer.
+        */
+        class Stream {
+        public:
+            typedef std::pair<const Operation*, std::shared_ptr<const PerformanceOutput>> Item;
+            static constexpr std::size_t s_StreamCapacity = 1024;
+
+            /**
+            * @brief Blocks until items are published or the stream is closed.
+            * @return All items published since the last call, empty once the stream is closed and all items were returned.
+            */
+            [[nodiscard]] std::vector<Item> pop();
+
+            /**
+            * @return True if the stream was closed after the performance run finished, false if it was stopped. Meaningful only once pop() returned empty.
+            */
+            [[nodiscard]] bool complete() const;
+
+            /**
+            * @brief Closes the stream from the consumer side, items are no longer published to it. Must be called by consumers which stop before pop() returned empty.
+            */
+            void cancel() { close(false); }
+        private:
+            friend class PerformanceRunOutput;
+
+            std::vector<Item> m_Items;
+            bool m_Closed = false;
+            bool m_Complete = false;
+            mutable std::mutex m_Mutex;
+            std::condition_variable m_ItemsAvailable;
+            std::condition_variable m_ItemsPopped;
+        private:
+            void push(const std::vector<Item>& Items);
+            void throttle();
+            void close(bool Complete);
+        };
 
         // Access Data (Not Thread Safe)
         [[nodiscard]] auto arrivalOutputs() const { return m_ArrivalOutputs; }
@@ -29,16 +86,61 @@ namespace GRAPE {
         [[nodiscard]] bool containsArrival(const OperationArrival& Op) const;
         [[nodiscard]] bool containsDeparture(const OperationDeparture& Op) const;
 
+        /**
+        * @return False if any output was added while s_SavePoints was false, outputs evicted from memory then have no points.
+        */
+        [[nodiscard]] bool pointsSaved() const { return m_PointsSaved; }
+
         // Access Data (Thread Safe)
-        [[nodiscard]] PerformanceOutput output(const Operation& Op) const;
-        [[nodiscard]] PerformanceOutput arrivalOutput(const OperationArrival& Op) const;
-        [[nodiscard]] PerformanceOutput departureOutput(const OperationDeparture& Op) const;
+        [[nodiscard]] std::shared_ptr<const PerformanceOutput> output(const Operation& Op) const;
+        [[nodiscard]] std::shared_ptr<const PerformanceOutput> arrivalOutput(const OperationArrival& Op) const;
+        [[nodiscard]] std::shared_ptr<const PerformanceOutput> departureOutput(const OperationDeparture& Op) const;
+
+        /**
+        * @return The id of the output of Op in the database, referenced by the noise and emissions run outputs. Available once the output is saved, i.e. for all outputs published to streams.
+        */
+        [[nodiscard]] std::int64_t outputId(const Operation& Op) const;
 
         // Change Data (Thread Safe)
-        void addArrivalOutput(const OperationArrival& Op, const PerformanceOutput& PerfOut);
-        void addDepartureOutput(const OperationDeparture& Op, const PerformanceOutput& PerfOut);
+        // The add functions lock m_Mutex and may run concurrently with the thread safe access functions, e.g. a streaming noise run reading outputs while the performance run adds them
+        // They must not run concurrently with the not thread safe access functions and status checks, which read the output lists without locking
+        void addArrivalOutput(const OperationArrival& Op, PerformanceOutput&& PerfOut);
+        void addDepartureOutput(const OperationDeparture& Op, PerformanceOutput&& PerfOut);
+
+        /**
+        * @brief Adds an output which may be shared by several operations, e.g. flights with the same FlightTemplate.
+        * It is saved to the database for each operation and counts towards the memory budget once per operation.
+        */
+        void addArrivalOutput(const OperationArrival& Op, std::shared_ptr<const PerformanceOutput> PerfOut);
+        void addDepartureOutput(const OperationDeparture& Op, std::shared_ptr<const PerformanceOutput> PerfOut);
+
+        /**
+        * @brief Erases the output of Op, if any, from memory and from the database. Must not be called while the writer thread is running.
+        */
+        void eraseArrivalOutput(const OperationArrival& Op);
+        void eraseDepartureOutput(const OperationDeparture& Op);
         void clear();
 
+        /**
+        * @brief Starts the writer thread. Outputs added until stopWriter() is called are queued and saved to the database in batches by the writer thread.
+        * The queue is bounded, adding outputs blocks only while the queue is full.
+        */
+        void startWriter();
+
+        /**
+        * @brief Blocks until all queued outputs are saved to the database, joins the writer thread and closes the streams.
+        * @param Complete True if all outputs of the performance run were added, passed on to Stream::complete().
+        */
+        void stopWriter(bool Complete = false);
+
+        /**
+        * @brief Thread safe. Lets noise and emissions runs consume the outputs while the performance run is running, without loading them back from the database.
+        * @return Stream of the outputs saved by the writer thread, starting with all outputs already saved. Nullptr if the writer thread is not running.
+        * Outputs saved before the subscription are published with a nullptr output, to be accessed with output().
+        * If s_SavePoints was false when the writer started, they are published with the output kept in memory instead, and the subscription is refused (nullptr) if any of them was already evicted.
+        */
+        [[nodiscard]] std::shared_ptr<Stream> subscribe();
+
         friend class ScenariosManager;
     private:
         // PerformanceRunOutput belongs to PerformanceRun and can't be reassigned
@@ -49,10 +151,54 @@ namespace GRAPE {
         std::vector<std::reference_wrapper<const OperationArrival>> m_ArrivalOutputs;
         std::vector<std::reference_wrapper<const OperationDeparture>> m_DepartureOutputs;
 
+        // Outputs are kept in memory while they fit in s_MemoryBudget, oldest outputs are evicted first
+        // Guarded by m_Mutex, changed by the add, erase and clear functions and read by the access functions through get()
+        std::unordered_map<const Operation*, std::shared_ptr<const PerformanceOutput>> m_Memory;
+        std::deque<const Operation*> m_MemoryOrder;
+        std::size_t m_MemorySize = 0;
+
+        // Row id of each saved output, set after saving under m_Mutex
+        std::unordered_map<const Operation*, std::int64_t> m_OutputIds;
+
+        // Outputs are written with m_Db under m_DbMutex and loaded with the reader connections, without locking
         Database m_Db;
         mutable std::mutex m_Mutex;
+        mutable std::mutex m_DbMutex;
+
+        // Writer thread
+        typedef std::pair<const Operation*, std::shared_ptr<const PerformanceOutput>> WriteItem;
+        static constexpr std::size_t s_WriteQueueCapacity = 512;
+        static constexpr std::size_t s_WriteBatchSize = 128;
+        std::thread m_Writer;
+        std::deque<WriteItem> m_WriteQueue;
+        bool m_WriterStop = false;
+        std::mutex m_WriteMutex;
+        std::condition_variable m_WriteQueueNotEmpty;
+        std::condition_variable m_WriteQueueNotFull;
+
+        // Streams, outputs are published after being saved
+        bool m_SavePoints = true;
+        bool m_PointsSaved = true;
+        bool m_Streaming = false;
+        std::vector<const Operation*> m_Published;
+        std::vector<std::shared_ptr<Stream>> m_Streams;
+        std::mutex m_StreamsMutex;
     private:
+        std::shared_ptr<const PerformanceOutput> get(const Operation& Op) const;
+
+        // Must be called with m_Mutex held
+        void keep(const Operation& Op, const std::shared_ptr<const PerformanceOutput>& PerfOutput);
+        void forget(const Operation& Op);
+        void erase(const Operation& Op);
+        void write(const Operation& Op, std::shared_ptr<const PerformanceOutput> PerfOutput);
+        void writerLoop();
+        void publish(const std::vector<WriteItem>& Outputs);
         PerformanceOutput load(const Operation& Op) const;
-        void save(const Operation& Op, const PerformanceOutput& PerfOutput) const;
+        void setOutputIds(const std::vector<WriteItem>& Outputs, const std::vector<std::int64_t>& Ids);
+
+        /**
+        * @return The ids of the saved outputs, in the same order as Outputs.
+        */
+        std::vector<std::int64_t> save(const std::vector<WriteItem>& Outputs) const;
     };
 }
@@ -5,10 +5,12 @@
 #include "Study.h"
 
 #include "Embed/GrapeSchema.embed"
+#include "Embed/GrapeOutputSchema.embed"
 #include "Elevator/Elevator.h"
+#include "OutputDatabase.h"
 
 namespace GRAPE {
-    Study::Study() : Airports(m_Database, Blocks), Doc29Aircrafts(m_Database, Blocks), Doc29Noises(m_Database, Blocks), SFIs(m_Database, Blocks), LTOEngines(m_Database, Blocks), Aircrafts(m_Database, Blocks, Doc29Aircrafts, Doc29Noises, SFIs, LTOEngines, Operations), Operations(m_Database, Blocks, Aircrafts, Airports), Scenarios(m_Database, Blocks, Operations, Jobs) {}
+    Study::Study() : Airports(m_Database, Blocks), Doc29Aircrafts(m_Database, Blocks), Doc29Noises(m_Database, Blocks), SFIs(m_Database, Blocks), LTOEngines(m_Database, Blocks), Aircrafts(m_Database, Blocks, Doc29Aircrafts, Doc29Noises, SFIs, LTOEngines, Operations), Operations(m_Database, Blocks, Aircrafts, Airports), Scenarios(m_Database, Blocks, Doc29Aircrafts, Doc29Noises, Operations, Jobs) {}
 
     Study::~Study() {
         Jobs.shutdown();
@@ -43,10 +45,16 @@ namespace GRAPE {
             return false;
         }
 
+        if (!attachOutput(version))
+        {
+            m_Database.close();
+            return false;
+        }
+
         elevate(version);
+        m_Database.execute(std::string(Schema::Output::g_triggers));
         loadFile();
         Log::study()->info("Opened study '{}' in '{}'.", name(), m_Database.path().parent_path().string());
-        Operations.Tracks4dLoader.Db = m_Database;
         return true;
     }
 
@@ -58,19 +66,66 @@ namespace GRAPE {
         if (!m_Database.create(Path, g_GrapeSchema, sizeof g_GrapeSchema))
             return false;
 
+        if (!createOutput() || !m_Database.attach(outputPath(), std::string(Schema::Output::g_name)))
+        {
+            m_Database.close();
+            return false;
+        }
+        m_Database.execute(std::string(Schema::Output::g_triggers));
+
         Log::study()->info("Created study '{}' in '{}'.", name(), m_Database.path().parent_path().string());
-        Operations.Tracks4dLoader.Db = m_Database;
         return true;
     }
 
     void Study::close() { m_Database.close(); }
 
+    std::filesystem::path Study::outputPath() const { return m_Database.path().replace_extension(".grpout"); }
+
+    bool Study::createOutput() const {
+        const auto outPath = outputPath();
+        for (const auto& suffix : { "", "-wal", "-shm" })
+        {
+            std::error_code sysErr;
+            std::filesystem::remove(std::filesystem::path(outPath).concat(suffix), sysErr);
+            if (sysErr)
+            {
+                Log::study()->error("Creating output file '{}'. {}", outPath.string(), sysErr.message());
+                return false;
+            }
+        }
+
+        Database outDb;
+        return outDb.create(outPath, g_GrapeOutputSchema, sizeof g_GrapeOutputSchema);
+    }
+
+    /**
+    * The output file must have the version of the study file, otherwise it is replaced by an empty one.
+    * Studies older than version 1.5 have their outputs in the study file, they are moved to the new output file when elevating.
+    */
+    bool Study::attachOutput(int CurrentVersion) {
+        const auto outPath = outputPath();
+        bool create = true;
+        if (CurrentVersion >= 15 && std::filesystem::exists(outPath))
+        {
+            const Database outDb(outPath);
+            create = !outDb.valid() || outDb.applicationId() != GRAPE_ID || outDb.userVersion() != CurrentVersion;
+            if (create)
+                Log::study()->warn("Opening output file '{}'. The file does not match the study and will be replaced, all outputs are lost.", outPath.string());
+        }
+
+        if (create && !createOutput())
+            return false;
+
+        return m_Database.attach(outPath, std::string(Schema::Output::g_name));
+    }
+
     void Study::elevate(int CurrentVersion) {
         if (CurrentVersion == GRAPE_VERSION_NUMBER)
             return;
 
         Schema::Elevator elevator;
         elevator.elevate(m_Database, CurrentVersion);
+        m_Database.execute(std::format("PRAGMA {}.user_version = {}", Schema::Output::g_name, GRAPE_VERSION_NUMBER));
         GRAPE_ASSERT(m_Database.userVersion() == GRAPE_VERSION_NUMBER);
     }
 
@@ -29,6 +29,7 @@ namespace GRAPE {
         // Access Data
         [[nodiscard]] std::string name() const { return m_Database.name(); } // stem from path
         [[nodiscard]] Database& db() { return m_Database; }
+        [[nodiscard]] std::filesystem::path outputPath() const; // path of the study with the extension .grpout
 
         // Change Data
         bool open(const std::filesystem::path& Path);
@@ -57,6 +58,8 @@ namespace GRAPE {
         // Constraints
         Constraints Blocks;
     private:
+        bool createOutput() const;
+        bool attachOutput(int CurrentVersion);
         void elevate(int CurrentVersion);
         void loadFile();
     };